@@ -17,6 +17,16 @@ function run {
     $BUILD_DIR/fixed-point-cpp
 }
 
+function bench {
+    echo "Benchmarking..."
+    $BUILD_DIR/fixed-point-bench
+}
+
+function fuzz {
+    echo "Fuzzing..."
+    $BUILD_DIR/fixed-point-fuzz $1
+}
+
 function clean {
     echo "Cleaning..."
     rm -rf $BUILD_DIR
@@ -30,6 +40,10 @@ function rebuild {
 
 if [ "$1" == "run" ]; then
     configure && build && run
+elif [ "$1" == "bench" ]; then
+    configure && build && bench
+elif [ "$1" == "fuzz" ]; then
+    configure && build && fuzz $2
 elif [ "$1" == "clean" ]; then
     clean
 elif [ "$1" == "rebuild" ]; then
@@ -0,0 +1,1059 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "algorithm.hpp"
+#include "channels.hpp"
+#include "charconv.hpp"
+#include "complex.hpp"
+#include "fast_div.hpp"
+#include "fft.hpp"
+#include "filter.hpp"
+#include "floats.hpp"
+#include "instrument.hpp"
+#include "math.hpp"
+#include "matrix.hpp"
+#include "profile.hpp"
+#include "simd.hpp"
+#include "table.hpp"
+#include "wide_number.hpp"
+
+using FP_S32_16 = fp::Number<std::int32_t, std::int64_t, 16>;
+using FP_U32_16 = fp::Number<std::uint32_t, std::uint64_t, 16>;
+using FP_S16_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+using FP_S64_32 = fp::Number<std::int64_t, fp::int128, 32>;
+using FP_S32_16_Sat = fp::Number<std::int32_t, std::int64_t, 16, fp::Saturate>;
+using FP_S16_8_Sat = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+using FP_S16_8_HalfEven = fp::Number<std::int16_t, std::int32_t, 8, fp::Wrap, fp::RoundHalfEven>;
+using FP_S16_8_Stochastic = fp::Number<std::int16_t, std::int32_t, 8, fp::Wrap, fp::RoundStochastic>;
+using FP_Q15 = fp::Number<std::int16_t, std::int32_t, 1>;
+using FP_Q30 = fp::Number<std::int32_t, std::int64_t, 2>;
+using FP_Q2_14 = fp::Number<std::int16_t, std::int32_t, 2>;
+using FP_Q64_64 = fp::WideNumber<2, 64>;
+using FP_Q128_128 = fp::WideNumber<4, 128>;
+using FP_S32_16_Instrumented = fp::Number<std::int32_t, std::int64_t, 16, fp::Instrumented<>, fp::InstrumentedRounding<>>;
+
+namespace
+{
+
+// number of elements per benchmark iteration
+constexpr std::size_t kBatchSize {1024};
+
+// adapter giving every benchmarked representation the same interface
+template<typename T>
+struct Traits
+{
+    using Value = T;
+
+    static Value Make(double d) { return Value(d); }
+    static Value FromFloat(float f) { return Value(f); }
+    static float ToFloat(Value a) { return static_cast<float>(a); }
+    static Value Add(Value a, Value b) { return a + b; }
+    static Value Sub(Value a, Value b) { return a - b; }
+    static Value Mul(Value a, Value b) { return a * b; }
+    static Value Div(Value a, Value b) { return a / b; }
+};
+
+// hand-written Q15.16 integer code, what fp::Number replaces
+struct RawQ16
+{
+    std::int32_t bits;
+};
+
+template<>
+struct Traits<RawQ16>
+{
+    using Value = RawQ16;
+
+    static Value Make(double d) { return {static_cast<std::int32_t>(d * 65536.0)}; }
+    static Value FromFloat(float f) { return {static_cast<std::int32_t>(f * 65536.0f)}; }
+    static float ToFloat(Value a) { return static_cast<float>(a.bits) / 65536.0f; }
+    static Value Add(Value a, Value b) { return {static_cast<std::int32_t>(a.bits + b.bits)}; }
+    static Value Sub(Value a, Value b) { return {static_cast<std::int32_t>(a.bits - b.bits)}; }
+    static Value Mul(Value a, Value b) { return {static_cast<std::int32_t>((std::int64_t{a.bits} * b.bits) >> 16)}; }
+    static Value Div(Value a, Value b) { return {static_cast<std::int32_t>((std::int64_t{a.bits} << 16) / b.bits)}; }
+};
+
+// operations under test
+struct AddOp
+{
+    template<typename T>
+    static auto Apply(const T& a, const T& b) { return Traits<T>::Add(a, b); }
+};
+
+struct SubOp
+{
+    template<typename T>
+    static auto Apply(const T& a, const T& b) { return Traits<T>::Sub(a, b); }
+};
+
+struct MulOp
+{
+    template<typename T>
+    static auto Apply(const T& a, const T& b) { return Traits<T>::Mul(a, b); }
+};
+
+struct DivOp
+{
+    template<typename T>
+    static auto Apply(const T& a, const T& b) { return Traits<T>::Div(a, b); }
+};
+
+// random values in [lo, hi], never zero so they can be used as divisors
+template<typename T>
+std::vector<T> RandomValues(double lo, double hi, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<T> values;
+    values.reserve(kBatchSize);
+    for (std::size_t i = 0; i < kBatchSize; ++i)
+    {
+        const double d = dist(rng);
+        values.push_back(Traits<T>::Make(d == 0.0 ? 1.0 : d));
+    }
+    return values;
+}
+
+// lower bound of the inputs, the upper one is 7 so products stay representable for every type
+template<typename T>
+constexpr double kRangeOf() noexcept
+{
+    if constexpr (fp::FixedPoint<T>)
+    {
+        return T::kIsSigned ? -7.0 : 0.5;
+    }
+    else
+    {
+        return -7.0;
+    }
+}
+
+// independent operations over arrays, measures throughput
+template<typename T, typename Op>
+void BM_Throughput(benchmark::State& state)
+{
+    const auto a = RandomValues<T>(kRangeOf<T>(), 7.0, 1);
+    const auto b = RandomValues<T>(0.5, 3.0, 2);
+    std::vector<T> out(a);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            out[i] = Op::Apply(a[i], b[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// chain of dependent operations, measures latency
+template<typename T, typename Op>
+void BM_Latency(benchmark::State& state)
+{
+    // x op 1 keeps the value stable, DoNotOptimize() stops the chain from being folded
+    T one = Traits<T>::Make(1.0);
+    T x = Traits<T>::Make(1.5);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            benchmark::DoNotOptimize(one);
+            x = Op::Apply(x, one);
+            benchmark::DoNotOptimize(x);
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_FromFloat(benchmark::State& state)
+{
+    std::vector<float> in(kBatchSize);
+    for (std::size_t i = 0; i < kBatchSize; ++i)
+    {
+        in[i] = static_cast<float>(i % 100) * 0.0625f;
+    }
+    std::vector<T> out(kBatchSize, Traits<T>::Make(0.0));
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            out[i] = Traits<T>::FromFloat(in[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_ToFloat(benchmark::State& state)
+{
+    const auto in = RandomValues<T>(kRangeOf<T>(), 7.0, 3);
+    std::vector<float> out(kBatchSize);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            out[i] = Traits<T>::ToFloat(in[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// batch kernels against the scalar operator loop above
+template<typename T>
+void BM_SimdAdd(benchmark::State& state)
+{
+    const auto a = RandomValues<T>(kRangeOf<T>(), 7.0, 1);
+    const auto b = RandomValues<T>(0.5, 3.0, 2);
+    std::vector<T> out(a);
+    for (auto _ : state)
+    {
+        fp::simd::Add<T>(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_SimdMul(benchmark::State& state)
+{
+    const auto a = RandomValues<T>(kRangeOf<T>(), 7.0, 1);
+    const auto b = RandomValues<T>(0.5, 3.0, 2);
+    std::vector<T> out(a);
+    for (auto _ : state)
+    {
+        fp::simd::Mul<T>(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// limiter stage: Clamp() in a loop against the batch version
+template<typename T>
+void BM_Clamp(benchmark::State& state)
+{
+    const auto in = RandomValues<T>(kRangeOf<T>(), 7.0, 1);
+    std::vector<T> out(in);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            out[i] = Clamp(in[i], T(1.5), T(4.5));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_SimdClamp(benchmark::State& state)
+{
+    const auto in = RandomValues<T>(kRangeOf<T>(), 7.0, 1);
+    std::vector<T> out(in);
+    for (auto _ : state)
+    {
+        fp::simd::Clamp<T>(in, T(1.5), T(4.5), out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// invariant divisor against operator/
+template<typename T>
+void BM_Divider(benchmark::State& state)
+{
+    const auto a = RandomValues<T>(kRangeOf<T>(), 7.0, 1);
+    const fp::Divider<T> divider(T(2.75));
+    std::vector<T> out(a);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            out[i] = a[i] / divider;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T, typename Func>
+void BM_Function(benchmark::State& state, Func func)
+{
+    const auto a = RandomValues<T>(0.01, 3.0, 4);
+    std::vector<T> out(a);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            out[i] = func(a[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// a batch function of fp::simd, over the same values as BM_Function
+template<typename T, typename Func>
+void BM_BatchFunction(benchmark::State& state, Func func)
+{
+    const auto a = RandomValues<T>(0.01, 3.0, 4);
+    std::vector<T> out(a);
+    for (auto _ : state)
+    {
+        func(a, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// all operator benchmarks of one representation
+template<typename T>
+void RegisterOperators(const std::string& name)
+{
+    benchmark::RegisterBenchmark((name + "/Add/Throughput").c_str(), BM_Throughput<T, AddOp>);
+    benchmark::RegisterBenchmark((name + "/Sub/Throughput").c_str(), BM_Throughput<T, SubOp>);
+    benchmark::RegisterBenchmark((name + "/Mul/Throughput").c_str(), BM_Throughput<T, MulOp>);
+    benchmark::RegisterBenchmark((name + "/Div/Throughput").c_str(), BM_Throughput<T, DivOp>);
+    benchmark::RegisterBenchmark((name + "/Add/Latency").c_str(), BM_Latency<T, AddOp>);
+    benchmark::RegisterBenchmark((name + "/Sub/Latency").c_str(), BM_Latency<T, SubOp>);
+    benchmark::RegisterBenchmark((name + "/Mul/Latency").c_str(), BM_Latency<T, MulOp>);
+    benchmark::RegisterBenchmark((name + "/Div/Latency").c_str(), BM_Latency<T, DivOp>);
+    benchmark::RegisterBenchmark((name + "/FromFloat").c_str(), BM_FromFloat<T>);
+    benchmark::RegisterBenchmark((name + "/ToFloat").c_str(), BM_ToFloat<T>);
+}
+
+// dot product with a narrowing multiply and add per element, the way it is written without fp::Dot()
+template<typename T>
+void BM_DotNarrowing(benchmark::State& state)
+{
+    const auto a = RandomValues<T>(-1.0, 1.0, 1);
+    const auto b = RandomValues<T>(-1.0, 1.0, 2);
+    for (auto _ : state)
+    {
+        auto acc = T(0);
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            acc += a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_Dot(benchmark::State& state)
+{
+    const auto a = RandomValues<T>(-1.0, 1.0, 1);
+    const auto b = RandomValues<T>(-1.0, 1.0, 2);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fp::Dot<T>(a, b));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_FromFloats(benchmark::State& state)
+{
+    std::vector<float> in(kBatchSize);
+    for (std::size_t i = 0; i < kBatchSize; ++i)
+    {
+        in[i] = static_cast<float>(i % 100) * 0.0625f;
+    }
+    std::vector<T> out(kBatchSize, T(0));
+    for (auto _ : state)
+    {
+        fp::FromFloats<T>(in, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_ToFloats(benchmark::State& state)
+{
+    const auto in = RandomValues<T>(kRangeOf<T>(), 7.0, 3);
+    std::vector<float> out(kBatchSize);
+    for (auto _ : state)
+    {
+        fp::ToFloats<T>(in, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// library features built on top of the operators
+template<typename T>
+void RegisterKernels(const std::string& name)
+{
+    benchmark::RegisterBenchmark((name + "/SimdAdd").c_str(), BM_SimdAdd<T>);
+    benchmark::RegisterBenchmark((name + "/SimdMul").c_str(), BM_SimdMul<T>);
+    benchmark::RegisterBenchmark((name + "/Clamp").c_str(), BM_Clamp<T>);
+    benchmark::RegisterBenchmark((name + "/SimdClamp").c_str(), BM_SimdClamp<T>);
+    benchmark::RegisterBenchmark((name + "/Divider").c_str(), BM_Divider<T>);
+    benchmark::RegisterBenchmark((name + "/DotNarrowing").c_str(), BM_DotNarrowing<T>);
+    benchmark::RegisterBenchmark((name + "/Dot").c_str(), BM_Dot<T>);
+    benchmark::RegisterBenchmark((name + "/FromFloats").c_str(), BM_FromFloats<T>);
+    benchmark::RegisterBenchmark((name + "/ToFloats").c_str(), BM_ToFloats<T>);
+}
+
+// text output through operator<< (a double conversion and iostreams) against fp::ToChars()
+template<typename T>
+void BM_StreamOut(benchmark::State& state)
+{
+    const auto in = RandomValues<T>(kRangeOf<T>(), 7.0, 6);
+    std::ostringstream os;
+    for (auto _ : state)
+    {
+        os.str({});
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            os << in[i] << ',';
+        }
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_ToChars(benchmark::State& state)
+{
+    const auto in = RandomValues<T>(kRangeOf<T>(), 7.0, 6);
+    std::vector<char> out(kBatchSize * (fp::kMaxCharsExact<T> + 1));
+    for (auto _ : state)
+    {
+        char* p {out.data()};
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            p = fp::ToChars(p, out.data() + out.size(), in[i]).ptr;
+            *p++ = ',';
+        }
+        benchmark::DoNotOptimize(p);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T>
+void BM_FromChars(benchmark::State& state)
+{
+    const auto values = RandomValues<T>(kRangeOf<T>(), 7.0, 6);
+    std::vector<char> text(kBatchSize * (fp::kMaxCharsExact<T> + 1));
+    char* end {text.data()};
+    for (const auto& v : values)
+    {
+        end = fp::ToChars(end, text.data() + text.size(), v).ptr;
+        *end++ = ',';
+    }
+    std::vector<T> out(values);
+    for (auto _ : state)
+    {
+        const char* p {text.data()};
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            p = fp::FromChars(p, end, out[i]).ptr + 1;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// exact sum of a large array, sequential against one thread per hardware thread
+template<typename T, typename ExecutionPolicy>
+void BM_Reduce(benchmark::State& state, ExecutionPolicy policy)
+{
+    std::vector<T> in(std::size_t{1} << 24, T(0));
+    const auto batch = RandomValues<T>(-1.0, 1.0, 5);
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = batch[i % kBatchSize];
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fp::Reduce<T>(policy, in));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(in.size()));
+}
+
+// square matrices of random values in [-1, 1]
+template<typename T>
+std::vector<T> RandomMatrix(std::size_t size, unsigned int seed)
+{
+    std::vector<T> m(size * size, T(0));
+    const auto batch = RandomValues<T>(-1.0, 1.0, seed);
+    for (std::size_t i = 0; i < m.size(); ++i)
+    {
+        m[i] = batch[(i * 7) % kBatchSize];
+    }
+    return m;
+}
+
+// matrix product as nested loops of operator* and operator+=, what fp::Gemm() replaces
+template<typename T>
+void BM_GemmNaive(benchmark::State& state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto a = RandomMatrix<T>(size, 1);
+    const auto b = RandomMatrix<T>(size, 2);
+    std::vector<T> c(size * size, T(0));
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            for (std::size_t j = 0; j < size; ++j)
+            {
+                auto acc = T(0);
+                for (std::size_t p = 0; p < size; ++p)
+                {
+                    acc += a[i * size + p] * b[p * size + j];
+                }
+                c[i * size + j] = acc;
+            }
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * state.range(0) * state.range(0));
+}
+
+template<typename T>
+void BM_Gemm(benchmark::State& state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto a = RandomMatrix<T>(size, 1);
+    const auto b = RandomMatrix<T>(size, 2);
+    std::vector<T> c(size * size, T(0));
+    for (auto _ : state)
+    {
+        fp::Gemm<T>(size, size, size, a, b, c);
+        benchmark::DoNotOptimize(c.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * state.range(0) * state.range(0));
+}
+
+// products of 4x4 matrices, one per element of the batch
+template<typename T>
+void BM_Mat4Mul(benchmark::State& state)
+{
+    using Mat4 = fp::Mat<T, 4, 4>;
+    const auto values = RandomValues<T>(-1.0, 1.0, 3);
+    std::vector<Mat4> m(kBatchSize);
+    for (std::size_t i = 0; i < kBatchSize; ++i)
+    {
+        for (std::size_t j = 0; j < 16; ++j)
+        {
+            m[i].Elements()[j] = values[(i + j) % kBatchSize];
+        }
+    }
+    std::vector<Mat4> out(kBatchSize);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            out[i] = m[i] * m[(i + 1) % kBatchSize];
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// complex input of the FFT benchmarks, components in [-0.5, 0.5]
+template<typename T, std::size_t N>
+std::array<fp::Complex<T>, N> RandomSignal()
+{
+    const auto values = RandomValues<T>(-0.5, 0.5, 6);
+    std::array<fp::Complex<T>, N> signal;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        signal[i] = {values[(2 * i) % kBatchSize], values[(2 * i + 1) % kBatchSize]};
+    }
+    return signal;
+}
+
+// radix-2 FFT with fp::Complex operators on an input pre-shifted by log2(N), what fp::FFT replaces
+template<typename T, std::size_t N>
+void BM_FFTNaive(benchmark::State& state)
+{
+    const auto signal = RandomSignal<T, N>();
+    std::array<fp::Complex<T>, N / 2> twiddles;
+    for (std::size_t k = 0; k < N / 2; ++k)
+    {
+        const double angle {-2.0 * 3.14159265358979323846 * static_cast<double>(k) / N};
+        twiddles[k] = {T(std::cos(angle) * 0.999), T(std::sin(angle) * 0.999)};
+    }
+    const T scale {T::FromBits(static_cast<typename T::ValueType>(fp::detail::RawBits(T::PosOne()) / static_cast<typename T::ValueType>(N)))};
+    for (auto _ : state)
+    {
+        auto x = signal;
+        for (auto& v : x)
+        {
+            v = {v.Real() * scale, v.Imag() * scale};
+        }
+        for (std::size_t i = 1, j = 0; i < N; ++i)
+        {
+            std::size_t bit {N >> 1};
+            for (; (j & bit) != 0; bit >>= 1)
+            {
+                j ^= bit;
+            }
+            j |= bit;
+            if (i < j)
+            {
+                std::swap(x[i], x[j]);
+            }
+        }
+        for (std::size_t len = 2; len <= N; len *= 2)
+        {
+            for (std::size_t g = 0; g < N; g += len)
+            {
+                for (std::size_t k = 0; k < len / 2; ++k)
+                {
+                    const auto t = x[g + k + len / 2] * twiddles[k * (N / len)];
+                    x[g + k + len / 2] = x[g + k] - t;
+                    x[g + k] += t;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * N));
+}
+
+// element-wise complex products of two batches, with a scalar product or the interleaved-buffer kernel
+template<typename T, typename Func>
+void BM_ComplexMul(benchmark::State& state, Func product)
+{
+    const auto signal = RandomSignal<T, kBatchSize>();
+    const std::vector<fp::Complex<T>> a(signal.begin(), signal.end());
+    const std::vector<fp::Complex<T>> b(signal.rbegin(), signal.rend());
+    std::vector<fp::Complex<T>> out(kBatchSize);
+    for (auto _ : state)
+    {
+        if constexpr (std::is_invocable_v<Func, const fp::Complex<T>&, const fp::Complex<T>&>)
+        {
+            for (std::size_t i = 0; i < kBatchSize; ++i)
+            {
+                out[i] = product(a[i], b[i]);
+            }
+        }
+        else
+        {
+            product(a, b, out);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T, std::size_t N>
+void BM_FFT(benchmark::State& state)
+{
+    const auto signal = RandomSignal<T, N>();
+    const fp::FFT<T, N> plan;
+    for (auto _ : state)
+    {
+        auto x = signal;
+        benchmark::DoNotOptimize(plan.Forward(x));
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * N));
+}
+
+// FIR filter over a batch: a sum of narrowed products per output against fp::FIR
+template<typename T, std::size_t Taps>
+void BM_FIRNaive(benchmark::State& state)
+{
+    const auto h = RandomValues<T>(-0.25, 0.25, 2);
+    // the batch after Taps - 1 zeros of history
+    std::vector<T> x(Taps - 1, T(0));
+    const auto signal = RandomValues<T>(-1.0, 1.0, 1);
+    x.insert(x.end(), signal.begin(), signal.end());
+    std::vector<T> out(kBatchSize);
+    for (auto _ : state)
+    {
+        for (std::size_t n = 0; n < kBatchSize; ++n)
+        {
+            auto acc = T(0);
+            for (std::size_t k = 0; k < Taps; ++k)
+            {
+                acc += h[k] * x[n + Taps - 1 - k];
+            }
+            out[n] = acc;
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T, std::size_t Taps>
+void BM_FIR(benchmark::State& state)
+{
+    const auto h = RandomValues<T>(-0.25, 0.25, 2);
+    std::array<T, Taps> coefficients;
+    std::copy_n(h.begin(), Taps, coefficients.begin());
+    fp::FIR<T, Taps> fir(coefficients);
+    const auto x = RandomValues<T>(-1.0, 1.0, 1);
+    std::vector<T> out(kBatchSize);
+    for (auto _ : state)
+    {
+        fir.Process(x, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// low-pass biquad over a batch of Channels interleaved channels, with Q2.14 coefficients
+template<typename T, fp::BiquadForm Form, std::size_t Channels>
+void BM_Biquad(benchmark::State& state)
+{
+    const fp::BiquadCoefficients<FP_Q2_14> lowpass {FP_Q2_14(0.0675), FP_Q2_14(0.1349), FP_Q2_14(0.0675), FP_Q2_14(-1.1430), FP_Q2_14(0.4128)};
+    fp::Biquad<T, Form, FP_Q2_14, Channels> filter(lowpass);
+    const auto x = RandomValues<T>(-1.0, 1.0, 1);
+    std::vector<T> out(kBatchSize);
+    for (auto _ : state)
+    {
+        filter.Process(x, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// per-channel gain of Channels interleaved channels, operator* with the gain of each channel
+template<typename T, std::size_t Channels>
+void BM_MulChannelsNaive(benchmark::State& state)
+{
+    const auto x = RandomValues<T>(-1.0, 1.0, 1);
+    const auto gains = RandomValues<T>(-1.0, 1.0, 2);
+    std::vector<T> out(kBatchSize);
+    for (auto _ : state)
+    {
+        for (std::size_t c = 0; c < Channels; ++c)
+        {
+            for (std::size_t i = c; i < kBatchSize; i += Channels)
+            {
+                out[i] = x[i] * gains[c];
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T, std::size_t Channels>
+void BM_MulChannels(benchmark::State& state)
+{
+    const auto x = RandomValues<T>(-1.0, 1.0, 1);
+    const auto gains = RandomValues<T>(-1.0, 1.0, 2);
+    std::vector<T> out(kBatchSize);
+    for (auto _ : state)
+    {
+        fp::simd::MulChannels<T>(x, std::span{gains}.first(Channels), out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// interleaved frames of Channels channels to planar, one element at a time
+template<typename T, std::size_t Channels>
+void BM_DeinterleaveNaive(benchmark::State& state)
+{
+    const auto x = RandomValues<T>(-1.0, 1.0, 1);
+    std::vector<T> out(kBatchSize);
+    constexpr std::size_t kFrames {kBatchSize / Channels};
+    for (auto _ : state)
+    {
+        for (std::size_t f = 0; f < kFrames; ++f)
+        {
+            for (std::size_t c = 0; c < Channels; ++c)
+            {
+                out[c * kFrames + f] = x[f * Channels + c];
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+template<typename T, std::size_t Channels>
+void BM_Deinterleave(benchmark::State& state)
+{
+    const auto x = RandomValues<T>(-1.0, 1.0, 1);
+    std::vector<T> out(kBatchSize);
+    for (auto _ : state)
+    {
+        fp::simd::Deinterleave<T>(x, Channels, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// downmix of the frames of Channels channels with per-channel gains
+template<typename T, std::size_t Channels>
+void BM_MixChannels(benchmark::State& state)
+{
+    const auto x = RandomValues<T>(-1.0, 1.0, 1);
+    const auto gains = RandomValues<T>(-0.125, 0.125, 2);
+    std::vector<T> out(kBatchSize / Channels);
+    for (auto _ : state)
+    {
+        fp::simd::MixChannels<T>(x, std::span{gains}.first(Channels), out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// 1 / (1 + e^-x) at compile time, e^-x as 2^k times ConstExp2() of the fraction
+constexpr double ConstSigmoid(double x)
+{
+    double y {-x * fp::detail::kLog2E};
+    double scale {1.0};
+    for (; y < 0.0; y += 1.0)
+    {
+        scale /= 2.0;
+    }
+    for (; y >= 1.0; y -= 1.0)
+    {
+        scale *= 2.0;
+    }
+    return 1.0 / (1.0 + scale * fp::detail::ConstExp2(y));
+}
+
+constexpr fp::TableFunc<FP_S32_16, 65> kSigmoidLinear {ConstSigmoid, -8.0, 8.0};
+constexpr fp::TableFunc<FP_S32_16, 65, fp::Interpolation::Cubic> kSigmoidCubic {ConstSigmoid, -8.0, 8.0};
+
+// audio chain over a block of floats: conversion, 32-tap FIR, low-pass biquad, gain and conversion back
+void BM_PipelineFilter(benchmark::State& state)
+{
+    using T = FP_S16_8;
+    const auto h = RandomValues<T>(-0.25, 0.25, 2);
+    std::array<T, 32> coefficients;
+    std::copy_n(h.begin(), coefficients.size(), coefficients.begin());
+    fp::FIR<T, 32> fir(coefficients);
+    const fp::BiquadCoefficients<FP_Q2_14> lowpass {FP_Q2_14(0.0675), FP_Q2_14(0.1349), FP_Q2_14(0.0675), FP_Q2_14(-1.1430), FP_Q2_14(0.4128)};
+    fp::Biquad<T, fp::BiquadForm::TransposedII, FP_Q2_14> filter(lowpass);
+    const auto in = RandomValues<float>(-1.0, 1.0, 1);
+    const std::vector<T> gains(kBatchSize, T(0.5));
+    std::vector<T> x(kBatchSize);
+    std::vector<T> y(kBatchSize);
+    std::vector<float> out(kBatchSize);
+    for (auto _ : state)
+    {
+        FP_PROFILE_SCOPE("pipeline/filter", kBatchSize);
+        fp::FromFloats<T>(in, x);
+        fir.Process(x, y);
+        filter.Process(y);
+        fp::simd::Mul<T>(y, gains, y);
+        fp::ToFloats<T>(y, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// power spectrum of a block of floats: conversion, Hann window, FFT, squared magnitudes and conversion back
+void BM_PipelineSpectrum(benchmark::State& state)
+{
+    using T = FP_Q30;
+    const auto in = RandomValues<float>(-1.0, 1.0, 1);
+    std::vector<T> window(kBatchSize);
+    for (std::size_t i = 0; i < kBatchSize; ++i)
+    {
+        window[i] = T(0.5 - 0.5 * std::cos(2.0 * 3.14159265358979323846 * static_cast<double>(i) / kBatchSize));
+    }
+    const fp::FFT<T, kBatchSize> plan;
+    std::array<fp::Complex<T>, kBatchSize> bins;
+    std::vector<T> x(kBatchSize);
+    std::vector<T> re(kBatchSize);
+    std::vector<T> im(kBatchSize);
+    std::vector<float> out(kBatchSize);
+    for (auto _ : state)
+    {
+        FP_PROFILE_SCOPE("pipeline/spectrum", kBatchSize);
+        fp::FromFloats<T>(in, x);
+        fp::simd::Mul<T>(x, window, x);
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            bins[i] = {x[i], T(0)};
+        }
+        benchmark::DoNotOptimize(plan.Forward(bins));
+        for (std::size_t i = 0; i < kBatchSize; ++i)
+        {
+            re[i] = bins[i].Real();
+            im[i] = bins[i].Imag();
+        }
+        fp::simd::Mul<T>(im, im, im);
+        fp::simd::Fma<T>(re, re, im, x);
+        fp::ToFloats<T>(x, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kBatchSize));
+}
+
+// transcendental functions of one backend
+template<fp::MathBackend Backend>
+void RegisterMath(const std::string& backend)
+{
+    benchmark::RegisterBenchmark(("S32_16/Sin/" + backend).c_str(), [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::Sin<Backend>(x); }); });
+    benchmark::RegisterBenchmark(("S32_16/Cos/" + backend).c_str(), [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::Cos<Backend>(x); }); });
+    benchmark::RegisterBenchmark(("S32_16/Atan2/" + backend).c_str(), [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::Atan2<Backend>(x, FP_S32_16(1.5) - x); }); });
+    benchmark::RegisterBenchmark(("S32_16/Exp/" + backend).c_str(), [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::Exp<Backend>(x); }); });
+    benchmark::RegisterBenchmark(("S32_16/Log/" + backend).c_str(), [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::Log<Backend>(x); }); });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    RegisterOperators<FP_S32_16>("S32_16");
+    RegisterOperators<FP_U32_16>("U32_16");
+    RegisterOperators<FP_S16_8>("S16_8");
+    RegisterOperators<FP_S64_32>("S64_32");
+    RegisterOperators<FP_S32_16_Sat>("S32_16_Sat");
+    RegisterOperators<FP_S32_16_Instrumented>("S32_16_Instrumented");
+    RegisterOperators<FP_S16_8_HalfEven>("S16_8_HalfEven");
+    RegisterOperators<FP_S16_8_Stochastic>("S16_8_Stochastic");
+    RegisterOperators<FP_Q64_64>("Q64_64");
+    RegisterOperators<FP_Q128_128>("Q128_128");
+    RegisterOperators<float>("float");
+    RegisterOperators<double>("double");
+    RegisterOperators<RawQ16>("RawQ16");
+
+    RegisterKernels<FP_S32_16>("S32_16");
+    RegisterKernels<FP_U32_16>("U32_16");
+    RegisterKernels<FP_S16_8>("S16_8");
+    RegisterKernels<FP_S64_32>("S64_32");
+    RegisterKernels<FP_S32_16_Sat>("S32_16_Sat");
+    RegisterKernels<FP_S16_8_Sat>("S16_8_Sat");
+    benchmark::RegisterBenchmark("S32_16/StreamOut", BM_StreamOut<FP_S32_16>);
+    benchmark::RegisterBenchmark("S32_16/ToChars", BM_ToChars<FP_S32_16>);
+    benchmark::RegisterBenchmark("S32_16/FromChars", BM_FromChars<FP_S32_16>);
+    benchmark::RegisterBenchmark("S64_32/ToChars", BM_ToChars<FP_S64_32>);
+    benchmark::RegisterBenchmark("S64_32/FromChars", BM_FromChars<FP_S64_32>);
+    benchmark::RegisterBenchmark("S32_16/Reduce/Seq", [](benchmark::State& state) { BM_Reduce<FP_S32_16>(state, std::execution::seq); });
+    benchmark::RegisterBenchmark("S32_16/Reduce/Par", [](benchmark::State& state) { BM_Reduce<FP_S32_16>(state, std::execution::par); });
+    benchmark::RegisterBenchmark("S32_16/GemmNaive", BM_GemmNaive<FP_S32_16>)->Arg(256);
+    benchmark::RegisterBenchmark("S32_16/Gemm", BM_Gemm<FP_S32_16>)->Arg(256);
+    benchmark::RegisterBenchmark("S16_8/GemmNaive", BM_GemmNaive<FP_S16_8>)->Arg(256);
+    benchmark::RegisterBenchmark("S16_8/Gemm", BM_Gemm<FP_S16_8>)->Arg(256);
+    benchmark::RegisterBenchmark("S32_16/Mat4Mul", BM_Mat4Mul<FP_S32_16>);
+    benchmark::RegisterBenchmark("Q15/FFTNaive/1024", BM_FFTNaive<FP_Q15, 1024>);
+    benchmark::RegisterBenchmark("Q15/FFT/1024", BM_FFT<FP_Q15, 1024>);
+    benchmark::RegisterBenchmark("Q30/FFTNaive/1024", BM_FFTNaive<FP_Q30, 1024>);
+    benchmark::RegisterBenchmark("Q30/FFT/1024", BM_FFT<FP_Q30, 1024>);
+    benchmark::RegisterBenchmark("S16_8/ComplexMul/Parts", [](benchmark::State& state) {
+        BM_ComplexMul<FP_S16_8>(state, [](const auto& x, const auto& y) -> fp::Complex<FP_S16_8> {
+            return {x.Real() * y.Real() - x.Imag() * y.Imag(), x.Real() * y.Imag() + x.Imag() * y.Real()};
+        });
+    });
+    benchmark::RegisterBenchmark("S16_8/ComplexMul/Operator", [](benchmark::State& state) { BM_ComplexMul<FP_S16_8>(state, [](const auto& x, const auto& y) { return x * y; }); });
+    benchmark::RegisterBenchmark("S16_8/ComplexMul/Mul3", [](benchmark::State& state) { BM_ComplexMul<FP_S16_8>(state, [](const auto& x, const auto& y) { return fp::Mul3(x, y); }); });
+    benchmark::RegisterBenchmark("S16_8/ComplexMul/Batch", [](benchmark::State& state) {
+        BM_ComplexMul<FP_S16_8>(state, [](std::span<const fp::Complex<FP_S16_8>> x, std::span<const fp::Complex<FP_S16_8>> y, std::span<fp::Complex<FP_S16_8>> out) {
+            fp::simd::Mul<FP_S16_8>(x, y, out);
+        });
+    });
+
+    benchmark::RegisterBenchmark("S16_8/FIRNaive/32", BM_FIRNaive<FP_S16_8, 32>);
+    benchmark::RegisterBenchmark("S16_8/FIR/32", BM_FIR<FP_S16_8, 32>);
+    benchmark::RegisterBenchmark("S32_16/FIRNaive/32", BM_FIRNaive<FP_S32_16, 32>);
+    benchmark::RegisterBenchmark("S32_16/FIR/32", BM_FIR<FP_S32_16, 32>);
+    benchmark::RegisterBenchmark("S16_8/Biquad/DirectI", BM_Biquad<FP_S16_8, fp::BiquadForm::DirectI, 1>);
+    benchmark::RegisterBenchmark("S16_8/Biquad/TransposedII", BM_Biquad<FP_S16_8, fp::BiquadForm::TransposedII, 1>);
+    benchmark::RegisterBenchmark("S16_8/Biquad/TransposedII/8ch", BM_Biquad<FP_S16_8, fp::BiquadForm::TransposedII, 8>);
+    benchmark::RegisterBenchmark("S16_8_Sat/Biquad/TransposedII/8ch", BM_Biquad<FP_S16_8_Sat, fp::BiquadForm::TransposedII, 8>);
+    benchmark::RegisterBenchmark("Q15/MulChannelsNaive/6ch", BM_MulChannelsNaive<FP_Q15, 6>);
+    benchmark::RegisterBenchmark("Q15/MulChannels/6ch", BM_MulChannels<FP_Q15, 6>);
+    benchmark::RegisterBenchmark("Q15/DeinterleaveNaive/8ch", BM_DeinterleaveNaive<FP_Q15, 8>);
+    benchmark::RegisterBenchmark("Q15/Deinterleave/8ch", BM_Deinterleave<FP_Q15, 8>);
+    benchmark::RegisterBenchmark("S32_16/DeinterleaveNaive/8ch", BM_DeinterleaveNaive<FP_S32_16, 8>);
+    benchmark::RegisterBenchmark("S32_16/Deinterleave/8ch", BM_Deinterleave<FP_S32_16, 8>);
+    benchmark::RegisterBenchmark("Q15/MixChannels/8ch", BM_MixChannels<FP_Q15, 8>);
+    benchmark::RegisterBenchmark("S16_8/Pipeline/Filter", BM_PipelineFilter);
+    benchmark::RegisterBenchmark("Q30/Pipeline/Spectrum", BM_PipelineSpectrum);
+
+    RegisterMath<fp::MathBackend::Table>("Table");
+    RegisterMath<fp::MathBackend::Cordic>("Cordic");
+    benchmark::RegisterBenchmark("S32_16/Sin/Double", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return FP_S32_16(std::sin(static_cast<double>(x))); }); });
+    benchmark::RegisterBenchmark("S32_16/Exp/Double", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return FP_S32_16(std::exp(static_cast<double>(x))); }); });
+    benchmark::RegisterBenchmark("S32_16/Sqrt/Double", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return FP_S32_16(std::sqrt(static_cast<double>(x))); }); });
+    benchmark::RegisterBenchmark("S32_16/Sqrt", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::Sqrt(x); }); });
+    benchmark::RegisterBenchmark("S32_16/FastSqrt", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::FastSqrt(x); }); });
+    benchmark::RegisterBenchmark("S32_16/InvSqrt/Double", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return FP_S32_16(1.0 / std::sqrt(static_cast<double>(x))); }); });
+    benchmark::RegisterBenchmark("S32_16/InvSqrt", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::InvSqrt(x); }); });
+    benchmark::RegisterBenchmark("S32_16/FastInvSqrt", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::FastInvSqrt(x); }); });
+    benchmark::RegisterBenchmark("S32_16/Sqrt/Batch", [](benchmark::State& state) { BM_BatchFunction<FP_S32_16>(state, [](const auto& in, auto& out) { fp::simd::Sqrt<FP_S32_16>(in, out); }); });
+    benchmark::RegisterBenchmark("S32_16/FastSqrt/Batch", [](benchmark::State& state) { BM_BatchFunction<FP_S32_16>(state, [](const auto& in, auto& out) { fp::simd::FastSqrt<FP_S32_16>(in, out); }); });
+    benchmark::RegisterBenchmark("S32_16/FastInvSqrt/Batch", [](benchmark::State& state) { BM_BatchFunction<FP_S32_16>(state, [](const auto& in, auto& out) { fp::simd::FastInvSqrt<FP_S32_16>(in, out); }); });
+    benchmark::RegisterBenchmark("S16_8/Sqrt/Batch", [](benchmark::State& state) { BM_BatchFunction<FP_S16_8>(state, [](const auto& in, auto& out) { fp::simd::Sqrt<FP_S16_8>(in, out); }); });
+    benchmark::RegisterBenchmark("S16_8/FastInvSqrt/Batch", [](benchmark::State& state) { BM_BatchFunction<FP_S16_8>(state, [](const auto& in, auto& out) { fp::simd::FastInvSqrt<FP_S16_8>(in, out); }); });
+    benchmark::RegisterBenchmark("S32_16/Sigmoid/Exp", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return FP_S32_16::PosOne() / (FP_S32_16::PosOne() + fp::Exp(-x)); }); });
+    benchmark::RegisterBenchmark("S32_16/Sigmoid/TableFunc/Linear", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, kSigmoidLinear); });
+    benchmark::RegisterBenchmark("S32_16/Sigmoid/TableFunc/Cubic", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, kSigmoidCubic); });
+    benchmark::RegisterBenchmark("S32_16/Reciprocal", [](benchmark::State& state) { BM_Function<FP_S32_16>(state, [](FP_S32_16 x) { return fp::Reciprocal(x); }); });
+
+#if defined(FP_PROFILE)
+    // --fp_trace=<file>: where the Chrome trace of the profiled regions goes
+    std::string trace_path {"fixed-point-profile.json"};
+    constexpr std::string_view kTraceFlag {"--fp_trace="};
+    int kept {1};
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg {argv[i]};
+        if (arg.starts_with(kTraceFlag))
+        {
+            trace_path = arg.substr(kTraceFlag.size());
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+#if defined(FP_PROFILE)
+    fp::WriteProfileSummary(std::cout);
+    std::ofstream trace(trace_path);
+    fp::WriteChromeTrace(trace);
+    std::cout << "trace: " << trace_path << "\n";
+#endif
+    return 0;
+}
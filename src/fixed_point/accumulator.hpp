@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "fixed_point.hpp"
+#include "simd.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+/// @brief Headroom the default accumulator aims for: 2^16 full-scale products can be summed.
+inline constexpr int kAccumulatorHeadroom {16};
+
+// signed or unsigned integer type of the given width, falls back to Fallback when there is none
+template<bool Signed, std::size_t Bits, typename Fallback>
+struct IntegerOfWidth { using type = Fallback; };
+
+template<typename Fallback> struct IntegerOfWidth<true, 64, Fallback> { using type = std::int64_t; };
+template<typename Fallback> struct IntegerOfWidth<false, 64, Fallback> { using type = std::uint64_t; };
+#if defined(__SIZEOF_INT128__)
+template<typename Fallback> struct IntegerOfWidth<true, 128, Fallback> { using type = int128; };
+template<typename Fallback> struct IntegerOfWidth<false, 128, Fallback> { using type = uint128; };
+#endif
+
+/// @brief The narrowest of WideType, 64 and 128 bits that leaves kAccumulatorHeadroom bits above a
+/// full product, or the widest of them when none does.
+template<FixedPoint NumberT>
+struct DefaultAccumulator
+{
+    using Wide = typename NumberT::WideValueType;
+    using Int64 = typename IntegerOfWidth<NumberT::kIsSigned, 64, Wide>::type;
+    using Int128 = typename IntegerOfWidth<NumberT::kIsSigned, 128, Int64>::type;
+
+    static constexpr int kNeeded {2 * std::numeric_limits<typename NumberT::ValueType>::digits + kAccumulatorHeadroom};
+
+    template<typename T>
+    static constexpr bool kFits {std::numeric_limits<T>::digits >= kNeeded};
+
+    using Widest = std::conditional_t<(sizeof(Int128) > sizeof(Wide)), Int128, Wide>;
+    using type = std::conditional_t<kFits<Wide>, Wide, std::conditional_t<kFits<Int64>, Int64, std::conditional_t<kFits<Int128>, Int128, Widest>>>;
+};
+
+/// @brief WideType when it holds a product plus an addend, the default accumulator otherwise.
+template<FixedPoint NumberT>
+using FmaAccumulatorType = std::conditional_t<(std::numeric_limits<typename NumberT::WideValueType>::digits > 2 * std::numeric_limits<typename NumberT::ValueType>::digits),
+                                              typename NumberT::WideValueType, typename DefaultAccumulator<NumberT>::type>;
+
+}  // namespace detail
+
+/**
+ * @brief Exact sum of products of fixed-point numbers.
+ *
+ * The raw products are summed with their full 2 * kNumFracBits fractional bits, with no shift
+ * per term. Result() rounds and narrows once, with the rounding and overflow policies of NumberT,
+ * so a sum of products is as precise as a single multiplication.
+ *
+ * The default AccumulatorType is the narrowest integer that leaves 16 bits of headroom above a
+ * full product (64 bits for 16-bit base types, 128 bits for 32-bit ones), or the widest available
+ * one. kHeadroomBits tells how many: 2^kHeadroomBits products of full-scale operands can be
+ * summed before the accumulator overflows. Partial results may exceed the range of NumberT, only
+ * the final one has to fit.
+ *
+ * @tparam NumberT The fixed point number type.
+ * @tparam AccumulatorType Integer type of the sum, at least as wide as a product.
+ */
+template<FixedPoint NumberT, Integral AccumulatorType = typename detail::DefaultAccumulator<NumberT>::type>
+requires SameSignedness<AccumulatorType, typename NumberT::ValueType>
+class Accumulator
+{
+public:
+    // bits above a full product
+    static constexpr int kHeadroomBits {std::numeric_limits<AccumulatorType>::digits - 2 * std::numeric_limits<typename NumberT::ValueType>::digits};
+    static_assert(kHeadroomBits >= 0, "AccumulatorType can't hold a product");
+
+    // constructor, starts from zero
+    constexpr Accumulator() noexcept : sum_{0} {}
+
+    // constructor, starts from initial
+    constexpr explicit Accumulator(NumberT initial) noexcept : sum_{Scale(initial)} {}
+
+    // adds a * b
+    constexpr Accumulator& MulAdd(NumberT a, NumberT b) noexcept
+    {
+        sum_ = static_cast<AccumulatorType>(sum_ + Product(a, b));
+        return *this;
+    }
+
+    // subtracts a * b
+    constexpr Accumulator& MulSub(NumberT a, NumberT b) noexcept
+    {
+        sum_ = static_cast<AccumulatorType>(sum_ - Product(a, b));
+        return *this;
+    }
+
+    /**
+     * @brief Adds the products a[i] * b[i] for the a.size() first elements.
+     *
+     * Vectorized with pmaddwd (AVX2) or vmull / vpadal (NEON) for signed 16-bit base types, and with
+     * 32x32 -> 64-bit multiplies summed as separate high and low halves for 32-bit base types.
+     * b must be at least as long as a.
+     */
+    constexpr Accumulator& MulAdd(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b) noexcept
+    {
+        std::size_t i {0};
+        if (!std::is_constant_evaluated())
+        {
+            i = simd::detail::DotKernel<NumberT>(a.data(), b.data(), a.size(), sum_);
+        }
+
+        for (; i < a.size(); ++i)
+        {
+            MulAdd(a[i], b[i]);
+        }
+        return *this;
+    }
+
+    // adds x
+    constexpr Accumulator& operator+=(NumberT x) noexcept
+    {
+        sum_ = static_cast<AccumulatorType>(sum_ + Scale(x));
+        return *this;
+    }
+
+    // subtracts x
+    constexpr Accumulator& operator-=(NumberT x) noexcept
+    {
+        sum_ = static_cast<AccumulatorType>(sum_ - Scale(x));
+        return *this;
+    }
+
+    // adds another partial sum
+    constexpr Accumulator& operator+=(const Accumulator& other) noexcept
+    {
+        sum_ = static_cast<AccumulatorType>(sum_ + other.sum_);
+        return *this;
+    }
+
+    // the sum rounded and narrowed to NumberT
+    [[nodiscard]] constexpr NumberT Result() const noexcept
+    {
+        const auto rounded = NumberT::BoundRoundingType::RoundShift(sum_, NumberT::kNumFracBits);
+        return NumberT::FromBits(NumberT::BoundOverflowType::template Narrow<typename NumberT::ValueType>(rounded));
+    }
+
+    // getter for the exact sum, with 2 * kNumFracBits fractional bits
+    [[nodiscard]] constexpr AccumulatorType Raw() const noexcept
+    {
+        return sum_;
+    }
+
+    // restarts from zero
+    constexpr void Reset() noexcept
+    {
+        sum_ = 0;
+    }
+
+private:
+    [[nodiscard]] static constexpr AccumulatorType Product(NumberT a, NumberT b) noexcept
+    {
+        return static_cast<AccumulatorType>(static_cast<AccumulatorType>(detail::RawBits(a)) * static_cast<AccumulatorType>(detail::RawBits(b)));
+    }
+
+    // x with 2 * kNumFracBits fractional bits
+    [[nodiscard]] static constexpr AccumulatorType Scale(NumberT x) noexcept
+    {
+        return static_cast<AccumulatorType>(static_cast<AccumulatorType>(detail::RawBits(x)) << NumberT::kNumFracBits);
+    }
+
+    AccumulatorType sum_;
+};
+
+/**
+ * @brief Dot product of a and b, rounded and narrowed once.
+ *
+ * Sums the exact products in an fp::Accumulator, see Accumulator::MulAdd() for the vectorization.
+ * Processes a.size() elements, b must be at least that long.
+ */
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr NumberT Dot(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b) noexcept
+{
+    return Accumulator<NumberT>{}.MulAdd(a, b).Result();
+}
+
+/**
+ * @brief Fused multiply-add, a * b + c rounded and narrowed once.
+ *
+ * Unlike `a * b + c`, the product keeps its low fractional bits until the addition. Computed in
+ * WideType when it holds the sum, which is the case for signed base types.
+ */
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr NumberT Fma(const NumberT& a, const NumberT& b, const NumberT& c) noexcept
+{
+    return Accumulator<NumberT, detail::FmaAccumulatorType<NumberT>>{c}.MulAdd(a, b).Result();
+}
+
+}  // namespace fp
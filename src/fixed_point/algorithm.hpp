@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <execution>
+#include <functional>
+#include <new>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fixed_point.hpp"
+#include "accumulator.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+/// @brief Integer the raw values are summed in: 32 bits of headroom for base types of up to 32 bits,
+/// 64 bits for 64-bit ones when there is a 128-bit type.
+template<FixedPoint NumberT>
+using ReduceSumType = typename IntegerOfWidth<NumberT::kIsSigned, (NumberT::kNumBits <= 32 ? 64 : 128), typename NumberT::WideValueType>::type;
+
+/// @brief Smallest number of elements given to a worker thread, below it starting the thread costs more than it saves.
+inline constexpr std::size_t kMinChunkSize {std::size_t{1} << 16};
+
+/// @brief Execution policies that run on several threads, the other ones run on the calling thread.
+template<typename ExecutionPolicy>
+inline constexpr bool kIsParallel {std::is_same_v<std::remove_cvref_t<ExecutionPolicy>, std::execution::parallel_policy> ||
+                                   std::is_same_v<std::remove_cvref_t<ExecutionPolicy>, std::execution::parallel_unsequenced_policy>};
+
+template<typename ExecutionPolicy>
+concept ExecutionPolicyType = std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>;
+
+// number of threads for n elements, at most one per hardware thread
+inline std::size_t WorkerCount(std::size_t n) noexcept
+{
+    const std::size_t hardware {std::max<std::size_t>(std::thread::hardware_concurrency(), 1)};
+    return std::clamp<std::size_t>(n / kMinChunkSize, 1, hardware);
+}
+
+/**
+ * @brief Calls func(begin, end, chunk) for `workers` contiguous chunks of [0, n).
+ *
+ * The calling thread runs the first chunk, the others run on their own std::jthread and are joined
+ * before returning. A chunk whose thread can't be started, or all of them when the thread list
+ * can't be allocated, runs on the calling thread.
+ */
+template<typename Func>
+void ParallelChunks(std::size_t n, std::size_t workers, Func func) noexcept
+{
+    std::vector<std::jthread> threads;
+    bool spawn {true};
+    try
+    {
+        threads.reserve(workers - 1);
+    }
+    catch (const std::bad_alloc&)
+    {
+        spawn = false;
+    }
+    for (std::size_t chunk = 1; chunk < workers; ++chunk)
+    {
+        const std::size_t begin {n * chunk / workers};
+        const std::size_t end {n * (chunk + 1) / workers};
+        if (!spawn)
+        {
+            func(begin, end, chunk);
+            continue;
+        }
+        try
+        {
+            threads.emplace_back(func, begin, end, chunk);
+        }
+        // std::system_error when the thread can't be started, std::bad_alloc for its state
+        catch (const std::exception&)
+        {
+            func(begin, end, chunk);
+        }
+    }
+    func(0, n / workers, 0);
+}
+
+// n value-initialized partial sums, empty when they can't be allocated
+template<typename T>
+[[nodiscard]] std::vector<T> TryAllocatePartials(std::size_t n) noexcept
+{
+    try
+    {
+        return std::vector<T>(n);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return {};
+    }
+}
+
+// exact sum of the raw bits of transform(in[i]) for i in [begin, end)
+template<FixedPoint NumberT, typename UnaryOp>
+[[nodiscard]] constexpr ReduceSumType<NumberT> RawSum(const NumberT* in, std::size_t begin, std::size_t end, UnaryOp& transform) noexcept
+{
+    using Sum = ReduceSumType<NumberT>;
+    Sum sum {0};
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const NumberT x = std::invoke(transform, in[i]);
+        sum = static_cast<Sum>(sum + static_cast<Sum>(RawBits(x)));
+    }
+    return sum;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Sum of transform(in[i]) over in, narrowed once.
+ *
+ * The raw values are summed exactly in a 64-bit integer (128-bit for 64-bit base types), which holds
+ * 2^32 full-scale values, and only the total goes through the overflow policy of NumberT. Integer
+ * addition is associative, so the result is the same for every execution policy and thread count.
+ * Unlike a chain of saturating additions it doesn't depend on the order of the elements either.
+ *
+ * std::execution::par and par_unseq split in into contiguous chunks summed on std::jthread workers,
+ * one per hardware thread and at least detail::kMinChunkSize elements each. seq and unseq run on
+ * the calling thread, as does everything during constant evaluation.
+ */
+template<FixedPoint NumberT, detail::ExecutionPolicyType ExecutionPolicy, typename UnaryOp>
+requires std::is_invocable_r_v<NumberT, UnaryOp&, const NumberT&>
+[[nodiscard]] constexpr NumberT TransformReduce(ExecutionPolicy&& /* policy */, std::span<const std::type_identity_t<NumberT>> in, UnaryOp transform) noexcept
+{
+    using Sum = detail::ReduceSumType<NumberT>;
+    Sum sum {0};
+    const std::size_t workers {!std::is_constant_evaluated() && detail::kIsParallel<ExecutionPolicy> ? detail::WorkerCount(in.size()) : 1};
+    // without memory for the partial sums the whole span is summed on the calling thread
+    std::vector<Sum> partial;
+    if (workers > 1)
+    {
+        partial = detail::TryAllocatePartials<Sum>(workers);
+    }
+    if (!partial.empty())
+    {
+        detail::ParallelChunks(in.size(), workers, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            // every chunk calls its own copy of the function object
+            auto local = transform;
+            partial[chunk] = detail::RawSum(in.data(), begin, end, local);
+        });
+        for (const Sum s : partial)
+        {
+            sum = static_cast<Sum>(sum + s);
+        }
+    }
+    else
+    {
+        sum = detail::RawSum(in.data(), 0, in.size(), transform);
+    }
+    return NumberT::FromBits(NumberT::BoundOverflowType::template Narrow<typename NumberT::ValueType>(sum));
+}
+
+/**
+ * @brief Dot product of a and b, the sum of a[i] * b[i] rounded and narrowed once.
+ *
+ * Every chunk sums its exact products in an fp::Accumulator (vectorized, see Accumulator::MulAdd())
+ * and the partial sums are merged before the single rounding, so the result equals fp::Dot() for
+ * every execution policy. Processes a.size() elements, b must be at least that long.
+ */
+template<FixedPoint NumberT, detail::ExecutionPolicyType ExecutionPolicy>
+[[nodiscard]] constexpr NumberT TransformReduce(ExecutionPolicy&& /* policy */, std::span<const std::type_identity_t<NumberT>> a,
+                                                std::span<const std::type_identity_t<NumberT>> b) noexcept
+{
+    const std::size_t workers {!std::is_constant_evaluated() && detail::kIsParallel<ExecutionPolicy> ? detail::WorkerCount(a.size()) : 1};
+    Accumulator<NumberT> sum;
+    std::vector<Accumulator<NumberT>> partial;
+    if (workers > 1)
+    {
+        partial = detail::TryAllocatePartials<Accumulator<NumberT>>(workers);
+    }
+    if (!partial.empty())
+    {
+        detail::ParallelChunks(a.size(), workers, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+            partial[chunk].MulAdd(a.subspan(begin, end - begin), b.subspan(begin, end - begin));
+        });
+        for (const auto& p : partial)
+        {
+            sum += p;
+        }
+    }
+    else
+    {
+        sum.MulAdd(a, b);
+    }
+    return sum.Result();
+}
+
+// sum of in narrowed once, see TransformReduce()
+template<FixedPoint NumberT, detail::ExecutionPolicyType ExecutionPolicy>
+[[nodiscard]] constexpr NumberT Reduce(ExecutionPolicy&& policy, std::span<const std::type_identity_t<NumberT>> in) noexcept
+{
+    return TransformReduce<NumberT>(std::forward<ExecutionPolicy>(policy), in, std::identity{});
+}
+
+// sequential sum of in narrowed once
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr NumberT Reduce(std::span<const std::type_identity_t<NumberT>> in) noexcept
+{
+    return Reduce<NumberT>(std::execution::seq, in);
+}
+
+// sequential sum of transform(in[i]) narrowed once
+template<FixedPoint NumberT, typename UnaryOp>
+requires std::is_invocable_r_v<NumberT, UnaryOp&, const NumberT&>
+[[nodiscard]] constexpr NumberT TransformReduce(std::span<const std::type_identity_t<NumberT>> in, UnaryOp transform) noexcept
+{
+    return TransformReduce<NumberT>(std::execution::seq, in, std::move(transform));
+}
+
+// sequential dot product of a and b
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr NumberT TransformReduce(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b) noexcept
+{
+    return TransformReduce<NumberT>(std::execution::seq, a, b);
+}
+
+/**
+ * @brief Element-wise transform: out[i] = op(in[i]).
+ *
+ * Runs on contiguous chunks like TransformReduce(), every chunk calls its own copy of op. Processes out.size() elements, in must be at least that long.
+ */
+template<FixedPoint NumberT, detail::ExecutionPolicyType ExecutionPolicy, typename UnaryOp>
+requires std::is_invocable_r_v<NumberT, UnaryOp&, const NumberT&>
+constexpr void Transform(ExecutionPolicy&& /* policy */, std::span<const std::type_identity_t<NumberT>> in, std::span<NumberT> out, UnaryOp op) noexcept
+{
+    const auto run = [&](std::size_t begin, std::size_t end, std::size_t /* chunk */) {
+        auto local = op;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            out[i] = std::invoke(local, in[i]);
+        }
+    };
+
+    const std::size_t workers {!std::is_constant_evaluated() && detail::kIsParallel<ExecutionPolicy> ? detail::WorkerCount(out.size()) : 1};
+    if (workers > 1)
+    {
+        detail::ParallelChunks(out.size(), workers, run);
+    }
+    else
+    {
+        run(0, out.size(), 0);
+    }
+}
+
+// element-wise transform of two inputs: out[i] = op(a[i], b[i]), a and b must be at least as long as out
+template<FixedPoint NumberT, detail::ExecutionPolicyType ExecutionPolicy, typename BinaryOp>
+requires std::is_invocable_r_v<NumberT, BinaryOp&, const NumberT&, const NumberT&>
+constexpr void Transform(ExecutionPolicy&& /* policy */, std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b,
+                         std::span<NumberT> out, BinaryOp op) noexcept
+{
+    const auto run = [&](std::size_t begin, std::size_t end, std::size_t /* chunk */) {
+        auto local = op;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            out[i] = std::invoke(local, a[i], b[i]);
+        }
+    };
+
+    const std::size_t workers {!std::is_constant_evaluated() && detail::kIsParallel<ExecutionPolicy> ? detail::WorkerCount(out.size()) : 1};
+    if (workers > 1)
+    {
+        detail::ParallelChunks(out.size(), workers, run);
+    }
+    else
+    {
+        run(0, out.size(), 0);
+    }
+}
+
+}  // namespace fp
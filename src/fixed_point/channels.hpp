@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "profile.hpp"
+#include "simd.hpp"
+
+namespace fp::simd
+{
+
+namespace detail
+{
+
+/// @brief Length of the rows of repeated per-channel values the channel operations feed to the
+/// element-wise kernels: whole frames, so that the kernel tails are short for any channel count.
+inline constexpr std::size_t kChannelRow {256};
+
+#if defined(__AVX2__)
+// transposes the 8x8 tile of 16-bit values at in (rows in_stride elements apart) into out
+inline void Transpose8x8(const std::int16_t* in, std::size_t in_stride, std::int16_t* out, std::size_t out_stride) noexcept
+{
+    const auto load = [in, in_stride](std::size_t r) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + r * in_stride)); };
+    const auto store = [out, out_stride](std::size_t r, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out + r * out_stride), v); };
+    // pairs of rows, then quadruples, then whole columns
+    const __m128i t0 = _mm_unpacklo_epi16(load(0), load(1));
+    const __m128i t1 = _mm_unpackhi_epi16(load(0), load(1));
+    const __m128i t2 = _mm_unpacklo_epi16(load(2), load(3));
+    const __m128i t3 = _mm_unpackhi_epi16(load(2), load(3));
+    const __m128i t4 = _mm_unpacklo_epi16(load(4), load(5));
+    const __m128i t5 = _mm_unpackhi_epi16(load(4), load(5));
+    const __m128i t6 = _mm_unpacklo_epi16(load(6), load(7));
+    const __m128i t7 = _mm_unpackhi_epi16(load(6), load(7));
+    const __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+    const __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+    const __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+    const __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+    const __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+    const __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+    const __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+    const __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+    store(0, _mm_unpacklo_epi64(u0, u4));
+    store(1, _mm_unpackhi_epi64(u0, u4));
+    store(2, _mm_unpacklo_epi64(u1, u5));
+    store(3, _mm_unpackhi_epi64(u1, u5));
+    store(4, _mm_unpacklo_epi64(u2, u6));
+    store(5, _mm_unpackhi_epi64(u2, u6));
+    store(6, _mm_unpacklo_epi64(u3, u7));
+    store(7, _mm_unpackhi_epi64(u3, u7));
+}
+
+// transposes the 4x4 tile of 32-bit values at in into out
+inline void Transpose4x4(const std::int32_t* in, std::size_t in_stride, std::int32_t* out, std::size_t out_stride) noexcept
+{
+    const auto load = [in, in_stride](std::size_t r) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + r * in_stride)); };
+    const auto store = [out, out_stride](std::size_t r, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out + r * out_stride), v); };
+    const __m128i t0 = _mm_unpacklo_epi32(load(0), load(1));
+    const __m128i t1 = _mm_unpackhi_epi32(load(0), load(1));
+    const __m128i t2 = _mm_unpacklo_epi32(load(2), load(3));
+    const __m128i t3 = _mm_unpackhi_epi32(load(2), load(3));
+    store(0, _mm_unpacklo_epi64(t0, t2));
+    store(1, _mm_unpackhi_epi64(t0, t2));
+    store(2, _mm_unpacklo_epi64(t1, t3));
+    store(3, _mm_unpackhi_epi64(t1, t3));
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+inline void Transpose8x8(const std::int16_t* in, std::size_t in_stride, std::int16_t* out, std::size_t out_stride) noexcept
+{
+    const auto load = [in, in_stride](std::size_t r) { return vld1q_s16(in + r * in_stride); };
+    const auto store = [out, out_stride](std::size_t r, int32x2_t lo, int32x2_t hi) { vst1q_s16(out + r * out_stride, vreinterpretq_s16_s32(vcombine_s32(lo, hi))); };
+    // trn of pairs of rows, then of their 32-bit pairs, leaves two half columns per register
+    const int16x8x2_t t01 = vtrnq_s16(load(0), load(1));
+    const int16x8x2_t t23 = vtrnq_s16(load(2), load(3));
+    const int16x8x2_t t45 = vtrnq_s16(load(4), load(5));
+    const int16x8x2_t t67 = vtrnq_s16(load(6), load(7));
+    const auto trn32 = [](int16x8_t a, int16x8_t b) { return vtrnq_s32(vreinterpretq_s32_s16(a), vreinterpretq_s32_s16(b)); };
+    const int32x4x2_t even_top = trn32(t01.val[0], t23.val[0]);
+    const int32x4x2_t odd_top = trn32(t01.val[1], t23.val[1]);
+    const int32x4x2_t even_bottom = trn32(t45.val[0], t67.val[0]);
+    const int32x4x2_t odd_bottom = trn32(t45.val[1], t67.val[1]);
+    store(0, vget_low_s32(even_top.val[0]), vget_low_s32(even_bottom.val[0]));
+    store(1, vget_low_s32(odd_top.val[0]), vget_low_s32(odd_bottom.val[0]));
+    store(2, vget_low_s32(even_top.val[1]), vget_low_s32(even_bottom.val[1]));
+    store(3, vget_low_s32(odd_top.val[1]), vget_low_s32(odd_bottom.val[1]));
+    store(4, vget_high_s32(even_top.val[0]), vget_high_s32(even_bottom.val[0]));
+    store(5, vget_high_s32(odd_top.val[0]), vget_high_s32(odd_bottom.val[0]));
+    store(6, vget_high_s32(even_top.val[1]), vget_high_s32(even_bottom.val[1]));
+    store(7, vget_high_s32(odd_top.val[1]), vget_high_s32(odd_bottom.val[1]));
+}
+
+inline void Transpose4x4(const std::int32_t* in, std::size_t in_stride, std::int32_t* out, std::size_t out_stride) noexcept
+{
+    const auto load = [in, in_stride](std::size_t r) { return vld1q_s32(in + r * in_stride); };
+    const auto store = [out, out_stride](std::size_t r, int32x2_t lo, int32x2_t hi) { vst1q_s32(out + r * out_stride, vcombine_s32(lo, hi)); };
+    const int32x4x2_t t01 = vtrnq_s32(load(0), load(1));
+    const int32x4x2_t t23 = vtrnq_s32(load(2), load(3));
+    store(0, vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+    store(1, vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+    store(2, vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+    store(3, vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+#endif
+
+// vectorized part of Transpose(), returns the size of the tiles it transposed: all rows and
+// columns below the multiples of it, 0 when it didn't run
+template<FixedPoint NumberT>
+inline std::size_t TransposeKernel(const NumberT* in, std::size_t rows, std::size_t cols, NumberT* out) noexcept
+{
+    std::size_t tile {0};
+
+#if defined(__AVX2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+    const auto run = [&](auto transpose, auto raw) {
+        using Raw = std::remove_pointer_t<decltype(raw)>;
+        for (std::size_t r = 0; r + tile <= rows; r += tile)
+        {
+            for (std::size_t c = 0; c + tile <= cols; c += tile)
+            {
+                transpose(reinterpret_cast<const Raw*>(in + r * cols + c), cols, reinterpret_cast<Raw*>(out + c * rows + r), rows);
+            }
+        }
+    };
+    if constexpr (sizeof(typename NumberT::ValueType) == 2)
+    {
+        tile = 8;
+        run(Transpose8x8, static_cast<std::int16_t*>(nullptr));
+    }
+    else if constexpr (sizeof(typename NumberT::ValueType) == 4)
+    {
+        tile = 4;
+        run(Transpose4x4, static_cast<std::int32_t*>(nullptr));
+    }
+#endif
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(in);
+    static_cast<void>(rows);
+    static_cast<void>(cols);
+    static_cast<void>(out);
+    return tile;
+}
+
+// out (cols x rows) = the transpose of in (rows x cols), both row-major
+template<FixedPoint NumberT>
+constexpr void Transpose(const NumberT* in, std::size_t rows, std::size_t cols, NumberT* out) noexcept
+{
+    std::size_t tile {0};
+    if (!std::is_constant_evaluated())
+    {
+        tile = TransposeKernel<NumberT>(in, rows, cols, out);
+    }
+
+    // the rows and columns past the last whole tiles
+    const std::size_t tiled_rows {tile > 0 ? rows - rows % tile : 0};
+    const std::size_t tiled_cols {tile > 0 ? cols - cols % tile : 0};
+    for (std::size_t r = 0; r < rows; ++r)
+    {
+        for (std::size_t c = r < tiled_rows ? tiled_cols : 0; c < cols; ++c)
+        {
+            out[c * rows + r] = in[r * cols + c];
+        }
+    }
+}
+
+// row of whole frames of the per-channel values, the values themselves when a frame is longer than a row
+template<FixedPoint NumberT>
+constexpr std::span<const NumberT> RepeatFrames(std::span<const NumberT> values, std::array<NumberT, kChannelRow>& row) noexcept
+{
+    if (values.size() > kChannelRow / 2)
+    {
+        return values;
+    }
+    const std::size_t frames {kChannelRow / values.size()};
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        std::copy(values.begin(), values.end(), row.begin() + static_cast<std::ptrdiff_t>(f * values.size()));
+    }
+    return std::span<const NumberT>{row}.first(frames * values.size());
+}
+
+}  // namespace detail
+
+/**
+ * @brief Interleaved frames to planar channels: out[c * frames + f] = in[f * channels + c], for
+ * frames = in.size() / channels.
+ *
+ * A transpose by tiles of 8x8 16-bit values or 4x4 32-bit values, each loaded as rows and
+ * shuffled into columns in registers (unpack on x86-64, trn on NEON), no gathers. The rows and
+ * columns past the last whole tiles are copied one by one. out must not overlap in.
+ */
+template<FixedPoint NumberT>
+constexpr void Deinterleave(std::span<const std::type_identity_t<NumberT>> in, std::size_t channels, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Deinterleave", in.size());
+    detail::Transpose<NumberT>(in.data(), in.size() / channels, channels, out.data());
+}
+
+/**
+ * @brief Planar channels to interleaved frames, the inverse of Deinterleave():
+ * out[f * channels + c] = in[c * frames + f], for frames = in.size() / channels.
+ */
+template<FixedPoint NumberT>
+constexpr void Interleave(std::span<const std::type_identity_t<NumberT>> in, std::size_t channels, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Interleave", in.size());
+    detail::Transpose<NumberT>(in.data(), channels, in.size() / channels, out.data());
+}
+
+/**
+ * @brief Per-channel gain of interleaved frames: out[i] = in[i] * gains[i % channels], with
+ * channels = gains.size().
+ *
+ * The gains are repeated into a row of whole frames (256 values at most), and the data is
+ * multiplied by it with the element-wise Mul(), so the vector kernels run at full width for any
+ * channel count. Bit-exact with the scalar operator. Processes out.size() elements, in must be at
+ * least that long. gains must not be empty, out may alias in.
+ */
+template<FixedPoint NumberT>
+constexpr void MulChannels(std::span<const std::type_identity_t<NumberT>> in, std::span<const std::type_identity_t<NumberT>> gains, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::MulChannels", out.size());
+    std::array<NumberT, detail::kChannelRow> row;
+    const std::span<const NumberT> pattern {detail::RepeatFrames<NumberT>(gains, row)};
+    for (std::size_t i = 0; i < out.size(); i += pattern.size())
+    {
+        const std::size_t n {std::min(pattern.size(), out.size() - i)};
+        Mul<NumberT>(in.subspan(i, n), pattern.first(n), out.subspan(i, n));
+    }
+}
+
+/**
+ * @brief Weighted mix of the channels of each frame: out[f] = sum of in[f * channels + c] * gains[c]
+ * over the channels, with channels = gains.size().
+ *
+ * Each sum is a Dot() of a frame with the gains: exact and rounded and narrowed once, vectorized
+ * across the channels (pmaddwd by 16 or 8 channels, 32-bit products by 4 on AVX2). Processes
+ * out.size() frames, in must hold at least that many.
+ */
+template<FixedPoint NumberT>
+constexpr void MixChannels(std::span<const std::type_identity_t<NumberT>> in, std::span<const std::type_identity_t<NumberT>> gains, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::MixChannels", out.size() * gains.size());
+    const std::size_t channels {gains.size()};
+    for (std::size_t f = 0; f < out.size(); ++f)
+    {
+        out[f] = Dot<NumberT>(in.subspan(f * channels, channels), gains);
+    }
+}
+
+/**
+ * @brief Sum of the channels of each frame: out[f] = in[f * channels] + ... + in[f * channels + channels - 1].
+ *
+ * The sums are exact and narrowed once with the overflow policy of NumberT. They are the dot
+ * products of the frames with a row of the smallest positive value, so they use the vectorized
+ * Dot() kernels. Processes out.size() frames, in must hold at least that many.
+ */
+template<FixedPoint NumberT>
+constexpr void SumChannels(std::span<const std::type_identity_t<NumberT>> in, std::size_t channels, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::SumChannels", out.size() * channels);
+    std::array<NumberT, detail::kChannelRow> ones;
+    ones.fill(NumberT::FromBits(1));
+    for (std::size_t f = 0; f < out.size(); ++f)
+    {
+        const std::span<const NumberT> frame {in.subspan(f * channels, channels)};
+        // the raw sum, with kNumFracBits fractional bits
+        Accumulator<NumberT> sum;
+        for (std::size_t c = 0; c < channels; c += detail::kChannelRow)
+        {
+            const std::size_t n {std::min(detail::kChannelRow, channels - c)};
+            sum.MulAdd(frame.subspan(c, n), std::span<const NumberT>{ones}.first(n));
+        }
+        out[f] = NumberT::FromBits(NumberT::BoundOverflowType::template Narrow<typename NumberT::ValueType>(sum.Raw()));
+    }
+}
+
+}  // namespace fp::simd
@@ -0,0 +1,588 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <version>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#include "fixed_point.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+#if defined(__SIZEOF_INT128__)
+/// @brief Integers FromChars() accumulates the scaled value in, 128 bits cover every format.
+using ParseUnsigned = uint128;
+using ParseSigned = int128;
+
+/// @brief Fractional digits parsed at a time, their value times 2^64 fits in ParseUnsigned and twice their scale in 64 bits.
+inline constexpr int kFractionChunk {18};
+#else
+// without the 128-bit types the formats of up to 32 bits are converted in 64 bits, nine digits times 2^32 fit
+using ParseUnsigned = std::uint64_t;
+using ParseSigned = std::int64_t;
+
+inline constexpr int kFractionChunk {9};
+#endif
+
+/// @brief Trait: ToChars() and FromChars() support NumberT, which needs the 128-bit types above 32 bits.
+template<FixedPoint NumberT>
+inline constexpr bool kHasCharConv {sizeof(ParseUnsigned) > sizeof(std::uint64_t) || NumberT::kNumBits <= 32};
+
+/// @brief Integer the fractional part is scaled in while producing digits, it must hold the fraction times 10.
+template<FixedPoint NumberT>
+using FractionType = std::conditional_t<(NumberT::kNumFracBits <= 60), std::uint64_t, ParseUnsigned>;
+
+template<FixedPoint NumberT>
+struct DecimalParts
+{
+    std::uint64_t integer;
+    FractionType<NumberT> fraction;  // numerator of fraction / 2^kNumFracBits
+    bool negative;
+};
+
+// sign, integer part and fractional part of the magnitude of x
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr DecimalParts<NumberT> SplitDecimal(const NumberT& x) noexcept
+{
+    using Fraction = FractionType<NumberT>;
+    constexpr std::size_t kFracBits {NumberT::kNumFracBits};
+
+    const auto raw = RawBits(x);
+    bool negative {false};
+    auto magnitude = static_cast<std::uint64_t>(raw);
+    if constexpr (NumberT::kIsSigned)
+    {
+        negative = raw < 0;
+        // well defined for the minimum value
+        magnitude = negative ? std::uint64_t{0} - magnitude : magnitude;
+    }
+
+    if constexpr (kFracBits >= 64)
+    {
+        return {0, static_cast<Fraction>(magnitude), negative};
+    }
+    else
+    {
+        const auto mask = static_cast<std::uint64_t>((std::uint64_t{1} << kFracBits) - 1);
+        return {magnitude >> kFracBits, static_cast<Fraction>(magnitude & mask), negative};
+    }
+}
+
+[[nodiscard]] constexpr int DecimalDigits(std::uint64_t value) noexcept
+{
+    int digits {1};
+    for (; value >= 10; value /= 10)
+    {
+        ++digits;
+    }
+    return digits;
+}
+
+// writes the decimal digits of value so that they end just before end
+constexpr void WriteDigitsBackwards(char* end, std::uint64_t value) noexcept
+{
+    do
+    {
+        *--end = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+}
+
+// writes count digits of fraction / 2^FracBits, fraction keeps what is left
+template<std::size_t FracBits, typename Fraction>
+constexpr char* WriteFractionDigits(char* out, Fraction& fraction, int count) noexcept
+{
+    const auto mask = static_cast<Fraction>((static_cast<Fraction>(1) << FracBits) - 1);
+    for (int i = 0; i < count; ++i)
+    {
+        fraction = static_cast<Fraction>(fraction * 10);
+        *out++ = static_cast<char>('0' + static_cast<int>(fraction >> FracBits));
+        fraction = static_cast<Fraction>(fraction & mask);
+    }
+    return out;
+}
+
+template<typename Fraction>
+[[nodiscard]] constexpr int CountTrailingZeros(Fraction value) noexcept
+{
+    if constexpr (sizeof(Fraction) > sizeof(std::uint64_t))
+    {
+        const auto low = static_cast<std::uint64_t>(value);
+        return low != 0 ? std::countr_zero(low) : 64 + std::countr_zero(static_cast<std::uint64_t>(value >> 64));
+    }
+    else
+    {
+        return std::countr_zero(value);
+    }
+}
+
+[[nodiscard]] constexpr bool IsDigit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+struct DigitChunk
+{
+    std::uint64_t digits;
+    std::uint64_t scale;  // 10^(number of digits)
+};
+
+// value of at most kFractionChunk digits
+[[nodiscard]] constexpr DigitChunk ParseChunk(const char* first, const char* last) noexcept
+{
+    DigitChunk chunk {0, 1};
+    for (; first != last; ++first)
+    {
+        chunk.digits = chunk.digits * 10 + static_cast<std::uint64_t>(*first - '0');
+        chunk.scale *= 10;
+    }
+    return chunk;
+}
+
+/**
+ * @brief FracBits bits of the decimal fraction 0.[first, last), digit by digit.
+ *
+ * The digits are doubled FracBits times, the carry out of the first one is the next bit. Ties and
+ * whole ULPs have at most FracBits + 1 decimal digits, so later digits can't change the rounding
+ * and only count as a sticky digit. remainder is set to what is left compared with half an ULP,
+ * in quarters of a denominator of 4: 0 (exact), 1 (below half), 2 (half) or 3 (above half).
+ */
+template<std::size_t FracBits>
+[[nodiscard]] constexpr ParseUnsigned LongFraction(const char* first, const char* last, ParseSigned& remainder) noexcept
+{
+    std::array<std::uint8_t, FracBits + 1> digits {};
+    const std::size_t count {std::min(static_cast<std::size_t>(last - first), digits.size())};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        digits[i] = static_cast<std::uint8_t>(first[i] - '0');
+    }
+    const bool sticky {std::any_of(first + count, last, [](char c) { return c != '0'; })};
+
+    ParseUnsigned bits {0};
+    for (std::size_t bit = 0; bit < FracBits; ++bit)
+    {
+        unsigned int carry {0};
+        for (std::size_t i = count; i-- > 0;)
+        {
+            const unsigned int doubled {2U * digits[i] + carry};
+            carry = doubled >= 10 ? 1U : 0U;
+            digits[i] = static_cast<std::uint8_t>(doubled - 10 * carry);
+        }
+        bits = (bits << 1) | carry;
+    }
+
+    const bool rest {sticky || std::any_of(digits.begin() + 1, digits.begin() + static_cast<std::ptrdiff_t>(count), [](std::uint8_t d) { return d != 0; })};
+    if (digits[0] == 5)
+    {
+        remainder = rest ? 3 : 2;
+    }
+    else
+    {
+        remainder = digits[0] > 5 ? 3 : (digits[0] != 0 || rest ? 1 : 0);
+    }
+    return bits;
+}
+
+}  // namespace detail
+
+/// @brief Length of the longest exact ToChars() output of NumberT: sign, integer digits, point and fractional digits.
+template<FixedPoint NumberT>
+inline constexpr std::size_t kMaxCharsExact {2 + static_cast<std::size_t>(std::numeric_limits<typename NumberT::ValueType>::digits10) + 1 +
+                                                NumberT::kNumFracBits};
+
+/**
+ * @brief Writes the exact decimal value of x to [first, last), like std::to_chars.
+ *
+ * x is an integer multiple of 2^-kNumFracBits, so it has a finite decimal expansion of at most
+ * kNumFracBits fractional digits. They are all written, without trailing zeros and without the
+ * point for integral values, which makes FromChars() give back the same bits with every rounding
+ * policy. The digits are computed from the integer bits, no floating point, no locale and no
+ * allocation. At most kMaxCharsExact<NumberT> characters are written.
+ *
+ * Returns {last, std::errc::value_too_large} if the range is too small, and leaves its content
+ * unspecified then.
+ */
+template<FixedPoint NumberT>
+requires detail::kHasCharConv<NumberT>
+constexpr std::to_chars_result ToChars(char* first, char* last, const NumberT& x) noexcept
+{
+    constexpr std::size_t kFracBits {NumberT::kNumFracBits};
+    auto [integer, fraction, negative] = detail::SplitDecimal(x);
+
+    const int int_digits {detail::DecimalDigits(integer)};
+    const int frac_digits {fraction == 0 ? 0 : static_cast<int>(kFracBits) - detail::CountTrailingZeros(fraction)};
+    const auto length = static_cast<std::ptrdiff_t>(negative) + int_digits + (frac_digits > 0 ? 1 + frac_digits : 0);
+    if (last - first < length)
+    {
+        return {last, std::errc::value_too_large};
+    }
+
+    char* out {first};
+    if (negative)
+    {
+        *out++ = '-';
+    }
+    out += int_digits;
+    detail::WriteDigitsBackwards(out, integer);
+    if (frac_digits > 0)
+    {
+        *out++ = '.';
+        out = detail::WriteFractionDigits<kFracBits>(out, fraction, frac_digits);
+    }
+    return {out, std::errc{}};
+}
+
+/**
+ * @brief Writes x with precision fractional digits to [first, last), like std::to_chars with std::chars_format::fixed.
+ *
+ * The exact value is rounded half to even to the last digit (as printf does with a double holding
+ * the same value). Digits beyond kNumFracBits are zeros, the point is omitted for precision 0.
+ * Returns {last, std::errc::value_too_large} if the range is too small.
+ */
+template<FixedPoint NumberT>
+requires detail::kHasCharConv<NumberT>
+constexpr std::to_chars_result ToChars(char* first, char* last, const NumberT& x, int precision) noexcept
+{
+    using Fraction = detail::FractionType<NumberT>;
+    constexpr std::size_t kFracBits {NumberT::kNumFracBits};
+    precision = std::max(precision, 0);
+    auto [integer, fraction, negative] = detail::SplitDecimal(x);
+
+    const int int_digits {detail::DecimalDigits(integer)};
+    const auto length = static_cast<std::ptrdiff_t>(negative) + int_digits + (precision > 0 ? 1 + precision : 0);
+    if (last - first < length)
+    {
+        return {last, std::errc::value_too_large};
+    }
+
+    char* out {first};
+    if (negative)
+    {
+        *out++ = '-';
+    }
+    char* const digits {out};
+    out += int_digits;
+    detail::WriteDigitsBackwards(out, integer);
+    if (precision > 0)
+    {
+        *out++ = '.';
+        out = detail::WriteFractionDigits<kFracBits>(out, fraction, precision);
+    }
+
+    if constexpr (kFracBits > 0)
+    {
+        // what is left is below one unit of the last digit, compared with half of it
+        constexpr auto kHalf = static_cast<Fraction>(static_cast<Fraction>(1) << (kFracBits - 1));
+        const bool odd {((out[-1] - '0') & 1) != 0};
+        if (fraction > kHalf || (fraction == kHalf && odd))
+        {
+            char* p {out};
+            while (p != digits)
+            {
+                --p;
+                if (*p == '.')
+                {
+                    continue;
+                }
+                if (*p != '9')
+                {
+                    ++*p;
+                    return {out, std::errc{}};
+                }
+                *p = '0';
+            }
+
+            // all digits were nines, the integer part gets one more digit
+            if (out == last)
+            {
+                return {last, std::errc::value_too_large};
+            }
+            std::copy_backward(digits, out, out + 1);
+            *digits = '1';
+            ++out;
+        }
+    }
+    return {out, std::errc{}};
+}
+
+/**
+ * @brief Parses a decimal number from [first, last) into value, like std::from_chars.
+ *
+ * Accepts an optional '-', integer digits and an optional '.' followed by fractional digits (at
+ * least one digit overall), no whitespace, '+' or exponent. The decimal value is rounded
+ * exactly with the rounding policy of NumberT, whatever the number of digits: up to 36
+ * fractional digits take two integer divisions, later ones only decide the rounding and are
+ * converted digit by digit in the rare cases where they could change it. No floating point and no
+ * allocation. Without the 128-bit integer types only base types of up to 32 bits are supported,
+ * and the divisions take 18 digits.
+ *
+ * On success value is set and ptr points past the number. Returns std::errc::invalid_argument if
+ * there is no number, and std::errc::result_out_of_range if the rounded value doesn't fit in
+ * NumberT; value is left unchanged in both cases.
+ */
+template<FixedPoint NumberT>
+requires detail::kHasCharConv<NumberT>
+constexpr std::from_chars_result FromChars(const char* first, const char* last, NumberT& value) noexcept
+{
+    using ValueType = typename NumberT::ValueType;
+    using Unsigned = detail::ParseUnsigned;
+    using Signed = detail::ParseSigned;
+    constexpr std::size_t kFracBits {NumberT::kNumFracBits};
+    // the largest integer part that can still be in range, the magnitude of the minimum for signed types
+    constexpr Unsigned kMaxInteger {(static_cast<Unsigned>(std::numeric_limits<ValueType>::max()) >> kFracBits) + 1};
+
+    const char* p {first};
+    const bool negative {p != last && *p == '-'};
+    if (negative)
+    {
+        ++p;
+    }
+
+    // integer part, saturated just above kMaxInteger
+    Unsigned integer {0};
+    const char* const int_begin {p};
+    for (; p != last && detail::IsDigit(*p); ++p)
+    {
+        integer = std::min(integer * 10 + static_cast<Unsigned>(*p - '0'), kMaxInteger + 1);
+    }
+    bool has_digits {p != int_begin};
+
+    // fractional part
+    const char* frac_begin {p};
+    const char* frac_end {p};
+    if (p != last && *p == '.')
+    {
+        frac_begin = ++p;
+        for (; p != last && detail::IsDigit(*p); ++p)
+        {
+        }
+        frac_end = p;
+        has_digits = has_digits || frac_end != frac_begin;
+    }
+    if (!has_digits)
+    {
+        return {first, std::errc::invalid_argument};
+    }
+    if (integer > kMaxInteger)
+    {
+        return {p, std::errc::result_out_of_range};
+    }
+
+    // the magnitude is (integer * 2^F + quotient + remainder / denominator) ULPs
+    const auto frac_count = static_cast<int>(frac_end - frac_begin);
+    const char* const coarse_end {frac_begin + std::min(frac_count, detail::kFractionChunk)};
+    const char* const fine_end {coarse_end + std::min(static_cast<int>(frac_end - coarse_end), detail::kFractionChunk)};
+    const auto [coarse, coarse_scale] = detail::ParseChunk(frac_begin, coarse_end);
+    const auto [fine, fine_scale] = detail::ParseChunk(coarse_end, fine_end);
+
+    // digits * 2^F / scale, the quotient is below 2^F
+    const auto scaled_divide = [](std::uint64_t digits, std::uint64_t scale, Unsigned carry_in) {
+        if constexpr (kFracBits <= 32)
+        {
+            if (carry_in == 0 && scale <= 1'000'000'000)
+            {
+                // digits * 2^F fits in 64 bits
+                const std::uint64_t numerator {digits << kFracBits};
+                return detail::QuotientRemainder<Unsigned>{numerator / scale, numerator % scale};
+            }
+        }
+        return detail::DivideWide<std::uint64_t>((static_cast<Unsigned>(digits) << kFracBits) + carry_in, static_cast<Unsigned>(scale));
+    };
+
+    // the first 18 digits divided exactly, the next 18 only as the integer part of their own quotient, which
+    // adds less than an ULP of the first division; the rest can't change the rounding unless they carry into it
+    Unsigned fine_quotient {0};
+    bool fine_nonzero {false};
+    bool digit_by_digit {false};
+    if (fine_scale > 1)
+    {
+        const auto [q, r] = scaled_divide(fine, fine_scale, 0);
+        const bool rest {std::any_of(fine_end, frac_end, [](char c) { return c != '0'; })};
+        fine_quotient = q;
+        fine_nonzero = r != 0 || rest;
+        digit_by_digit = rest && r + (static_cast<Unsigned>(1) << kFracBits) > fine_scale;
+    }
+
+    Unsigned quotient {0};
+    Signed remainder {0};
+    Signed denominator {4};
+    if (digit_by_digit)
+    {
+        quotient = detail::LongFraction<kFracBits>(frac_begin, frac_end, remainder);
+    }
+    else
+    {
+        // twice the remainder plus one for the fine digits keeps the comparison with half exact
+        const auto [q, r] = scaled_divide(coarse, coarse_scale, fine_quotient);
+        quotient = q;
+        remainder = static_cast<Signed>(2 * r + (fine_nonzero ? 1 : 0));
+        denominator = static_cast<Signed>(2 * coarse_scale);
+    }
+
+    auto total = static_cast<Signed>((integer << kFracBits) + quotient);
+    if (negative)
+    {
+        total = -total;
+        remainder = -remainder;
+    }
+    const Signed rounded {NumberT::BoundRoundingType::RoundQuotient(total, remainder, denominator)};
+    if (rounded > static_cast<Signed>(std::numeric_limits<ValueType>::max()) || rounded < static_cast<Signed>(std::numeric_limits<ValueType>::min()))
+    {
+        return {p, std::errc::result_out_of_range};
+    }
+    value = NumberT::FromBits(static_cast<ValueType>(rounded));
+    return {p, std::errc{}};
+}
+
+namespace detail
+{
+
+// not constexpr, so a literal that can't be parsed fails the compilation here
+inline void InvalidFixedPointLiteral() noexcept {}
+
+// the numeric literal Chars parsed into NumberT by FromChars(), during compilation
+template<FixedPoint NumberT, char... Chars>
+[[nodiscard]] consteval NumberT ParseLiteral() noexcept
+{
+    constexpr std::array<char, sizeof...(Chars)> kText {Chars...};
+    NumberT value;
+    const auto [ptr, error] = FromChars(kText.data(), kText.data() + kText.size(), value);
+    if (error != std::errc{} || ptr != kText.data() + kText.size())
+    {
+        InvalidFixedPointLiteral();
+    }
+    return value;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Literals for the common formats with the default policies, e.g. `1.5_q16` or `-0.25_q15`
+ * (negated by operator-), after `using namespace fp::literals;`.
+ *
+ * The decimal digits are parsed by FromChars() during compilation, so the constant is exact
+ * (rounded as the format rounds) rather than going through a double. Exponents, hexadecimal
+ * literals, digit separators and values out of range fail the compilation.
+ * - _q8: Q7.8, Number<std::int16_t, std::int32_t, 8>
+ * - _q15: Q0.15, Number<std::int16_t, std::int32_t, 1>
+ * - _q16: Q15.16, Number<std::int32_t, std::int64_t, 16>
+ * - _q31: Q0.31, Number<std::int32_t, std::int64_t, 1>
+ * - _q32: Q31.32, Number<std::int64_t, fp::int128, 32>, where the 128-bit types exist
+ * Other formats take fp::Const<NumberT, Value>.
+ */
+namespace literals
+{
+
+template<char... Chars>
+[[nodiscard]] consteval Number<std::int16_t, std::int32_t, 8> operator""_q8() noexcept
+{
+    return detail::ParseLiteral<Number<std::int16_t, std::int32_t, 8>, Chars...>();
+}
+
+template<char... Chars>
+[[nodiscard]] consteval Number<std::int16_t, std::int32_t, 1> operator""_q15() noexcept
+{
+    return detail::ParseLiteral<Number<std::int16_t, std::int32_t, 1>, Chars...>();
+}
+
+template<char... Chars>
+[[nodiscard]] consteval Number<std::int32_t, std::int64_t, 16> operator""_q16() noexcept
+{
+    return detail::ParseLiteral<Number<std::int32_t, std::int64_t, 16>, Chars...>();
+}
+
+template<char... Chars>
+[[nodiscard]] consteval Number<std::int32_t, std::int64_t, 1> operator""_q31() noexcept
+{
+    return detail::ParseLiteral<Number<std::int32_t, std::int64_t, 1>, Chars...>();
+}
+
+#if defined(__SIZEOF_INT128__)
+template<char... Chars>
+[[nodiscard]] consteval Number<std::int64_t, int128, 32> operator""_q32() noexcept
+{
+    return detail::ParseLiteral<Number<std::int64_t, int128, 32>, Chars...>();
+}
+#endif
+
+}  // namespace literals
+
+}  // namespace fp
+
+#if defined(__cpp_lib_format)
+/**
+ * @brief std::format support for fp::Number.
+ *
+ * "{}" writes the exact value as fp::ToChars() does, "{:.N}" writes N fractional digits rounded
+ * half to even. No other format specification is accepted.
+ */
+template<fp::Integral IntType, fp::Integral WideType, std::size_t NumIntBits, typename Overflow, typename Rounding>
+requires fp::detail::kHasCharConv<fp::Number<IntType, WideType, NumIntBits, Overflow, Rounding>>
+struct std::formatter<fp::Number<IntType, WideType, NumIntBits, Overflow, Rounding>, char>
+{
+    constexpr auto parse(std::format_parse_context& ctx)
+    {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it == '.')
+        {
+            ++it;
+            if (it == ctx.end() || !fp::detail::IsDigit(*it))
+            {
+                throw std::format_error("fp::Number: missing precision after '.'");
+            }
+            precision_ = 0;
+            for (; it != ctx.end() && fp::detail::IsDigit(*it); ++it)
+            {
+                precision_ = std::min(precision_ * 10 + (*it - '0'), kMaxPrecision);
+            }
+        }
+        if (it != ctx.end() && *it != '}')
+        {
+            throw std::format_error("fp::Number: invalid format specification");
+        }
+        return it;
+    }
+
+    template<typename FormatContext>
+    auto format(const fp::Number<IntType, WideType, NumIntBits, Overflow, Rounding>& x, FormatContext& ctx) const
+    {
+        using NumberT = fp::Number<IntType, WideType, NumIntBits, Overflow, Rounding>;
+        constexpr int kFracBits {static_cast<int>(NumberT::kNumFracBits)};
+
+        // one more character for the carry of a rounded value, digits beyond kNumFracBits are zeros and appended afterwards
+        std::array<char, fp::kMaxCharsExact<NumberT> + 1> buffer;
+        const int digits {std::min(precision_, kFracBits)};
+        const auto result = precision_ < 0 ? fp::ToChars(buffer.data(), buffer.data() + buffer.size(), x)
+                                           : fp::ToChars(buffer.data(), buffer.data() + buffer.size(), x, digits);
+        auto out = std::copy(buffer.data(), result.ptr, ctx.out());
+        if (precision_ > digits)
+        {
+            if (digits == 0)
+            {
+                *out++ = '.';
+            }
+            out = std::fill_n(out, precision_ - digits, '0');
+        }
+        return out;
+    }
+
+private:
+    static constexpr int kMaxPrecision {1000};
+
+    int precision_ {-1};
+};
+#endif
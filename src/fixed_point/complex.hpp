@@ -0,0 +1,284 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "profile.hpp"
+#include "simd.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+/// @brief Signed integer types of a complex product: Product holds one product of two parts,
+/// Sum the sum of two of them, i.e. up to 2 * (-2^digits)^2.
+template<FixedPoint NumberT>
+struct ComplexProductTypes
+{
+    using Wide = typename NumberT::WideValueType;
+    using Int64 = typename IntegerOfWidth<true, 64, Wide>::type;
+    using Int128 = typename IntegerOfWidth<true, 128, Int64>::type;
+    using Widest = std::conditional_t<(sizeof(Int128) > sizeof(Wide)), Int128, Wide>;
+
+    static constexpr int kDigits {std::numeric_limits<typename NumberT::ValueType>::digits};
+
+    template<int Digits>
+    using Narrowest = std::conditional_t<(std::numeric_limits<Wide>::digits >= Digits), Wide,
+                                         std::conditional_t<(std::numeric_limits<Int64>::digits >= Digits), Int64,
+                                                            std::conditional_t<(std::numeric_limits<Int128>::digits >= Digits), Int128, Widest>>>;
+
+    using Product = Narrowest<2 * kDigits + 1>;
+    using Sum = Narrowest<2 * kDigits + 2>;
+};
+
+// raw product of two parts, with 2 * kNumFracBits fractional bits
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr typename ComplexProductTypes<NumberT>::Sum PartProduct(NumberT a, NumberT b) noexcept
+{
+    using Product = typename ComplexProductTypes<NumberT>::Product;
+    return static_cast<typename ComplexProductTypes<NumberT>::Sum>(static_cast<Product>(RawBits(a)) * static_cast<Product>(RawBits(b)));
+}
+
+// sum of products rounded and narrowed once, with the policies of NumberT
+template<FixedPoint NumberT, typename T>
+[[nodiscard]] constexpr NumberT NarrowProduct(T sum) noexcept
+{
+    const auto rounded = NumberT::BoundRoundingType::RoundShift(sum, NumberT::kNumFracBits);
+    return NumberT::FromBits(NumberT::BoundOverflowType::template Narrow<typename NumberT::ValueType>(rounded));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Complex number with fixed-point real and imaginary parts.
+ *
+ * The layout is the interleaved one of std::complex and of IQ sample buffers: the real part
+ * followed by the imaginary part, with no padding, so a span of raw (re, im) pairs can be viewed
+ * as a span of Complex. Addition and subtraction use the scalar Number operators of NumberT, the
+ * product sums the exact products of the parts and rounds and narrows once per part (as
+ * fp::Fma), so it is as precise as a real multiply. For 64-bit base types the one product
+ * 128 bits can't hold, (-1, -1) * (-1, -1) with all parts at their minimum, wraps.
+ *
+ * @tparam NumberT Type of the parts, a signed specialization of fp::Number.
+ */
+template<FixedPoint NumberT>
+requires NumberT::kIsSigned
+class Complex
+{
+public:
+    using value_type = NumberT;
+
+    // constructor, zero
+    constexpr Complex() noexcept : re_{}, im_{} {}
+
+    constexpr Complex(NumberT re, NumberT im) noexcept : re_{re}, im_{im} {}
+
+    // constructor from a real number
+    constexpr explicit Complex(NumberT re) noexcept : re_{re}, im_{} {}
+
+    [[nodiscard]] constexpr NumberT Real() const noexcept
+    {
+        return re_;
+    }
+
+    [[nodiscard]] constexpr NumberT Imag() const noexcept
+    {
+        return im_;
+    }
+
+    constexpr void SetReal(NumberT re) noexcept
+    {
+        re_ = re;
+    }
+
+    constexpr void SetImag(NumberT im) noexcept
+    {
+        im_ = im;
+    }
+
+    // complex conjugate
+    [[nodiscard]] constexpr Complex Conj() const noexcept
+    {
+        return {re_, -im_};
+    }
+
+    constexpr Complex& operator+=(const Complex& other) noexcept
+    {
+        re_ += other.re_;
+        im_ += other.im_;
+        return *this;
+    }
+
+    constexpr Complex& operator-=(const Complex& other) noexcept
+    {
+        re_ -= other.re_;
+        im_ -= other.im_;
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr Complex operator+(Complex lhs, const Complex& rhs) noexcept
+    {
+        return lhs += rhs;
+    }
+
+    [[nodiscard]] friend constexpr Complex operator-(Complex lhs, const Complex& rhs) noexcept
+    {
+        return lhs -= rhs;
+    }
+
+    [[nodiscard]] friend constexpr Complex operator-(const Complex& operand) noexcept
+    {
+        return {-operand.re_, -operand.im_};
+    }
+
+    // product, four exact multiplies and one rounding per part
+    [[nodiscard]] friend constexpr Complex operator*(const Complex& lhs, const Complex& rhs) noexcept
+    {
+        return {detail::NarrowProduct<NumberT>(detail::PartProduct(lhs.re_, rhs.re_) - detail::PartProduct(lhs.im_, rhs.im_)),
+                detail::NarrowProduct<NumberT>(detail::PartProduct(lhs.re_, rhs.im_) + detail::PartProduct(lhs.im_, rhs.re_))};
+    }
+
+    constexpr Complex& operator*=(const Complex& other) noexcept
+    {
+        return *this = *this * other;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const Complex& lhs, const Complex& rhs) noexcept
+    {
+        return lhs.re_ == rhs.re_ && lhs.im_ == rhs.im_;
+    }
+
+private:
+    NumberT re_;
+    NumberT im_;
+};
+
+/**
+ * @brief Complex product with three multiplies instead of four, bit-exact with operator*.
+ *
+ * k1 = c(a + b), k2 = a(d - c), k3 = b(c + d), then re = k1 - k3 and im = k1 + k2, all exact in
+ * 64 bits. Pays off where a multiply costs more than the three extra additions (small cores
+ * without a pipelined multiplier); on x86-64 and AArch64 operator* is as fast or faster. Only for
+ * base types of up to 16 bits, wider ones would need 128-bit products for the extra bit of a + b.
+ */
+template<FixedPoint NumberT>
+requires (NumberT::kNumBits <= 16)
+[[nodiscard]] constexpr Complex<NumberT> Mul3(const Complex<NumberT>& lhs, const Complex<NumberT>& rhs) noexcept
+{
+    const std::int64_t a {detail::RawBits(lhs.Real())};
+    const std::int64_t b {detail::RawBits(lhs.Imag())};
+    const std::int64_t c {detail::RawBits(rhs.Real())};
+    const std::int64_t d {detail::RawBits(rhs.Imag())};
+    const std::int64_t k1 {c * (a + b)};
+    const std::int64_t k2 {a * (d - c)};
+    const std::int64_t k3 {b * (c + d)};
+    return {detail::NarrowProduct<NumberT>(k1 - k3), detail::NarrowProduct<NumberT>(k1 + k2)};
+}
+
+namespace simd
+{
+
+namespace detail
+{
+
+// vectorized part of the complex Mul(), returns the number of elements processed
+template<FixedPoint NumberT>
+inline std::size_t ComplexMulKernel(const Complex<NumberT>* a, const Complex<NumberT>* b, Complex<NumberT>* out, std::size_t n) noexcept
+{
+    std::size_t i {0};
+
+    if constexpr (Vectorizable16<NumberT>)
+    {
+        constexpr int kShift = NumberT::kNumFracBits;
+#if defined(__AVX2__)
+        // one (re, im) pair per 32-bit lane, pmaddwd sums the two products of each part. ar * br - ai * bi
+        // always fits 32 bits, ar * bi + ai * br = 2^31 wraps only to a result that wraps to 16 bits anyway
+        const __m256i re_mask {_mm256_set1_epi32(0xFFFF)};
+        for (; i + 8 <= n; i += 8)
+        {
+            const auto load = [](const Complex<NumberT>* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+            const __m256i va = load(a + i);
+            const __m256i vb = load(b + i);
+            const __m256i re = _mm256_sub_epi32(_mm256_madd_epi16(_mm256_and_si256(va, re_mask), vb), _mm256_madd_epi16(_mm256_andnot_si256(re_mask, va), vb));
+            const __m256i im = _mm256_madd_epi16(va, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(vb, 0xB1), 0xB1));
+            const __m256i r = _mm256_blend_epi16(_mm256_srai_epi32(re, kShift), _mm256_slli_epi32(_mm256_srai_epi32(im, kShift), 16), 0xAA);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        // vld2 splits the parts, vmull / vmlal / vmlsl form the exact 32-bit sums. vqdmull would
+        // save the final shift by one but saturates (-1) * (-1), which breaks bit-exactness with fp::Wrap
+        const int32x4_t shift {vdupq_n_s32(-kShift)};
+        const auto part = [shift](int32x4_t lo, int32x4_t hi) { return vcombine_s16(vmovn_s32(vshlq_s32(lo, shift)), vmovn_s32(vshlq_s32(hi, shift))); };
+        for (; i + 8 <= n; i += 8)
+        {
+            const int16x8x2_t va = vld2q_s16(reinterpret_cast<const std::int16_t*>(a + i));
+            const int16x8x2_t vb = vld2q_s16(reinterpret_cast<const std::int16_t*>(b + i));
+            const int32x4_t re_lo = vmlsl_s16(vmull_s16(vget_low_s16(va.val[0]), vget_low_s16(vb.val[0])), vget_low_s16(va.val[1]), vget_low_s16(vb.val[1]));
+            const int32x4_t re_hi = vmlsl_high_s16(vmull_high_s16(va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+            const int32x4_t im_lo = vmlal_s16(vmull_s16(vget_low_s16(va.val[0]), vget_low_s16(vb.val[1])), vget_low_s16(va.val[1]), vget_low_s16(vb.val[0]));
+            const int32x4_t im_hi = vmlal_high_s16(vmull_high_s16(va.val[0], vb.val[1]), va.val[1], vb.val[0]);
+            int16x8x2_t r;
+            r.val[0] = part(re_lo, re_hi);
+            r.val[1] = part(im_lo, im_hi);
+            vst2q_s16(reinterpret_cast<std::int16_t*>(out + i), r);
+        }
+#endif
+        static_cast<void>(kShift);
+    }
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(a);
+    static_cast<void>(b);
+    static_cast<void>(out);
+    static_cast<void>(n);
+    return i;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Element-wise complex multiplication of interleaved (re, im) buffers: out[i] = a[i] * b[i].
+ *
+ * Bit-exact with Complex::operator*. For fp::Wrap, fp::Truncate numbers with 16-bit base types
+ * eight products are formed at a time with pmaddwd (AVX2) or vmull / vmlal (NEON), the remaining
+ * tail and all other instantiations go through the scalar operator. Processes out.size()
+ * elements, a and b must be at least that long. out may alias a or b.
+ */
+template<FixedPoint NumberT>
+constexpr void Mul(std::span<const std::type_identity_t<Complex<NumberT>>> a, std::span<const std::type_identity_t<Complex<NumberT>>> b,
+                   std::span<Complex<NumberT>> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Mul<Complex>", out.size());
+    std::size_t i {0};
+    if constexpr (detail::WrappingTruncating<NumberT>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            i = detail::ComplexMulKernel<NumberT>(a.data(), b.data(), out.data(), out.size());
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+}  // namespace simd
+
+}  // namespace fp
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "fixed_point.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+/// @brief Unsigned integer type of the given size in bytes, void if there is none.
+template<std::size_t Bytes>
+struct UnsignedOfSize { using type = void; };
+
+template<> struct UnsignedOfSize<1> { using type = std::uint8_t; };
+template<> struct UnsignedOfSize<2> { using type = std::uint16_t; };
+template<> struct UnsignedOfSize<4> { using type = std::uint32_t; };
+template<> struct UnsignedOfSize<8> { using type = std::uint64_t; };
+#if defined(__SIZEOF_INT128__)
+template<> struct UnsignedOfSize<16> { using type = uint128; };
+#endif
+
+/// @brief Unsigned integer type twice as wide as T, void if there is none.
+template<typename T>
+using DoubleWidthType = typename UnsignedOfSize<2 * sizeof(T)>::type;
+
+/// @brief Concept: products of two T's can be computed exactly in DoubleWidthType<T>
+template<typename T>
+concept HasDoubleWidth = !std::is_void_v<DoubleWidthType<T>>;
+
+// high half of the full product a * b
+template<typename UnsignedType>
+[[nodiscard]] constexpr UnsignedType MulHi(UnsignedType a, UnsignedType b) noexcept
+{
+    using Double = DoubleWidthType<UnsignedType>;
+    return static_cast<UnsignedType>((static_cast<Double>(a) * static_cast<Double>(b)) >> std::numeric_limits<UnsignedType>::digits);
+}
+
+// magnitude of a signed value as an unsigned one, well defined for the minimum value
+template<typename UnsignedType, typename T>
+[[nodiscard]] constexpr UnsignedType Magnitude(T value) noexcept
+{
+    if constexpr (std::numeric_limits<T>::is_signed)
+    {
+        return value < 0 ? static_cast<UnsignedType>(UnsignedType{0} - static_cast<UnsignedType>(value)) : static_cast<UnsignedType>(value);
+    }
+    else
+    {
+        return static_cast<UnsignedType>(value);
+    }
+}
+
+// Newton-Raphson iterations needed to reach the full precision of NumberT from the 1/17 initial error
+template<FixedPoint NumberT>
+inline constexpr std::size_t kFullPrecisionIterations {NumberT::kNumBits <= 8 ? 1 : NumberT::kNumBits <= 16 ? 2 : NumberT::kNumBits <= 32 ? 3 : 4};
+
+}  // namespace detail
+
+/**
+ * @brief Precomputed division by an invariant divisor.
+ *
+ * Replaces the wide integer divide of Number::operator/ with a multiply-high by a magic
+ * reciprocal, a shift and (for some divisors) one add, the round-up method used by libdivide.
+ * Powers of two reduce to a single shift. The result is bit-exact with `dividend / divisor` for
+ * every dividend, overflow and rounding policies included, so a Divider can replace operator/
+ * anywhere the divisor is reused.
+ *
+ * Needs an unsigned type twice as wide as WideType for the magic multiply (e.g. unsigned __int128
+ * for a 64-bit WideType) and falls back to operator/ when there is none.
+ * The divisor must not be zero.
+ *
+ * @tparam NumberT The fixed point number type.
+ */
+template<FixedPoint NumberT>
+class Divider
+{
+public:
+    // constructor, precomputes the reciprocal of divisor
+    constexpr explicit Divider(NumberT divisor) noexcept : divisor_{divisor}
+    {
+        const auto raw = static_cast<WideType>(detail::RawBits(divisor));
+        if constexpr (NumberT::kIsSigned)
+        {
+            negative_ = raw < 0;
+        }
+
+        if constexpr (kHasMagic)
+        {
+            const auto d = detail::Magnitude<UnsignedType>(raw);
+            shift_ = static_cast<unsigned int>(std::bit_width(d) - 1);
+            if (std::has_single_bit(d))
+            {
+                // powers of two are a plain shift, flagged by a zero magic number
+                magic_ = 0;
+                return;
+            }
+
+            // floor(2^(N + shift) / d) always fits in N bits since d > 2^shift
+            using Double = detail::DoubleWidthType<UnsignedType>;
+            const Double numerator = static_cast<Double>(1) << (kDigits + shift_);
+            auto proposed = static_cast<UnsignedType>(numerator / d);
+            const auto remainder = static_cast<UnsignedType>(numerator % d);
+
+            if (d - remainder < (static_cast<UnsignedType>(1) << shift_))
+            {
+                add_ = false;
+            }
+            else
+            {
+                // the magic number needs N + 1 bits, its top bit is folded into an extra add
+                proposed = static_cast<UnsignedType>(proposed + proposed);
+                const auto twice_remainder = static_cast<UnsignedType>(remainder + remainder);
+                if (twice_remainder >= d || twice_remainder < remainder)
+                {
+                    ++proposed;
+                }
+                add_ = true;
+            }
+            magic_ = static_cast<UnsignedType>(proposed + 1);
+        }
+    }
+
+    // getter for the divisor
+    [[nodiscard]] constexpr NumberT Divisor() const noexcept
+    {
+        return divisor_;
+    }
+
+    // division, same result as dividend / Divisor()
+    [[nodiscard]] constexpr NumberT Divide(const NumberT& dividend) const noexcept
+    {
+        if constexpr (!kHasMagic)
+        {
+            return dividend / divisor_;
+        }
+        else
+        {
+            const auto n = static_cast<WideType>(static_cast<WideType>(detail::RawBits(dividend)) << NumberT::kNumFracBits);
+            const auto magnitude = detail::Magnitude<UnsignedType>(n);
+
+            UnsignedType quotient;
+            if (magic_ == 0)
+            {
+                quotient = static_cast<UnsignedType>(magnitude >> shift_);
+            }
+            else
+            {
+                const UnsignedType high = detail::MulHi(magic_, magnitude);
+                quotient = add_ ? static_cast<UnsignedType>((static_cast<UnsignedType>((magnitude - high) >> 1) + high) >> shift_)
+                                : static_cast<UnsignedType>(high >> shift_);
+            }
+
+            // truncation towards zero, the sign is applied to the magnitude as for integer division
+            // the remainder is only needed by rounding policies, it is dead code for fp::Truncate
+            const auto divisor = static_cast<WideType>(detail::RawBits(divisor_));
+            auto result = static_cast<WideType>(quotient);
+            auto remainder = static_cast<WideType>(magnitude - quotient * detail::Magnitude<UnsignedType>(divisor));
+            if constexpr (NumberT::kIsSigned)
+            {
+                result = (n < 0) != negative_ ? -result : result;
+                remainder = n < 0 ? -remainder : remainder;
+            }
+            const auto rounded = NumberT::BoundRoundingType::RoundQuotient(result, remainder, divisor);
+            return NumberT::FromBits(NumberT::BoundOverflowType::template Narrow<typename NumberT::ValueType>(rounded));
+        }
+    }
+
+    // division operator
+    [[nodiscard]] friend constexpr NumberT operator/(const NumberT& dividend, const Divider& divider) noexcept
+    {
+        return divider.Divide(dividend);
+    }
+
+private:
+    using WideType = typename NumberT::WideValueType;
+    using UnsignedType = detail::MakeUnsignedT<WideType>;
+
+    static constexpr bool kHasMagic {detail::HasDoubleWidth<UnsignedType>};
+    static constexpr unsigned int kDigits {std::numeric_limits<UnsignedType>::digits};
+
+    NumberT divisor_;
+    UnsignedType magic_ {0};
+    unsigned int shift_ {0};
+    bool add_ {false};
+    bool negative_ {false};
+};
+
+/**
+ * @brief Approximate reciprocal 1 / x by Newton-Raphson iteration.
+ *
+ * The magnitude of x is normalized to [0.5, 1), seeded with the linear estimate
+ * 48/17 - 32/17 * m and refined with y' = y * (2 - m * y) in WideType precision (the products
+ * use the double width type), then shifted back. No divide instruction is used.
+ *
+ * The relative error of the seed is at most 1/17 and squares with every iteration, so it stays
+ * below 2^-8 after 1 iteration, 2^-16 after 2, 2^-32 after 3 and 2^-64 after 4. The iteration
+ * converges from below and the final shift truncates, a last multiply and compare adds back the
+ * ULP that truncation may lose. So the result never exceeds the exact PosOne() / x, and with the
+ * default (full precision) iteration count it is equal to it.
+ * Worst case error against PosOne() / x in ULP, for S32_16 over all positive inputs with a
+ * representable reciprocal:
+ *
+ * | Iterations | 1       | 2     | 3 (default) | 4 |
+ * |------------|---------|-------|-------------|---|
+ * | max ULP    | 4953825 | 17140 | 0           | 0 |
+ *
+ * The error in ULP grows with the magnitude of the result, it is largest for the smallest x.
+ * x must not be zero and 1 / x must be representable.
+ *
+ * @tparam Iterations Number of Newton-Raphson steps, selects the precision. 0 (the default) picks
+ *                   the count that reaches the full precision of NumberT.
+ */
+template<std::size_t Iterations = 0, FixedPoint NumberT>
+requires detail::HasDoubleWidth<detail::MakeUnsignedT<typename NumberT::WideValueType>>
+[[nodiscard]] constexpr NumberT Reciprocal(const NumberT& x) noexcept
+{
+    using UnsignedType = detail::MakeUnsignedT<typename NumberT::WideValueType>;
+    using Double = detail::DoubleWidthType<UnsignedType>;
+
+    // working precision is Q2.kPrecision
+    constexpr int kDigits {std::numeric_limits<UnsignedType>::digits};
+    constexpr int kPrecision {kDigits - 2};
+    constexpr std::size_t kIterations {Iterations == 0 ? detail::kFullPrecisionIterations<NumberT> : Iterations};
+    constexpr auto kTwo = static_cast<UnsignedType>(static_cast<UnsignedType>(2) << kPrecision);
+    constexpr auto k48Over17 = static_cast<UnsignedType>((static_cast<Double>(48) << kPrecision) / 17);
+    constexpr auto k32Over17 = static_cast<UnsignedType>((static_cast<Double>(32) << kPrecision) / 17);
+
+    const auto mul = [](UnsignedType a, UnsignedType b) {
+        return static_cast<UnsignedType>((static_cast<Double>(a) * static_cast<Double>(b)) >> kPrecision);
+    };
+
+    const auto raw = detail::RawBits(x);
+    const auto magnitude = detail::Magnitude<UnsignedType>(raw);
+
+    // normalize: m = magnitude / 2^bits, in [0.5, 1)
+    const int bits = static_cast<int>(std::bit_width(magnitude));
+    const auto m = static_cast<UnsignedType>(magnitude << (kPrecision - bits));
+
+    auto y = static_cast<UnsignedType>(k48Over17 - mul(k32Over17, m));
+    for (std::size_t i = 0; i < kIterations; ++i)
+    {
+        y = mul(y, static_cast<UnsignedType>(kTwo - mul(m, y)));
+    }
+
+    // 1 / x = y * 2^(kNumFracBits - bits), so the raw result is y * 2^(2 * kNumFracBits - bits)
+    const int shift = kPrecision + bits - 2 * static_cast<int>(NumberT::kNumFracBits);
+    UnsignedType result;
+    if (shift >= kDigits)
+    {
+        result = 0;
+    }
+    else if (shift >= 0)
+    {
+        result = static_cast<UnsignedType>(y >> shift);
+    }
+    else
+    {
+        result = static_cast<UnsignedType>(y << -shift);
+    }
+
+    // the estimate is never above the exact quotient, one multiply tells whether it is 1 ULP below
+    const auto exact_one = static_cast<Double>(1) << (2 * NumberT::kNumFracBits);
+    if (static_cast<Double>(magnitude) * (static_cast<Double>(result) + 1) <= exact_one)
+    {
+        ++result;
+    }
+
+    if constexpr (NumberT::kIsSigned)
+    {
+        if (raw < 0)
+        {
+            result = static_cast<UnsignedType>(UnsignedType{0} - result);
+        }
+    }
+    return NumberT::FromBits(static_cast<typename NumberT::ValueType>(result));
+}
+
+}  // namespace fp
@@ -0,0 +1,839 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "fixed_point.hpp"
+#include "complex.hpp"
+#include "math.hpp"
+#include "profile.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+/// @brief Concept: signed NumberT whose WideType holds the sum of two full products, as the butterflies need
+template<typename NumberT>
+concept FFTCompatible = FixedPoint<NumberT> && NumberT::kIsSigned &&
+                        (std::numeric_limits<typename NumberT::WideValueType>::digits > 2 * std::numeric_limits<typename NumberT::ValueType>::digits);
+
+/// @brief Fractional bits of the twiddle factors, stored in the base type: Q15 for 16-bit base types, Q31 for 32-bit ones.
+template<FixedPoint NumberT>
+inline constexpr int kTwiddleBits {std::numeric_limits<typename NumberT::ValueType>::digits};
+
+/// @brief Bits kept below the LSB of the data between the twiddle products and the rounding of a butterfly.
+template<FixedPoint NumberT>
+inline constexpr int kFFTGuardBits {std::numeric_limits<typename NumberT::ValueType>::digits / 2};
+
+// radix-4 stages of a transform of size N, a radix-2 stage follows them when log2(N) is odd
+template<std::size_t N>
+inline constexpr std::size_t kRadix4Stages {static_cast<std::size_t>(std::countr_zero(N)) / 2};
+
+template<std::size_t N>
+inline constexpr bool kHasRadix2Stage {std::countr_zero(N) % 2 != 0};
+
+// 12 * q values per radix-4 stage of quarter size q, 2 * N for the radix-2 stage (see MakeTwiddles())
+template<std::size_t N>
+inline constexpr std::size_t kTwiddleTableSize {4 * ((std::size_t{1} << (2 * kRadix4Stages<N>)) - 1) + (kHasRadix2Stage<N> ? 2 * N : 0)};
+
+struct SinCos
+{
+    double cos;
+    double sin;
+};
+
+// cos and sin of 2 pi j / m, through the first quadrant where ConstSin() is accurate
+constexpr SinCos ConstSinCos(std::size_t j, std::size_t m) noexcept
+{
+    const std::size_t t {4 * (j % m)};
+    const std::size_t quadrant {t / m};
+    const double x {kPi / 2 * static_cast<double>(t - quadrant * m) / static_cast<double>(m)};
+    const double s {ConstSin(x)};
+    const double c {ConstSin(kPi / 2 - x)};
+    switch (quadrant)
+    {
+    case 0:
+        return {c, s};
+    case 1:
+        return {-s, c};
+    case 2:
+        return {-c, -s};
+    default:
+        return {s, -c};
+    }
+}
+
+// v in [-1, 1] with kTwiddleBits fractional bits, clamped to +-(2^kTwiddleBits - 1) so that negations stay representable
+template<FixedPoint NumberT>
+constexpr typename NumberT::ValueType ToTwiddle(double v) noexcept
+{
+    using ValueType = typename NumberT::ValueType;
+    constexpr ValueType kMax {std::numeric_limits<ValueType>::max()};
+    constexpr double kLimit {static_cast<double>(kMax)};
+    const double scaled {v * kLimit};
+    if (scaled >= kLimit)
+    {
+        return kMax;
+    }
+    if (scaled <= -kLimit)
+    {
+        return static_cast<ValueType>(-kMax);
+    }
+    return static_cast<ValueType>(scaled + (scaled >= 0.0 ? 0.5 : -0.5));
+}
+
+// pairs (re(w^k), -im(w^k)) for k < count, then pairs (im(w^k), re(w^k)), w = exp(-+2 pi i step / m), at table[offset]
+template<FixedPoint NumberT, bool Inverse, std::size_t Size>
+constexpr void FillTwiddles(std::array<typename NumberT::ValueType, Size>& table, std::size_t offset, std::size_t count, std::size_t step,
+                            std::size_t m) noexcept
+{
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        const SinCos w {ConstSinCos(step * k, m)};
+        const double s {Inverse ? -w.sin : w.sin};
+        table[offset + 2 * k] = ToTwiddle<NumberT>(w.cos);
+        table[offset + 2 * k + 1] = ToTwiddle<NumberT>(s);
+        table[offset + 2 * count + 2 * k] = ToTwiddle<NumberT>(-s);
+        table[offset + 2 * count + 2 * k + 1] = ToTwiddle<NumberT>(w.cos);
+    }
+}
+
+/**
+ * @brief Twiddle factors of all stages.
+ *
+ * The radix-4 stage of quarter size q uses w^(r * k) for r in 1..3 and k < q, w = exp(-+2 pi i / 4q),
+ * the radix-2 stage w^k for k < N / 2, w = exp(-+2 pi i / N). For each r the table holds the pairs
+ * (re(w), -im(w)) for all k, then the pairs (im(w), re(w)), so that the real and imaginary parts of
+ * x * w are the dot products of (re(x), im(x)) with a pair (one pmaddwd for 16-bit base types).
+ * The entries of k = 0 are not used, multiplications by 1 are exact.
+ */
+template<FixedPoint NumberT, std::size_t N, bool Inverse>
+constexpr std::array<typename NumberT::ValueType, kTwiddleTableSize<N>> MakeTwiddles() noexcept
+{
+    std::array<typename NumberT::ValueType, kTwiddleTableSize<N>> table {};
+    std::size_t offset {0};
+    std::size_t q {1};
+    for (std::size_t stage = 0; stage < kRadix4Stages<N>; ++stage, q *= 4)
+    {
+        for (std::size_t r = 1; r <= 3; ++r)
+        {
+            FillTwiddles<NumberT, Inverse>(table, offset + (r - 1) * 4 * q, q, r, 4 * q);
+        }
+        offset += 12 * q;
+    }
+    if constexpr (kHasRadix2Stage<N>)
+    {
+        FillTwiddles<NumberT, Inverse>(table, offset, N / 2, 1, N);
+    }
+    return table;
+}
+
+// bits of every byte in reverse order
+inline constexpr auto kReversedBytes {[] {
+    std::array<std::uint8_t, 256> table {};
+    for (unsigned int i = 0; i < 256; ++i)
+    {
+        unsigned int reversed {0};
+        for (unsigned int bit = 0; bit < 8; ++bit)
+        {
+            reversed |= ((i >> bit) & 1U) << (7 - bit);
+        }
+        table[i] = static_cast<std::uint8_t>(reversed);
+    }
+    return table;
+}()};
+
+// the `bits` low bits of i in reverse order
+[[nodiscard]] constexpr std::uint32_t ReverseBits(std::uint32_t i, int bits) noexcept
+{
+    const std::uint32_t reversed {(std::uint32_t{kReversedBytes[i & 0xFF]} << 24) | (std::uint32_t{kReversedBytes[(i >> 8) & 0xFF]} << 16) |
+                                  (std::uint32_t{kReversedBytes[(i >> 16) & 0xFF]} << 8) | std::uint32_t{kReversedBytes[i >> 24]}};
+    return reversed >> (32 - bits);
+}
+
+/// @brief Integer the magnitude bounds of the block scaling are computed in.
+template<FixedPoint NumberT>
+using FFTBoundType = std::conditional_t<(NumberT::kNumBits <= 32), std::uint64_t, typename NumberT::WideValueType>;
+
+// |value| as a bound
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr FFTBoundType<NumberT> Magnitude(typename NumberT::WideValueType value) noexcept
+{
+    return static_cast<FFTBoundType<NumberT>>(value < 0 ? -value : value);
+}
+
+// largest |re| or |im| of the raw values
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr FFTBoundType<NumberT> MaxMagnitude(std::span<const Complex<NumberT>> data) noexcept
+{
+    using Wide = typename NumberT::WideValueType;
+    FFTBoundType<NumberT> max {0};
+    for (const auto& x : data)
+    {
+        max = std::max(max, Magnitude<NumberT>(static_cast<Wide>(RawBits(x.Real()))));
+        max = std::max(max, Magnitude<NumberT>(static_cast<Wide>(RawBits(x.Imag()))));
+    }
+    return max;
+}
+
+/**
+ * @brief Right shift that keeps the outputs of a stage in range, from the largest input component.
+ *
+ * A radix-2 output component is at most (1 + sqrt(2)) * max, a radix-4 one at most
+ * (1 + 3 * sqrt(2)) * max: a rotation by a twiddle grows a component by up to sqrt(2). A few LSBs
+ * cover the roundings.
+ */
+template<FixedPoint NumberT, bool Radix4>
+[[nodiscard]] constexpr int StageShift(FFTBoundType<NumberT> max) noexcept
+{
+    using Bound = FFTBoundType<NumberT>;
+    constexpr Bound kLimit {static_cast<Bound>(std::numeric_limits<typename NumberT::ValueType>::max())};
+    // 46341 / 2^15 > sqrt(2)
+    const Bound rotated {static_cast<Bound>((max * 46341 >> 15) + 1)};
+    const Bound bound {static_cast<Bound>(max + (Radix4 ? 3 : 1) * rotated + 3)};
+    int shift {0};
+    while (bound > static_cast<Bound>(kLimit << shift))
+    {
+        ++shift;
+    }
+    return shift;
+}
+
+/**
+ * @brief value rounded to nearest after a right shift by `shift`, which is at least 1, ties to even.
+ *
+ * Exact inputs and products by 1 make ties common, rounding them all up would bias the DC bin.
+ */
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr typename NumberT::WideValueType RoundOutput(typename NumberT::WideValueType value, int shift) noexcept
+{
+    using Wide = typename NumberT::WideValueType;
+    const Wide odd {static_cast<Wide>((value >> shift) & 1)};
+    return static_cast<Wide>((value + (Wide{1} << (shift - 1)) - 1 + odd) >> shift);
+}
+
+// stores the rounded parts and keeps track of the largest one
+template<FixedPoint NumberT>
+constexpr void StoreOutput(Complex<NumberT>& out, typename NumberT::WideValueType re, typename NumberT::WideValueType im, int shift,
+                           FFTBoundType<NumberT>& max) noexcept
+{
+    using ValueType = typename NumberT::ValueType;
+    const auto rounded_re = RoundOutput<NumberT>(re, shift);
+    const auto rounded_im = RoundOutput<NumberT>(im, shift);
+    max = std::max(max, std::max(Magnitude<NumberT>(rounded_re), Magnitude<NumberT>(rounded_im)));
+    out = {NumberT::FromBits(static_cast<ValueType>(rounded_re)), NumberT::FromBits(static_cast<ValueType>(rounded_im))};
+}
+
+// real and imaginary parts in the working format of the butterflies, kFFTGuardBits below the LSB
+template<FixedPoint NumberT>
+struct WidePair
+{
+    typename NumberT::WideValueType re;
+    typename NumberT::WideValueType im;
+};
+
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr WidePair<NumberT> ToWide(const Complex<NumberT>& x) noexcept
+{
+    using Wide = typename NumberT::WideValueType;
+    return {static_cast<Wide>(static_cast<Wide>(RawBits(x.Real())) << kFFTGuardBits<NumberT>),
+            static_cast<Wide>(static_cast<Wide>(RawBits(x.Imag())) << kFFTGuardBits<NumberT>)};
+}
+
+// x * w in the working format, w given as its two pairs of the twiddle table
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr WidePair<NumberT> TwiddleProduct(const Complex<NumberT>& x, const typename NumberT::ValueType* re_form,
+                                                         const typename NumberT::ValueType* im_form) noexcept
+{
+    using Wide = typename NumberT::WideValueType;
+    constexpr int kShift {kTwiddleBits<NumberT> - kFFTGuardBits<NumberT>};
+    constexpr Wide kHalf {Wide{1} << (kShift - 1)};
+    const Wide xr {static_cast<Wide>(RawBits(x.Real()))};
+    const Wide xi {static_cast<Wide>(RawBits(x.Imag()))};
+    const Wide re {static_cast<Wide>(xr * re_form[0] + xi * re_form[1])};
+    const Wide im {static_cast<Wide>(xr * im_form[0] + xi * im_form[1])};
+    return {static_cast<Wide>((re + kHalf) >> kShift), static_cast<Wide>((im + kHalf) >> kShift)};
+}
+
+/**
+ * @brief One radix-4 decimation-in-time butterfly: x[0], x[q], x[2q], x[3q] combined in place.
+ *
+ * In bit-reversed order the quarters hold the DFTs of the residues 0, 2, 1 and 3 modulo 4 of a
+ * DFT of size 4q.
+ */
+template<FixedPoint NumberT, bool Inverse>
+constexpr void Radix4Butterfly(Complex<NumberT>* x, std::size_t q, std::size_t k, const typename NumberT::ValueType* twiddles, int shift,
+                               FFTBoundType<NumberT>& max) noexcept
+{
+    using Wide = typename NumberT::WideValueType;
+    const WidePair<NumberT> a {ToWide(x[0])};
+    const WidePair<NumberT> b {k == 0 ? ToWide(x[2 * q]) : TwiddleProduct(x[2 * q], twiddles + 2 * k, twiddles + 2 * q + 2 * k)};
+    const WidePair<NumberT> c {k == 0 ? ToWide(x[q]) : TwiddleProduct(x[q], twiddles + 4 * q + 2 * k, twiddles + 6 * q + 2 * k)};
+    const WidePair<NumberT> d {k == 0 ? ToWide(x[3 * q]) : TwiddleProduct(x[3 * q], twiddles + 8 * q + 2 * k, twiddles + 10 * q + 2 * k)};
+
+    const Wide sum_ac_r {static_cast<Wide>(a.re + c.re)}, sum_ac_i {static_cast<Wide>(a.im + c.im)};
+    const Wide diff_ac_r {static_cast<Wide>(a.re - c.re)}, diff_ac_i {static_cast<Wide>(a.im - c.im)};
+    const Wide sum_bd_r {static_cast<Wide>(b.re + d.re)}, sum_bd_i {static_cast<Wide>(b.im + d.im)};
+    const Wide diff_bd_r {static_cast<Wide>(b.re - d.re)}, diff_bd_i {static_cast<Wide>(b.im - d.im)};
+    // (b - d) times -i (forward) or i (inverse)
+    const Wide rot_r {static_cast<Wide>(Inverse ? -diff_bd_i : diff_bd_i)};
+    const Wide rot_i {static_cast<Wide>(Inverse ? diff_bd_r : -diff_bd_r)};
+
+    const int s {kFFTGuardBits<NumberT> + shift};
+    StoreOutput(x[0], static_cast<Wide>(sum_ac_r + sum_bd_r), static_cast<Wide>(sum_ac_i + sum_bd_i), s, max);
+    StoreOutput(x[q], static_cast<Wide>(diff_ac_r + rot_r), static_cast<Wide>(diff_ac_i + rot_i), s, max);
+    StoreOutput(x[2 * q], static_cast<Wide>(sum_ac_r - sum_bd_r), static_cast<Wide>(sum_ac_i - sum_bd_i), s, max);
+    StoreOutput(x[3 * q], static_cast<Wide>(diff_ac_r - rot_r), static_cast<Wide>(diff_ac_i - rot_i), s, max);
+}
+
+// radix-4 stage of quarter size q over the whole data, returns the largest output component
+template<FixedPoint NumberT, bool Inverse>
+constexpr FFTBoundType<NumberT> Radix4Stage(std::span<Complex<NumberT>> data, std::size_t q, const typename NumberT::ValueType* twiddles,
+                                            int shift) noexcept
+{
+    FFTBoundType<NumberT> max {0};
+    for (std::size_t g = 0; g < data.size(); g += 4 * q)
+    {
+        for (std::size_t k = 0; k < q; ++k)
+        {
+            Radix4Butterfly<NumberT, Inverse>(data.data() + g + k, q, k, twiddles, shift, max);
+        }
+    }
+    return max;
+}
+
+// radix-2 stage combining the two halves of the data
+template<FixedPoint NumberT>
+constexpr void Radix2Stage(std::span<Complex<NumberT>> data, const typename NumberT::ValueType* twiddles, int shift) noexcept
+{
+    using Wide = typename NumberT::WideValueType;
+    const std::size_t half {data.size() / 2};
+    const int s {kFFTGuardBits<NumberT> + shift};
+    FFTBoundType<NumberT> max {0};
+    for (std::size_t k = 0; k < half; ++k)
+    {
+        const WidePair<NumberT> a {ToWide(data[k])};
+        const WidePair<NumberT> b {k == 0 ? ToWide(data[half]) : TwiddleProduct(data[k + half], twiddles + 2 * k, twiddles + 2 * half + 2 * k)};
+        StoreOutput(data[k], static_cast<Wide>(a.re + b.re), static_cast<Wide>(a.im + b.im), s, max);
+        StoreOutput(data[k + half], static_cast<Wide>(a.re - b.re), static_cast<Wide>(a.im - b.im), s, max);
+    }
+}
+
+#if defined(__AVX2__)
+// arithmetic right shift of 64-bit lanes, AVX2 only has the logical one
+inline __m256i ShiftRightArithmetic64(__m256i v, int shift) noexcept
+{
+#if defined(__AVX512VL__)
+    return _mm256_sra_epi64(v, _mm_cvtsi32_si128(shift));
+#else
+    const __m256i sign {_mm256_cmpgt_epi64(_mm256_setzero_si256(), v)};
+    return _mm256_or_si256(_mm256_srl_epi64(v, _mm_cvtsi32_si128(shift)), _mm256_sll_epi64(sign, _mm_cvtsi32_si128(64 - shift)));
+#endif
+}
+
+/**
+ * @brief AVX2 operations on 8 interleaved complex values of a 16-bit base type.
+ *
+ * The working format holds the real and imaginary parts in two vectors of 8 32-bit lanes.
+ */
+template<FixedPoint NumberT>
+struct FFTLanes16
+{
+    using Raw = std::int16_t;
+    static constexpr std::size_t kCount {8};
+    // blend masks of the 32-bit lanes of k = 0, in a vector of one group and in a vector of two
+    static constexpr int kFirstLane {0x01};
+    static constexpr int kFirstLanes {0x11};
+
+    static __m256i Add(__m256i a, __m256i b) noexcept
+    {
+        return _mm256_add_epi32(a, b);
+    }
+
+    static __m256i Sub(__m256i a, __m256i b) noexcept
+    {
+        return _mm256_sub_epi32(a, b);
+    }
+
+    static void ToWide(__m256i x, __m256i& re, __m256i& im) noexcept
+    {
+        re = _mm256_slli_epi32(_mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16), kFFTGuardBits<NumberT>);
+        im = _mm256_slli_epi32(_mm256_srai_epi32(x, 16), kFFTGuardBits<NumberT>);
+    }
+
+    static void Product(__m256i x, __m256i re_form, __m256i im_form, __m256i& re, __m256i& im) noexcept
+    {
+        constexpr int kShift {kTwiddleBits<NumberT> - kFFTGuardBits<NumberT>};
+        const __m256i half {_mm256_set1_epi32(1 << (kShift - 1))};
+        re = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(x, re_form), half), kShift);
+        im = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(x, im_form), half), kShift);
+    }
+
+    // parts rounded as RoundOutput() does, back into interleaved values
+    static __m256i Pack(__m256i re, __m256i im, int shift) noexcept
+    {
+        const __m256i half {_mm256_set1_epi32((1 << (shift - 1)) - 1)};
+        const __m256i one {_mm256_set1_epi32(1)};
+        const __m128i count {_mm_cvtsi32_si128(shift)};
+        const auto round = [&](__m256i v) {
+            const __m256i odd {_mm256_and_si256(_mm256_srl_epi32(v, count), one)};
+            return _mm256_sra_epi32(_mm256_add_epi32(_mm256_add_epi32(v, half), odd), count);
+        };
+        return _mm256_blend_epi16(round(re), _mm256_slli_epi32(round(im), 16), 0xAA);
+    }
+
+    // |-32768| reads as 32768 unsigned
+    static __m256i Max(__m256i max, __m256i x) noexcept
+    {
+        return _mm256_max_epu16(max, _mm256_abs_epi16(x));
+    }
+
+    static std::uint64_t ReduceMax(__m256i max) noexcept
+    {
+        __m128i m {_mm_max_epu16(_mm256_castsi256_si128(max), _mm256_extracti128_si256(max, 1))};
+        m = _mm_max_epu16(m, _mm_srli_si128(m, 8));
+        m = _mm_max_epu16(m, _mm_srli_si128(m, 4));
+        m = _mm_max_epu16(m, _mm_srli_si128(m, 2));
+        return static_cast<std::uint64_t>(_mm_extract_epi16(m, 0));
+    }
+
+    // 4 x 4 transpose of the values in each 128-bit half: v[r] gets value r of the 4 groups of the halves
+    static void Transpose(__m256i (&v)[4]) noexcept
+    {
+        const __m256i t0 {_mm256_unpacklo_epi32(v[0], v[1])}, t1 {_mm256_unpackhi_epi32(v[0], v[1])};
+        const __m256i t2 {_mm256_unpacklo_epi32(v[2], v[3])}, t3 {_mm256_unpackhi_epi32(v[2], v[3])};
+        v[0] = _mm256_unpacklo_epi64(t0, t2);
+        v[1] = _mm256_unpackhi_epi64(t0, t2);
+        v[2] = _mm256_unpacklo_epi64(t1, t3);
+        v[3] = _mm256_unpackhi_epi64(t1, t3);
+    }
+};
+
+/**
+ * @brief AVX2 operations on 4 interleaved complex values of a 32-bit base type.
+ *
+ * The working format holds the real and imaginary parts in two vectors of 4 64-bit lanes. The
+ * parts of a value are the halves of a 64-bit lane, which pmuldq multiplies directly.
+ */
+template<FixedPoint NumberT>
+struct FFTLanes32
+{
+    using Raw = std::int32_t;
+    static constexpr std::size_t kCount {4};
+    static constexpr int kFirstLane {0x03};
+    static constexpr int kFirstLanes {0x33};
+
+    static __m256i Add(__m256i a, __m256i b) noexcept
+    {
+        return _mm256_add_epi64(a, b);
+    }
+
+    static __m256i Sub(__m256i a, __m256i b) noexcept
+    {
+        return _mm256_sub_epi64(a, b);
+    }
+
+    // sign extended, and shifted by kFFTGuardBits with a multiply
+    static void ToWide(__m256i x, __m256i& re, __m256i& im) noexcept
+    {
+        const __m256i guard {_mm256_set1_epi64x(std::int64_t{1} << kFFTGuardBits<NumberT>)};
+        re = _mm256_mul_epi32(x, guard);
+        im = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), guard);
+    }
+
+    static void Product(__m256i x, __m256i re_form, __m256i im_form, __m256i& re, __m256i& im) noexcept
+    {
+        constexpr int kShift {kTwiddleBits<NumberT> - kFFTGuardBits<NumberT>};
+        const __m256i half {_mm256_set1_epi64x(std::int64_t{1} << (kShift - 1))};
+        const __m256i x_im {_mm256_srli_epi64(x, 32)};
+        re = _mm256_add_epi64(_mm256_mul_epi32(x, re_form), _mm256_mul_epi32(x_im, _mm256_srli_epi64(re_form, 32)));
+        im = _mm256_add_epi64(_mm256_mul_epi32(x, im_form), _mm256_mul_epi32(x_im, _mm256_srli_epi64(im_form, 32)));
+        re = ShiftRightArithmetic64(_mm256_add_epi64(re, half), kShift);
+        im = ShiftRightArithmetic64(_mm256_add_epi64(im, half), kShift);
+    }
+
+    static __m256i Pack(__m256i re, __m256i im, int shift) noexcept
+    {
+        const __m256i half {_mm256_set1_epi64x((std::int64_t{1} << (shift - 1)) - 1)};
+        const __m256i one {_mm256_set1_epi64x(1)};
+        const __m128i count {_mm_cvtsi32_si128(shift)};
+        const auto round = [&](__m256i v) {
+            const __m256i odd {_mm256_and_si256(_mm256_srl_epi64(v, count), one)};
+            return ShiftRightArithmetic64(_mm256_add_epi64(_mm256_add_epi64(v, half), odd), shift);
+        };
+        return _mm256_blend_epi32(round(re), _mm256_slli_epi64(round(im), 32), 0xAA);
+    }
+
+    // |INT32_MIN| reads as 2^31 unsigned
+    static __m256i Max(__m256i max, __m256i x) noexcept
+    {
+        return _mm256_max_epu32(max, _mm256_abs_epi32(x));
+    }
+
+    static std::uint64_t ReduceMax(__m256i max) noexcept
+    {
+        __m128i m {_mm_max_epu32(_mm256_castsi256_si128(max), _mm256_extracti128_si256(max, 1))};
+        m = _mm_max_epu32(m, _mm_srli_si128(m, 8));
+        m = _mm_max_epu32(m, _mm_srli_si128(m, 4));
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_cvtsi128_si32(m)));
+    }
+
+    // 4 x 4 transpose of the values: v[r] gets value r of the 4 groups
+    static void Transpose(__m256i (&v)[4]) noexcept
+    {
+        const __m256i t0 {_mm256_unpacklo_epi64(v[0], v[1])}, t1 {_mm256_unpackhi_epi64(v[0], v[1])};
+        const __m256i t2 {_mm256_unpacklo_epi64(v[2], v[3])}, t3 {_mm256_unpackhi_epi64(v[2], v[3])};
+        v[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+        v[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+        v[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+        v[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+    }
+};
+
+template<typename Raw>
+inline __m256i LoadLanes(const Raw* p) noexcept
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+template<typename Raw>
+inline void StoreLanes(Raw* p, __m256i v) noexcept
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+// Radix4Butterfly() on vectors of the parts of the 4 quarters, y gets the interleaved outputs
+template<typename Lanes, FixedPoint NumberT, bool Inverse>
+inline void Radix4ButterflyVector(__m256i ar, __m256i ai, __m256i br, __m256i bi, __m256i cr, __m256i ci, __m256i dr, __m256i di, int shift,
+                                  __m256i (&y)[4]) noexcept
+{
+    const __m256i sum_ac_r {Lanes::Add(ar, cr)}, sum_ac_i {Lanes::Add(ai, ci)};
+    const __m256i diff_ac_r {Lanes::Sub(ar, cr)}, diff_ac_i {Lanes::Sub(ai, ci)};
+    const __m256i sum_bd_r {Lanes::Add(br, dr)}, sum_bd_i {Lanes::Add(bi, di)};
+    const __m256i diff_bd_r {Lanes::Sub(br, dr)}, diff_bd_i {Lanes::Sub(bi, di)};
+    const __m256i zero {_mm256_setzero_si256()};
+    const __m256i rot_r {Inverse ? Lanes::Sub(zero, diff_bd_i) : diff_bd_i};
+    const __m256i rot_i {Inverse ? diff_bd_r : Lanes::Sub(zero, diff_bd_r)};
+
+    const int s {kFFTGuardBits<NumberT> + shift};
+    y[0] = Lanes::Pack(Lanes::Add(sum_ac_r, sum_bd_r), Lanes::Add(sum_ac_i, sum_bd_i), s);
+    y[1] = Lanes::Pack(Lanes::Add(diff_ac_r, rot_r), Lanes::Add(diff_ac_i, rot_i), s);
+    y[2] = Lanes::Pack(Lanes::Sub(sum_ac_r, sum_bd_r), Lanes::Sub(sum_ac_i, sum_bd_i), s);
+    y[3] = Lanes::Pack(Lanes::Sub(diff_ac_r, rot_r), Lanes::Sub(diff_ac_i, rot_i), s);
+}
+
+template<typename Lanes>
+inline __m256i MaxOf(__m256i max, const __m256i (&y)[4]) noexcept
+{
+    return Lanes::Max(Lanes::Max(Lanes::Max(Lanes::Max(max, y[0]), y[1]), y[2]), y[3]);
+}
+
+/**
+ * @brief The first radix-4 stage (q = 1, no twiddle products) on AVX2 vectors, for n >= 4 * Lanes::kCount.
+ *
+ * 4 vectors hold Lanes::kCount groups, transposes give the vectors of their quarters and back.
+ */
+template<typename Lanes, FixedPoint NumberT, bool Inverse>
+inline std::uint64_t FirstRadix4StageVector(typename Lanes::Raw* data, std::size_t n, int shift) noexcept
+{
+    __m256i max {_mm256_setzero_si256()};
+    for (std::size_t g = 0; g < n; g += 4 * Lanes::kCount)
+    {
+        typename Lanes::Raw* x {data + 2 * g};
+        __m256i v[4] {LoadLanes(x), LoadLanes(x + 2 * Lanes::kCount), LoadLanes(x + 4 * Lanes::kCount), LoadLanes(x + 6 * Lanes::kCount)};
+        Lanes::Transpose(v);
+        __m256i ar, ai, br, bi, cr, ci, dr, di;
+        Lanes::ToWide(v[0], ar, ai);
+        Lanes::ToWide(v[2], br, bi);
+        Lanes::ToWide(v[1], cr, ci);
+        Lanes::ToWide(v[3], dr, di);
+        __m256i y[4];
+        Radix4ButterflyVector<Lanes, NumberT, Inverse>(ar, ai, br, bi, cr, ci, dr, di, shift, y);
+        max = MaxOf<Lanes>(max, y);
+        Lanes::Transpose(y);
+        for (std::size_t r = 0; r < 4; ++r)
+        {
+            StoreLanes(x + 2 * r * Lanes::kCount, y[r]);
+        }
+    }
+    return Lanes::ReduceMax(max);
+}
+
+/**
+ * @brief Radix4Stage() on AVX2 vectors, with the same results, for q >= Lanes::kCount / 2.
+ *
+ * A vector holds Lanes::kCount consecutive k of a quarter or, when q = Lanes::kCount / 2, all k of
+ * the quarters of two consecutive groups. The lanes of k = 0 take the exact parts instead of the
+ * products.
+ */
+template<typename Lanes, FixedPoint NumberT, bool Inverse>
+inline std::uint64_t Radix4StageVector(typename Lanes::Raw* data, std::size_t n, std::size_t q, const typename Lanes::Raw* twiddles,
+                                       int shift) noexcept
+{
+    using Raw = typename Lanes::Raw;
+    const bool paired {q < Lanes::kCount};
+    __m256i max {_mm256_setzero_si256()};
+
+    for (std::size_t g = 0; g < n; g += paired ? 8 * q : 4 * q)
+    {
+        for (std::size_t k = 0; k < q; k += Lanes::kCount)
+        {
+            Raw* x {data + 2 * (g + k)};
+            // quarter r, or quarter r of this group and of the next one
+            const auto load = [&](std::size_t r) {
+                return paired ? _mm256_loadu2_m128i(reinterpret_cast<const __m128i*>(x + 2 * (4 * q + r * q)), reinterpret_cast<const __m128i*>(x + 2 * r * q))
+                              : LoadLanes(x + 2 * r * q);
+            };
+            const auto twiddle = [&](std::size_t offset) {
+                const Raw* p {twiddles + offset + 2 * k};
+                return paired ? _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) : LoadLanes(p);
+            };
+            // x * w of quarter r, exact for k = 0
+            const auto product = [&](std::size_t r, std::size_t offset, __m256i& re, __m256i& im) {
+                const __m256i v {load(r)};
+                Lanes::Product(v, twiddle(offset), twiddle(offset + 2 * q), re, im);
+                if (k == 0)
+                {
+                    __m256i exact_re, exact_im;
+                    Lanes::ToWide(v, exact_re, exact_im);
+                    re = paired ? _mm256_blend_epi32(re, exact_re, Lanes::kFirstLanes) : _mm256_blend_epi32(re, exact_re, Lanes::kFirstLane);
+                    im = paired ? _mm256_blend_epi32(im, exact_im, Lanes::kFirstLanes) : _mm256_blend_epi32(im, exact_im, Lanes::kFirstLane);
+                }
+            };
+
+            __m256i ar, ai, br, bi, cr, ci, dr, di;
+            Lanes::ToWide(load(0), ar, ai);
+            product(2, 0, br, bi);
+            product(1, 4 * q, cr, ci);
+            product(3, 8 * q, dr, di);
+            __m256i y[4];
+            Radix4ButterflyVector<Lanes, NumberT, Inverse>(ar, ai, br, bi, cr, ci, dr, di, shift, y);
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                if (paired)
+                {
+                    _mm256_storeu2_m128i(reinterpret_cast<__m128i*>(x + 2 * (4 * q + r * q)), reinterpret_cast<__m128i*>(x + 2 * r * q), y[r]);
+                }
+                else
+                {
+                    StoreLanes(x + 2 * r * q, y[r]);
+                }
+            }
+            max = MaxOf<Lanes>(max, y);
+        }
+    }
+    return Lanes::ReduceMax(max);
+}
+
+// Radix2Stage() on AVX2 vectors, with the same results, for n / 2 >= Lanes::kCount
+template<typename Lanes, FixedPoint NumberT>
+inline void Radix2StageVector(typename Lanes::Raw* data, std::size_t n, const typename Lanes::Raw* twiddles, int shift) noexcept
+{
+    using Raw = typename Lanes::Raw;
+    const std::size_t half {n / 2};
+    const int output_shift {kFFTGuardBits<NumberT> + shift};
+    for (std::size_t k = 0; k < half; k += Lanes::kCount)
+    {
+        Raw* x {data + 2 * k};
+        __m256i ar, ai, br, bi;
+        Lanes::ToWide(LoadLanes(x), ar, ai);
+        const __m256i v {LoadLanes(x + 2 * half)};
+        Lanes::Product(v, LoadLanes(twiddles + 2 * k), LoadLanes(twiddles + 2 * half + 2 * k), br, bi);
+        if (k == 0)
+        {
+            __m256i exact_re, exact_im;
+            Lanes::ToWide(v, exact_re, exact_im);
+            br = _mm256_blend_epi32(br, exact_re, Lanes::kFirstLane);
+            bi = _mm256_blend_epi32(bi, exact_im, Lanes::kFirstLane);
+        }
+        StoreLanes(x, Lanes::Pack(Lanes::Add(ar, br), Lanes::Add(ai, bi), output_shift));
+        StoreLanes(x + 2 * half, Lanes::Pack(Lanes::Sub(ar, br), Lanes::Sub(ai, bi), output_shift));
+    }
+}
+
+// largest |re| or |im| of `count` interleaved values, a multiple of Lanes::kCount
+template<typename Lanes>
+inline std::uint64_t MaxMagnitudeVector(const typename Lanes::Raw* data, std::size_t count) noexcept
+{
+    __m256i max {_mm256_setzero_si256()};
+    for (std::size_t i = 0; i < count; i += Lanes::kCount)
+    {
+        max = Lanes::Max(max, LoadLanes(data + 2 * i));
+    }
+    return Lanes::ReduceMax(max);
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Plan of a complex, in-place fast Fourier transform of size N with block floating point.
+ *
+ * A bit-reversal permutation is followed by radix-4 decimation-in-time stages, and by one radix-2
+ * stage when log2(N) is odd. The twiddle factors are constexpr tables with kTwiddleBits fractional
+ * bits in the base type, generated at compile time, so a plan holds no data and costs nothing to
+ * create.
+ *
+ * Before each stage, the largest component of the data decides how much the stage shifts its
+ * results right to stay in range, from 0 to 3 bits (block floating point): inputs don't need to be
+ * pre-scaled, small signals keep their precision and large ones never overflow. The transforms
+ * return the total shift: the true transform is the result times 2^shift.
+ *
+ * Every butterfly computes its twiddle products and sums in WideType with kFFTGuardBits extra
+ * fractional bits and rounds to nearest once, whatever the rounding policy of NumberT. With AVX2
+ * the stages run 8 butterflies (16-bit base types, pmaddwd on the interleaved values) or 4
+ * butterflies (32-bit base types, pmuldq) at a time, with the same results as the scalar code.
+ *
+ * @tparam NumberT Type of the parts of the values, a signed specialization of fp::Number.
+ * @tparam N Transform size, a power of two.
+ */
+template<detail::FFTCompatible NumberT, std::size_t N>
+requires (std::has_single_bit(N) && N >= 2 && N <= (std::size_t{1} << 31))
+class FFT
+{
+public:
+    using value_type = Complex<NumberT>;
+    using ValueType = typename NumberT::ValueType;
+
+    static constexpr std::size_t kSize {N};
+
+    /**
+     * @brief Forward transform, X[k] = sum of x[n] * exp(-2 pi i n k / N), times 2^-shift.
+     *
+     * Returns the shift.
+     */
+    [[nodiscard]] constexpr int Forward(std::span<Complex<NumberT>, N> data) const noexcept
+    {
+        FP_PROFILE_SCOPE("fp::FFT::Forward", N);
+        return Transform<false>(data);
+    }
+
+    /**
+     * @brief Inverse transform without the 1 / N factor, x[n] = sum of X[k] * exp(2 pi i n k / N), times 2^-shift.
+     *
+     * Returns the shift, the normalized inverse is the result times 2^(shift - log2(N)).
+     */
+    [[nodiscard]] constexpr int Inverse(std::span<Complex<NumberT>, N> data) const noexcept
+    {
+        FP_PROFILE_SCOPE("fp::FFT::Inverse", N);
+        return Transform<true>(data);
+    }
+
+private:
+    static_assert(sizeof(Complex<NumberT>) == 2 * sizeof(ValueType), "fp::Complex must be two interleaved parts");
+
+    template<bool Inverse>
+    static constexpr auto kTwiddles {detail::MakeTwiddles<NumberT, N, Inverse>()};
+
+    static constexpr void BitReverse(std::span<Complex<NumberT>, N> data) noexcept
+    {
+        constexpr int kBits {std::countr_zero(N)};
+        for (std::uint32_t i = 0; i < N; ++i)
+        {
+            const std::uint32_t j {detail::ReverseBits(i, kBits)};
+            if (i < j)
+            {
+                std::swap(data[i], data[j]);
+            }
+        }
+    }
+
+#if defined(__AVX2__)
+    using Lanes = std::conditional_t<(sizeof(ValueType) == 2 && sizeof(typename NumberT::WideValueType) == 4), detail::FFTLanes16<NumberT>,
+                                     std::conditional_t<(sizeof(ValueType) == 4 && sizeof(typename NumberT::WideValueType) == 8),
+                                                        detail::FFTLanes32<NumberT>, void>>;
+    static constexpr bool kVectorized {!std::is_void_v<Lanes>};
+#else
+    static constexpr bool kVectorized {false};
+#endif
+
+    // the stages of a transform of the bit-reversed data on AVX2 vectors, false when they can't run
+    template<bool Inverse>
+    static bool TransformVector([[maybe_unused]] std::span<Complex<NumberT>, N> data, [[maybe_unused]] int& total) noexcept
+    {
+#if defined(__AVX2__)
+        if constexpr (kVectorized)
+        {
+            if constexpr (N >= 2 * Lanes::kCount)
+            {
+                using Raw = typename Lanes::Raw;
+                Raw* raw {reinterpret_cast<Raw*>(data.data())};
+                const Raw* twiddles {kTwiddles<Inverse>.data()};
+                std::uint64_t max {detail::MaxMagnitudeVector<Lanes>(raw, N)};
+                std::size_t q {1};
+                for (std::size_t stage = 0; stage < detail::kRadix4Stages<N>; ++stage, q *= 4)
+                {
+                    const int shift {detail::StageShift<NumberT, true>(max)};
+                    if (q == 1 && N >= 4 * Lanes::kCount)
+                    {
+                        max = detail::FirstRadix4StageVector<Lanes, NumberT, Inverse>(raw, N, shift);
+                    }
+                    // pairs of groups need two of them
+                    else if (q >= Lanes::kCount || (2 * q == Lanes::kCount && N >= 8 * q))
+                    {
+                        max = detail::Radix4StageVector<Lanes, NumberT, Inverse>(raw, N, q, twiddles, shift);
+                    }
+                    else
+                    {
+                        max = detail::Radix4Stage<NumberT, Inverse>(data, q, twiddles, shift);
+                    }
+                    total += shift;
+                    twiddles += 12 * q;
+                }
+                if constexpr (detail::kHasRadix2Stage<N>)
+                {
+                    const int shift {detail::StageShift<NumberT, false>(max)};
+                    detail::Radix2StageVector<Lanes, NumberT>(raw, N, twiddles, shift);
+                    total += shift;
+                }
+                return true;
+            }
+        }
+#endif
+        return false;
+    }
+
+    template<bool Inverse>
+    static constexpr int Transform(std::span<Complex<NumberT>, N> data) noexcept
+    {
+        BitReverse(data);
+        int total {0};
+        if (!std::is_constant_evaluated() && TransformVector<Inverse>(data, total))
+        {
+            return total;
+        }
+
+        auto max = detail::MaxMagnitude<NumberT>(data);
+        const ValueType* twiddles {kTwiddles<Inverse>.data()};
+        std::size_t q {1};
+        for (std::size_t stage = 0; stage < detail::kRadix4Stages<N>; ++stage, q *= 4)
+        {
+            const int shift {detail::StageShift<NumberT, true>(max)};
+            max = detail::Radix4Stage<NumberT, Inverse>(data, q, twiddles, shift);
+            total += shift;
+            twiddles += 12 * q;
+        }
+        if constexpr (detail::kHasRadix2Stage<N>)
+        {
+            const int shift {detail::StageShift<NumberT, false>(max)};
+            detail::Radix2Stage<NumberT>(data, twiddles, shift);
+            total += shift;
+        }
+        return total;
+    }
+};
+
+}  // namespace fp
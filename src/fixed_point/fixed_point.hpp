@@ -1,21 +1,67 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
+#include <cstdlib>
 #include <type_traits>
 #include <concepts>
 #include <iostream>
 #include <limits>
+#include <span>
 
 namespace fp
 {
 
+#if defined(__SIZEOF_INT128__)
+/// @brief 128-bit integer types, the WideType for 64-bit base types (e.g. Number<std::int64_t, fp::int128, 32>).
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+namespace detail
+{
+
+/// @brief Trait: T is one of the 128-bit integer types, which the standard traits don't cover in strict mode
+template<typename T>
+struct IsInt128 : std::false_type {};
+
+/// @brief Unsigned counterpart of an integer type, std::make_unsigned extended to the 128-bit types
+template<typename T>
+struct MakeUnsigned { using type = std::make_unsigned_t<T>; };
+
+#if defined(__SIZEOF_INT128__)
+template<> struct IsInt128<int128> : std::true_type {};
+template<> struct IsInt128<uint128> : std::true_type {};
+
+template<> struct MakeUnsigned<int128> { using type = uint128; };
+template<> struct MakeUnsigned<uint128> { using type = uint128; };
+#endif
+
+/// @brief Signed counterpart of an integer type, std::make_signed extended to the 128-bit types
+template<typename T>
+struct MakeSigned { using type = std::make_signed_t<T>; };
+
+#if defined(__SIZEOF_INT128__)
+template<> struct MakeSigned<int128> { using type = int128; };
+template<> struct MakeSigned<uint128> { using type = int128; };
+#endif
+
+template<typename T>
+using MakeUnsignedT = typename MakeUnsigned<T>::type;
+
+template<typename T>
+using MakeSignedT = typename MakeSigned<T>::type;
+
+}  // namespace detail
+
 /// @brief Concept for integer types.
 template<typename T>
-concept Integral = std::is_integral_v<T>;
+concept Integral = std::is_integral_v<T> || detail::IsInt128<T>::value;
 
 /// @brief Concept: T1 and T2 have the same signedness
 template<typename T1, typename T2>
-concept SameSignedness = (std::is_signed_v<T1> == std::is_signed_v<T2>);
+concept SameSignedness = (std::numeric_limits<T1>::is_signed == std::numeric_limits<T2>::is_signed);
 
 /// @brief Concept: T1 is strictly larger in size than T2
 template<typename T1, typename T2>
@@ -25,25 +71,486 @@ concept LargerThan = (sizeof(T1) > sizeof(T2));
 template<typename T, std::size_t NumIntBits>
 concept ValidIntBits = (NumIntBits < std::numeric_limits<T>::digits);
 
-/// @brief Concept: T must not exceed 64 bits
+/// @brief Concept: T must not exceed 128 bits
+template<typename T>
+concept Max128Bits = (std::numeric_limits<T>::digits <= 128);
+
+namespace detail
+{
+
+/// @brief Result of a wide division, truncated towards zero as for integer division.
+template<typename WideType>
+struct QuotientRemainder
+{
+    WideType quotient;
+    WideType remainder;
+};
+
+// numerator / denominator and numerator % denominator, for IntType results
+template<typename IntType, typename WideType>
+[[nodiscard]] constexpr QuotientRemainder<WideType> DivideWide(WideType numerator, WideType denominator) noexcept
+{
+#if defined(__SIZEOF_INT128__) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    if constexpr (sizeof(WideType) == 16 && sizeof(IntType) == 8)
+    {
+        // the generic 128-bit division is a library call, a single divq does when the quotient fits in 64 bits
+        if (!std::is_constant_evaluated())
+        {
+            // divide the magnitudes, the quotient takes the sign of both operands and the remainder that of the numerator
+            auto n = static_cast<uint128>(numerator);
+            auto d = static_cast<uint128>(denominator);
+            bool negative {false};
+            bool negative_numerator {false};
+            if constexpr (std::numeric_limits<WideType>::is_signed)
+            {
+                negative_numerator = numerator < 0;
+                negative = negative_numerator != (denominator < 0);
+                n = numerator < 0 ? -n : n;
+                d = denominator < 0 ? -d : d;
+            }
+
+            auto high = static_cast<std::uint64_t>(n >> 64);
+            if ((d >> 64) == 0 && high < static_cast<std::uint64_t>(d))
+            {
+                auto low = static_cast<std::uint64_t>(n);
+                asm("divq %[d]" : "+a"(low), "+d"(high) : [d] "rm"(static_cast<std::uint64_t>(d)) : "cc");
+                const auto quotient = static_cast<WideType>(low);
+                const auto remainder = static_cast<WideType>(high);
+                return {negative ? -quotient : quotient, negative_numerator ? -remainder : remainder};
+            }
+        }
+    }
+#endif
+    return {numerator / denominator, numerator % denominator};
+}
+
+// value is above the range of IntType, T is a floating point type or an integer type that holds every IntType value
+template<typename IntType, typename T>
+[[nodiscard]] constexpr bool AboveRange(T value) noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        // 2^digits is exact in T, the maximum itself may round up
+        return value >= static_cast<T>(std::numeric_limits<IntType>::max() / 2 + 1) * 2;
+    }
+    else
+    {
+        return value > static_cast<T>(std::numeric_limits<IntType>::max());
+    }
+}
+
+// value is below the range of IntType
+template<typename IntType, typename T>
+[[nodiscard]] constexpr bool BelowRange(T value) noexcept
+{
+    if constexpr (std::numeric_limits<T>::is_signed)
+    {
+        return value < static_cast<T>(std::numeric_limits<IntType>::min());
+    }
+    else
+    {
+        return false;
+    }
+}
+
+// t < u for integers of any signedness, std::cmp_less extended to bool, the character types and the 128-bit types
+template<typename T, typename U>
+[[nodiscard]] constexpr bool CmpLess(T t, U u) noexcept
+{
+    if constexpr (std::numeric_limits<T>::is_signed == std::numeric_limits<U>::is_signed)
+    {
+        return t < u;
+    }
+    else if constexpr (std::numeric_limits<T>::is_signed)
+    {
+        return t < 0 || static_cast<MakeUnsignedT<T>>(t) < u;
+    }
+    else
+    {
+        return u >= 0 && t < static_cast<MakeUnsignedT<U>>(u);
+    }
+}
+
+// value is a floating point NaN
 template<typename T>
-concept Max64Bits = (std::numeric_limits<T>::digits <= 64);
+[[nodiscard]] constexpr bool IsNaN(T value) noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return value != value;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+// not constexpr, so an overflow during constant evaluation is a compile error
+[[noreturn]] inline void OverflowTrap() noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_trap();
+#else
+    std::abort();
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Overflow policies, they narrow the exact (wide or floating point) result of an operation
+ * to the base integer type.
+ *
+ * Wrap keeps the low bits, as the plain integer operations do. It is the default and costs nothing.
+ * Saturate clamps to the nearest representable value, NaN becomes zero.
+ * Trap aborts the program, or fails the compilation when the overflow happens in a constant expression.
+ * A policy may also define DivideByZero<IntType>(numerator), the wide result of a division by zero,
+ * and a Bind<NumberT> alias, the policy each number type applies instead of it (see fp::Instrumented
+ * in instrument.hpp).
+ */
+struct Wrap
+{
+    // out of range floating point values are undefined, as for static_cast
+    template<typename IntType, typename T>
+    [[nodiscard]] static constexpr IntType Narrow(T value) noexcept
+    {
+        return static_cast<IntType>(value);
+    }
+};
+
+struct Saturate
+{
+    template<typename IntType, typename T>
+    [[nodiscard]] static constexpr IntType Narrow(T value) noexcept
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (detail::AboveRange<IntType>(value))
+            {
+                return std::numeric_limits<IntType>::max();
+            }
+            if (detail::BelowRange<IntType>(value))
+            {
+                return std::numeric_limits<IntType>::min();
+            }
+            return detail::IsNaN(value) ? IntType{0} : static_cast<IntType>(value);
+        }
+        else
+        {
+            // a value is in range when narrowing it is lossless, the bound is picked with a sign mask so that this
+            // compiles to a compare and a conditional move
+            constexpr IntType kMax {std::numeric_limits<IntType>::max()};
+            IntType saturated {kMax};
+            if constexpr (std::numeric_limits<T>::is_signed)
+            {
+                const auto negative = static_cast<IntType>(value >> std::numeric_limits<T>::digits);
+                saturated = std::numeric_limits<IntType>::is_signed ? static_cast<IntType>(negative ^ kMax) : static_cast<IntType>(~negative & kMax);
+            }
+            const auto narrowed = static_cast<IntType>(value);
+            return static_cast<T>(narrowed) == value ? narrowed : saturated;
+        }
+    }
+};
+
+struct Trap
+{
+    template<typename IntType, typename T>
+    [[nodiscard]] static constexpr IntType Narrow(T value) noexcept
+    {
+        if (detail::AboveRange<IntType>(value) || detail::BelowRange<IntType>(value) || detail::IsNaN(value)) [[unlikely]]
+        {
+            detail::OverflowTrap();
+        }
+        return static_cast<IntType>(value);
+    }
+};
+
+/// @brief Concept: T is an overflow policy for the base type IntType
+template<typename T, typename IntType>
+concept OverflowPolicy = requires(long long wide, double floating) {
+    { T::template Narrow<IntType>(wide) } -> std::same_as<IntType>;
+    { T::template Narrow<IntType>(floating) } -> std::same_as<IntType>;
+};
+
+namespace detail
+{
+
+// largest integral value not above value, std::floor is not constexpr before C++23
+template<std::floating_point T>
+[[nodiscard]] constexpr T Floor(T value) noexcept
+{
+    // from 2^(digits - 1) on every value is integral, NaN and infinities fall through as well
+    constexpr auto kIntegral = static_cast<T>(1ULL << (std::numeric_limits<T>::digits - 1));
+    if (!(value < kIntegral && value > -kIntegral))
+    {
+        return value;
+    }
+    const auto truncated = static_cast<T>(static_cast<long long>(value));
+    return truncated > value ? truncated - 1 : truncated;
+}
+
+// floor(value / 2^shift) and the discarded low bits, as a fraction of 2^shift
+template<typename T>
+[[nodiscard]] constexpr QuotientRemainder<T> ShiftWithRemainder(T value, std::size_t shift) noexcept
+{
+    const auto mask = static_cast<T>((static_cast<T>(1) << shift) - 1);
+    return {static_cast<T>(value >> shift), static_cast<T>(value & mask)};
+}
+
+// the quotient of a truncating division turned into floor(numerator / denominator), with the
+// remainder as a magnitude below |denominator|
+template<typename T>
+[[nodiscard]] constexpr QuotientRemainder<T> FloorQuotient(T quotient, T remainder, T denominator) noexcept
+{
+    if constexpr (std::numeric_limits<T>::is_signed)
+    {
+        if (remainder != 0 && ((remainder < 0) != (denominator < 0)))
+        {
+            quotient = static_cast<T>(quotient - 1);
+            remainder = static_cast<T>(remainder + denominator);
+        }
+        return {quotient, remainder < 0 ? static_cast<T>(-remainder) : remainder};
+    }
+    else
+    {
+        return {quotient, remainder};
+    }
+}
+
+// |value| in the same type
+template<typename T>
+[[nodiscard]] constexpr T Absolute(T value) noexcept
+{
+    if constexpr (std::numeric_limits<T>::is_signed)
+    {
+        return value < 0 ? static_cast<T>(-value) : value;
+    }
+    else
+    {
+        return value;
+    }
+}
+
+// per-thread state of the stochastic rounding, SplitMix64
+inline thread_local std::uint64_t stochastic_state {0x853C49E6748FEA9BULL};
+
+[[nodiscard]] inline std::uint64_t StochasticBits() noexcept
+{
+    std::uint64_t z = (stochastic_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// NumberT can be accessed as its base type: trivially copyable, with the size and alignment of ValueType
+template<typename NumberT>
+inline constexpr bool kHasBaseLayout {std::is_trivially_copyable_v<NumberT> && std::is_standard_layout_v<NumberT> &&
+                                      sizeof(NumberT) == sizeof(typename NumberT::ValueType) &&
+                                      alignof(NumberT) == alignof(typename NumberT::ValueType)};
+
+/// @brief Policy as NumberT applies it: Policy::Bind<NumberT> for the policies that depend on the number type
+/// (fp::Instrumented counts per type), Policy itself for the others.
+template<typename Policy, typename NumberT>
+struct BindPolicy
+{
+    using type = Policy;
+};
+
+template<typename Policy, typename NumberT>
+requires requires { typename Policy::template Bind<NumberT>; }
+struct BindPolicy<Policy, NumberT>
+{
+    using type = typename Policy::template Bind<NumberT>;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Rounding policies, they decide how results with more fractional bits than the format
+ * holds are rounded: the product of a multiplication, the quotient of a division and the scaled
+ * value of a floating point conversion.
+ *
+ * Truncate is the default and costs nothing: products round towards minus infinity (an arithmetic
+ * shift), quotients and floating point values towards zero.
+ * RoundHalfUp rounds to the nearest value, ties towards plus infinity.
+ * RoundHalfEven rounds to the nearest value, ties to the even one, so ties carry no bias either.
+ * RoundStochastic rounds up with a probability equal to the discarded fraction, so the error is zero
+ * on average. The random bits come from a per-thread generator (see SeedStochasticRounding()),
+ * during constant evaluation it rounds as RoundHalfEven.
+ *
+ * A policy provides:
+ * - RoundShift(value, shift): value / 2^shift, shift > 0
+ * - RoundQuotient(quotient, remainder, denominator): adjusts the result of a truncating division
+ * - RoundFloat(value): value rounded to an integral value, the overflow policy narrows it afterwards
+ */
+struct Truncate
+{
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundShift(T value, std::size_t shift) noexcept
+    {
+        return static_cast<T>(value >> shift);
+    }
+
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundQuotient(T quotient, T /* remainder */, T /* denominator */) noexcept
+    {
+        return quotient;
+    }
+
+    // the narrowing conversion truncates
+    template<std::floating_point T>
+    [[nodiscard]] static constexpr T RoundFloat(T value) noexcept
+    {
+        return value;
+    }
+};
+
+struct RoundHalfUp
+{
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundShift(T value, std::size_t shift) noexcept
+    {
+        // adding half of the dropped weight at the wide precision can't overflow: the wide type holds a full product
+        return static_cast<T>((value + (static_cast<T>(1) << (shift - 1))) >> shift);
+    }
+
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundQuotient(T quotient, T remainder, T denominator) noexcept
+    {
+        const auto [floor, fraction] = detail::FloorQuotient(quotient, remainder, denominator);
+        return static_cast<T>(floor + (2 * fraction >= detail::Absolute(denominator)));
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] static constexpr T RoundFloat(T value) noexcept
+    {
+        const T floor = detail::Floor(value);
+        return value - floor >= static_cast<T>(0.5) ? floor + 1 : floor;
+    }
+};
+
+struct RoundHalfEven
+{
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundShift(T value, std::size_t shift) noexcept
+    {
+        const auto [floor, fraction] = detail::ShiftWithRemainder(value, shift);
+        const auto half = static_cast<T>(static_cast<T>(1) << (shift - 1));
+        return static_cast<T>(floor + (fraction > half || (fraction == half && (floor & 1) != 0)));
+    }
+
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundQuotient(T quotient, T remainder, T denominator) noexcept
+    {
+        const auto [floor, fraction] = detail::FloorQuotient(quotient, remainder, denominator);
+        const auto twice = static_cast<T>(2 * fraction);
+        const auto magnitude = detail::Absolute(denominator);
+        return static_cast<T>(floor + (twice > magnitude || (twice == magnitude && (floor & 1) != 0)));
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] static constexpr T RoundFloat(T value) noexcept
+    {
+        // adding 2^(digits - 1) leaves no fractional bits, so the addition itself rounds half to even
+        // (the default floating point rounding mode, also during constant evaluation)
+        constexpr auto kIntegral = static_cast<T>(1ULL << (std::numeric_limits<T>::digits - 1));
+        if (!(value < kIntegral && value > -kIntegral))
+        {
+            return value;
+        }
+        const T magic = value < 0 ? -kIntegral : kIntegral;
+        return (value + magic) - magic;
+    }
+};
+
+struct RoundStochastic
+{
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundShift(T value, std::size_t shift) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            return RoundHalfEven::RoundShift(value, shift);
+        }
+        // floor((value + u) / 2^shift) with u uniform in [0, 2^shift) rounds up with probability fraction / 2^shift
+        const auto mask = static_cast<T>((static_cast<T>(1) << shift) - 1);
+        return static_cast<T>((value + static_cast<T>(static_cast<T>(detail::StochasticBits()) & mask)) >> shift);
+    }
+
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundQuotient(T quotient, T remainder, T denominator) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            return RoundHalfEven::RoundQuotient(quotient, remainder, denominator);
+        }
+        const auto [floor, fraction] = detail::FloorQuotient(quotient, remainder, denominator);
+        // |denominator| is a base type value, at most 2^64
+        const auto threshold = detail::StochasticBits() % static_cast<std::uint64_t>(detail::Absolute(denominator));
+        return static_cast<T>(floor + (static_cast<std::uint64_t>(fraction) > threshold));
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] static constexpr T RoundFloat(T value) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            return RoundHalfEven::RoundFloat(value);
+        }
+        const T floor = detail::Floor(value);
+        // uniform in [0, 1) with 53 random bits
+        const T threshold = static_cast<T>(static_cast<double>(detail::StochasticBits() >> 11) * 0x1.0p-53);
+        return value - floor > threshold ? floor + 1 : floor;
+    }
+};
+
+/// @brief Seeds the generator of RoundStochastic for the calling thread, for reproducible runs.
+inline void SeedStochasticRounding(std::uint64_t seed) noexcept
+{
+    detail::stochastic_state = seed;
+}
+
+/// @brief Concept: T is a rounding policy
+template<typename T>
+concept RoundingPolicy = requires(long long wide, double floating, std::size_t shift) {
+    { T::RoundShift(wide, shift) } -> std::same_as<long long>;
+    { T::RoundQuotient(wide, wide, wide) } -> std::same_as<long long>;
+    { T::RoundFloat(floating) } -> std::same_as<double>;
+};
 
 /**
  * @brief A fixed-point number class template. Supports both signed and unsigned integer types.
  * 
  * @tparam IntType The base integer type to use (e.g., std::int32_t, std::uint32_t).
- * @tparam WideType The integer type to perform intermediate calculations.
+ * @tparam WideType The integer type to perform intermediate calculations. fp::int128 / fp::uint128 widen
+ *                  64-bit base types, the products compile to a single widening multiply.
  * @tparam NumIntBits Number of bits to use for the integer part.
+ * @tparam Overflow What happens to results out of range: fp::Wrap (default), fp::Saturate or fp::Trap.
+ *                  It applies to the constructors and to the arithmetic operators, FromBits() is never checked.
+ * @tparam Rounding How multiplication, division and the floating point constructors round: fp::Truncate
+ *                  (default), fp::RoundHalfUp, fp::RoundHalfEven or fp::RoundStochastic.
  */
-template<Integral IntType, Integral WideType, std::size_t NumIntBits>
-requires SameSignedness<IntType, WideType> && LargerThan<WideType, IntType> && ValidIntBits<IntType, NumIntBits> && Max64Bits<WideType>
+template<Integral IntType, Integral WideType, std::size_t NumIntBits, typename Overflow = Wrap, typename Rounding = Truncate>
+requires SameSignedness<IntType, WideType> && LargerThan<WideType, IntType> && ValidIntBits<IntType, NumIntBits> && Max128Bits<WideType> && OverflowPolicy<Overflow, IntType> && RoundingPolicy<Rounding>
 class Number
 {
 public:
+    // underlying integer types
+    using ValueType = IntType;
+    using WideValueType = WideType;
+
+    // overflow and rounding policies
+    using OverflowType = Overflow;
+    using RoundingType = Rounding;
+
+    // the policies as this type applies them, the ones above unless they bind to the number type (fp::Instrumented)
+    using BoundOverflowType = typename detail::BindPolicy<Overflow, Number>::type;
+    using BoundRoundingType = typename detail::BindPolicy<Rounding, Number>::type;
+
     // variables describing the fixed point number representation
     static constexpr bool kIsSigned {std::is_signed_v<IntType>};
     static constexpr std::size_t kNumBits {sizeof(IntType) * 8};
+    static constexpr std::size_t kNumIntBits {NumIntBits};
     static constexpr std::size_t kNumFracBits {kNumBits - NumIntBits};
     static constexpr IntType kScaleFactor {static_cast<IntType>(static_cast<WideType>(1) << kNumFracBits)};
 
@@ -62,6 +569,8 @@ public:
     // factory method for number construction
     [[nodiscard]] static constexpr Number FromBits(IntType raw) noexcept
     {
+        // the layout AsBits(), AsNumbers(), Vector::ViewBits() and the array files rely on, they check it as well
+        static_assert(detail::kHasBaseLayout<Number>, "fp::Number must have the layout of its base type");
         Number result;
         result.value_ = raw;
         return result;
@@ -93,14 +602,20 @@ public:
     constexpr explicit Number() noexcept : value_{0} {};
 
     // constructor from float
-    constexpr explicit Number(float f) noexcept: value_{static_cast<IntType>(f * kScaleFactor)} {};
+    constexpr explicit Number(float f) noexcept: value_{Narrow(BoundRoundingType::RoundFloat(f * kScaleFactor))} {};
 
     // constructor from double
-    constexpr explicit Number(double d) noexcept: value_{static_cast<IntType>(d * kScaleFactor)} {};
+    constexpr explicit Number(double d) noexcept: value_{Narrow(BoundRoundingType::RoundFloat(d * kScaleFactor))} {};
 
     // constructor from int
     template<std::integral T>
-    constexpr explicit Number(T i) noexcept : value_{static_cast<IntType>(static_cast<WideType>(i) << kNumFracBits)} {}
+    constexpr explicit Number(T i) noexcept : value_{FromInteger(i)} {}
+
+    // getter for the raw bits, the inverse of FromBits()
+    [[nodiscard]] constexpr IntType Bits() const noexcept
+    {
+        return value_;
+    }
 
     // getter for integer part
     [[nodiscard]] constexpr IntType IntPart() const noexcept
@@ -130,19 +645,19 @@ public:
     [[nodiscard]] constexpr Number operator-() const noexcept
     {
         static_assert(kIsSigned, "Negation operator is not supported for unsigned fixed point types");
-        return FromBits(-value_);
+        return FromBits(Narrow(-static_cast<WideType>(value_)));
     }
 
     // addition operator
     [[nodiscard]] constexpr Number operator+(const Number & other) const noexcept
     {
-        return FromBits(value_ + other.value_);
+        return FromBits(Narrow(static_cast<SignedWideType>(value_) + static_cast<SignedWideType>(other.value_)));
     }
 
     // subtraction operator
     [[nodiscard]] constexpr Number operator-(const Number & other) const noexcept
     {
-        return FromBits(value_ - other.value_);
+        return FromBits(Narrow(static_cast<SignedWideType>(value_) - static_cast<SignedWideType>(other.value_)));
     }
 
     // multiplication operator
@@ -150,7 +665,7 @@ public:
     {
         const auto this_val = static_cast<WideType>(value_);
         const auto other_val = static_cast<WideType>(other.value_);
-        return FromBits(static_cast<IntType>((this_val * other_val) >> kNumFracBits));
+        return FromBits(Narrow(BoundRoundingType::RoundShift(this_val * other_val, kNumFracBits)));
     }
 
     // division operator
@@ -158,20 +673,58 @@ public:
     {
         const auto this_wide_val = static_cast<WideType>(value_) << kNumFracBits;
         const auto other_wide_val = static_cast<WideType>(other.value_);
-        return FromBits(static_cast<IntType>(this_wide_val / other_wide_val));
+        return FromBits(Narrow(Quotient(this_wide_val, other_wide_val)));
+    }
+
+    // multiplication by a compile-time constant, same result as *this * Number(Factor): the trailing zero bits of the
+    // constant become a shift, a power of two needs no multiply (RoundStochastic rounds with the same distribution)
+    template<auto Factor>
+    [[nodiscard]] constexpr Number Mul() const noexcept
+    {
+        constexpr auto kRaw = Number(Factor).value_;
+        constexpr std::size_t kShift {kRaw == 0 ? 0 : static_cast<std::size_t>(std::countr_zero(static_cast<UnsignedType>(kRaw)))};
+        constexpr auto kOdd = static_cast<WideType>(kRaw >> kShift);
+        const auto product = static_cast<WideType>(static_cast<WideType>(value_) * kOdd);
+        if constexpr (kShift >= kNumFracBits)
+        {
+            return FromBits(Narrow(static_cast<WideType>(product << (kShift - kNumFracBits))));
+        }
+        else
+        {
+            return FromBits(Narrow(BoundRoundingType::RoundShift(product, kNumFracBits - kShift)));
+        }
+    }
+
+    // division by a compile-time constant, same result as *this / Number(Divisor) without a wide divide: the powers of two
+    // of the scaled numerator and the divisor cancel, so an integral divisor divides the base type value, and the compiler
+    // turns the constant division into a shift or a multiply-high by a magic reciprocal
+    template<auto Divisor>
+    [[nodiscard]] constexpr Number Div() const noexcept
+    {
+        constexpr auto kRaw = Number(Divisor).value_;
+        static_assert(kRaw != 0, "Div<>() by a divisor that is zero in this format");
+        constexpr std::size_t kCancelled {std::min(static_cast<std::size_t>(std::countr_zero(static_cast<UnsignedType>(kRaw))), kNumFracBits)};
+        constexpr auto kReduced = static_cast<WideType>(kRaw >> kCancelled);
+        // the base type is enough unless fractional bits remain, or a quotient of -1 could overflow it
+        using Work = std::conditional_t<kCancelled == kNumFracBits && static_cast<SignedWideType>(kReduced) != -1, IntType, WideType>;
+        const auto numerator = static_cast<Work>(static_cast<WideType>(value_) << (kNumFracBits - kCancelled));
+        const auto quotient = static_cast<WideType>(numerator / static_cast<Work>(kReduced));
+        const auto remainder = static_cast<WideType>(numerator % static_cast<Work>(kReduced));
+        // rounded as operator/ rounds the quotient of the scaled values
+        return FromBits(Narrow(BoundRoundingType::RoundQuotient(quotient, static_cast<WideType>(remainder << kCancelled), static_cast<WideType>(kRaw))));
     }
 
     // increment operator
     constexpr Number& operator+=(const Number & other) noexcept
     {
-        value_ += other.value_;
+        value_ = Narrow(static_cast<SignedWideType>(value_) + static_cast<SignedWideType>(other.value_));
         return *this;
     }
 
     // decrement operator
     constexpr Number& operator-=(const Number & other) noexcept
     {
-        value_ -= other.value_;
+        value_ = Narrow(static_cast<SignedWideType>(value_) - static_cast<SignedWideType>(other.value_));
         return *this;
     }
 
@@ -180,7 +733,7 @@ public:
     {
         const auto this_wide_val = static_cast<WideType>(value_);
         const auto other_wide_val = static_cast<WideType>(other.value_);
-        value_ = static_cast<IntType>((this_wide_val * other_wide_val) >> kNumFracBits);
+        value_ = Narrow(BoundRoundingType::RoundShift(this_wide_val * other_wide_val, kNumFracBits));
         return *this;
     }
 
@@ -189,7 +742,7 @@ public:
     {
         const auto this_wide_val = static_cast<WideType>(value_) << kNumFracBits;
         const auto other_wide_val = static_cast<WideType>(other.value_);
-        value_ = static_cast<IntType>(this_wide_val / other_wide_val);
+        value_ = Narrow(Quotient(this_wide_val, other_wide_val));
         return *this;
     }
 
@@ -213,28 +766,44 @@ public:
         }
     }
 
-    // sign
+    // sign, -1 or 1 (0 or 1 for unsigned types), selected with the sign mask
     [[nodiscard]] static constexpr Number Sign(const Number & a) noexcept
     {
         if constexpr (kIsSigned)
         {
-            return SignBit(a) ? NegOne() : PosOne();
+            const auto mask = static_cast<IntType>(a.value_ >> (kNumBits - 1));
+            return FromBits(static_cast<IntType>((kScaleFactor ^ mask) - mask));
         }
         else
         {
             // unsigned types are always positive (Except zero)
-            return a.value_ == 0 ? Zero() : PosOne();
+            return FromBits(static_cast<IntType>(kScaleFactor * static_cast<IntType>(a.value_ != 0)));
         }
     }
 
-    // abs function
+    // abs function, |min| follows the overflow policy
     friend constexpr auto Abs(const Number& a) noexcept
     {
         if constexpr (kIsSigned)
         {
-            const auto raw_val = static_cast<WideType>(a.value_);
-            const auto abs_val = SignBit(a) ? -raw_val : raw_val;
-            return FromBits(static_cast<IntType>(abs_val));
+            // negated in the unsigned type, without widening: neg + cmov, and a vector abs or blend in
+            // vectorized loops (fp::simd::Abs() uses vpabs / vabs)
+            const auto bits = static_cast<UnsignedType>(a.value_);
+            const auto magnitude = a.value_ < 0 ? static_cast<UnsignedType>(UnsignedType{0} - bits) : bits;
+            if constexpr (std::is_same_v<Overflow, Wrap>)
+            {
+                return FromBits(static_cast<IntType>(magnitude));
+            }
+            else if constexpr (std::is_same_v<Overflow, Saturate>)
+            {
+                // only |min| still has the sign bit set, flipping the other bits turns it into max
+                const auto raw = static_cast<IntType>(magnitude);
+                return FromBits(static_cast<IntType>(raw ^ (raw >> (kNumBits - 1))));
+            }
+            else
+            {
+                return FromBits(Narrow(static_cast<WideType>(magnitude)));
+            }
         }
         else
         {
@@ -243,13 +812,330 @@ public:
         }
     }
 
+    // smaller of a and b, a when they are equal
+    [[nodiscard]] friend constexpr Number Min(const Number& a, const Number& b) noexcept
+    {
+        return b.value_ < a.value_ ? b : a;
+    }
+
+    // larger of a and b, a when they are equal
+    [[nodiscard]] friend constexpr Number Max(const Number& a, const Number& b) noexcept
+    {
+        return a.value_ < b.value_ ? b : a;
+    }
+
+    // x limited to [lo, hi], lo <= hi
+    [[nodiscard]] friend constexpr Number Clamp(const Number& x, const Number& lo, const Number& hi) noexcept
+    {
+        return Min(Max(x, lo), hi);
+    }
+
+    // |magnitude| with the sign of sign, identity for unsigned types
+    [[nodiscard]] friend constexpr Number CopySign(const Number& magnitude, const Number& sign) noexcept
+    {
+        if constexpr (kIsSigned)
+        {
+            const auto mask = SignMask(sign);
+            const auto raw = static_cast<UnsignedType>(Abs(magnitude).value_);
+            return FromBits(static_cast<IntType>((raw ^ mask) - mask));
+        }
+        else
+        {
+            return magnitude;
+        }
+    }
+
+    // a + (b - a) * t for t in [0, 1], the difference and the product are exact in WideType and rounded once
+    [[nodiscard]] friend constexpr Number Lerp(const Number& a, const Number& b, const Number& t) noexcept
+    {
+        static_assert(kIsSigned || NumIntBits > 0, "Lerp() needs an integer bit for t = 1");
+        const auto difference = static_cast<SignedWideType>(static_cast<SignedWideType>(b.value_) - static_cast<SignedWideType>(a.value_));
+        const auto step = BoundRoundingType::RoundShift(static_cast<SignedWideType>(difference * static_cast<SignedWideType>(t.value_)), kNumFracBits);
+        return FromBits(Narrow(static_cast<SignedWideType>(static_cast<SignedWideType>(a.value_) + step)));
+    }
+
 private:
+    // sums, differences and integer values are computed in a signed type, so that they stay exact for unsigned base types too
+    using SignedWideType = detail::MakeSignedT<WideType>;
+    using UnsignedType = detail::MakeUnsignedT<IntType>;
+
+    // all ones for negative values, zero otherwise
+    [[nodiscard]] static constexpr UnsignedType SignMask(const Number& a) noexcept
+    {
+        return static_cast<UnsignedType>(a.value_ >> (kNumBits - 1));
+    }
+
+    // narrows an exact result through the overflow policy
+    template<typename T>
+    [[nodiscard]] static constexpr IntType Narrow(T value) noexcept
+    {
+        return BoundOverflowType::template Narrow<IntType>(value);
+    }
+
+    // rounded quotient of the wide division
+    [[nodiscard]] static constexpr WideType Quotient(WideType numerator, WideType denominator) noexcept
+    {
+        // policies that define DivideByZero() (fp::Instrumented) decide the result of x / 0, the others leave it undefined
+        if constexpr (requires { BoundOverflowType::template DivideByZero<IntType>(numerator); })
+        {
+            if (denominator == 0) [[unlikely]]
+            {
+                return BoundOverflowType::template DivideByZero<IntType>(numerator);
+            }
+        }
+        const auto [quotient, remainder] = detail::DivideWide<IntType>(numerator, denominator);
+        return BoundRoundingType::RoundQuotient(quotient, remainder, denominator);
+    }
+
+    // raw bits of an integer value
+    template<std::integral T>
+    [[nodiscard]] static constexpr IntType FromInteger(T i) noexcept
+    {
+        // i << kNumFracBits is formed exactly and narrowed by the policy, so that the wrapping ones keep its low
+        // bits and the others see its true magnitude
+        if constexpr (std::numeric_limits<T>::digits + kNumFracBits <= std::numeric_limits<SignedWideType>::digits)
+        {
+            return Narrow(static_cast<SignedWideType>(i) * (static_cast<SignedWideType>(1) << kNumFracBits));
+        }
+#if defined(__SIZEOF_INT128__)
+        else if constexpr (std::numeric_limits<T>::digits + kNumFracBits <= std::numeric_limits<int128>::digits)
+        {
+            return Narrow(static_cast<int128>(i) * (static_cast<int128>(1) << kNumFracBits));
+        }
+#endif
+        else
+        {
+            // no type holds the exact value: an out of range i is replaced by the value nearest to the range
+            // with the same integer bits modulo 2^kIntBits, which narrows to the same bits and to the same side
+            using UnsignedT = detail::MakeUnsignedT<T>;
+            constexpr std::size_t kIntBits {kNumBits - kNumFracBits};
+            constexpr auto kMask = static_cast<UnsignedT>((static_cast<SignedWideType>(1) << kIntBits) - 1);
+            constexpr auto kMaxInt = static_cast<SignedWideType>(std::numeric_limits<IntType>::max() >> kNumFracBits);
+            constexpr auto kMinInt = static_cast<SignedWideType>(std::numeric_limits<IntType>::min() >> kNumFracBits);
+            constexpr SignedWideType kAbove {kMaxInt + 1};
+            constexpr SignedWideType kBelow {kMinInt - (static_cast<SignedWideType>(1) << kIntBits)};
+            SignedWideType reduced;
+            if (detail::CmpLess(kMaxInt, i))
+            {
+                reduced = kAbove + static_cast<SignedWideType>((static_cast<UnsignedT>(i) - static_cast<UnsignedT>(kAbove)) & kMask);
+            }
+            else if (detail::CmpLess(i, kMinInt))
+            {
+                reduced = kBelow + static_cast<SignedWideType>((static_cast<UnsignedT>(i) - static_cast<UnsignedT>(kBelow)) & kMask);
+            }
+            else
+            {
+                reduced = static_cast<SignedWideType>(i);
+            }
+            return Narrow(reduced * (static_cast<SignedWideType>(1) << kNumFracBits));
+        }
+    }
+
     IntType value_;
 };
 
+/// @brief Trait: T is a specialization of fp::Number
+template<typename T>
+struct IsNumber : std::false_type {};
+
+template<Integral IntType, Integral WideType, std::size_t NumIntBits, typename Overflow, typename Rounding>
+struct IsNumber<Number<IntType, WideType, NumIntBits, Overflow, Rounding>> : std::true_type {};
+
+/// @brief Concept: T is a fixed-point number type
+template<typename T>
+concept FixedPoint = IsNumber<std::remove_cv_t<T>>::value;
+
+/**
+ * @brief The constant Value in the format NumberT, converted during compilation, e.g.
+ * `fp::Const<Q16, 0.125>`. A value out of range fails the compilation unless the overflow policy
+ * saturates. Number::Mul<Value>() and Number::Div<Value>() operate with it as a compile-time
+ * constant.
+ */
+template<FixedPoint NumberT, auto Value>
+inline constexpr NumberT Const {Value};
+
+namespace detail
+{
+
+// raw bits of a fixed-point number, as they would be passed to FromBits()
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr typename NumberT::ValueType RawBits(const NumberT& a) noexcept
+{
+    return a.Bits();
+}
+
+// T with the const qualification of From
+template<typename From, typename T>
+using CopyConstT = std::conditional_t<std::is_const_v<From>, const T, T>;
+
+/// @brief Signed type wide enough for any base type value of Source or Target shifted by less than its width.
+template<FixedPoint Target, FixedPoint Source>
+using ConversionType = MakeSignedT<std::conditional_t<(sizeof(typename Source::WideValueType) > sizeof(typename Target::WideValueType)),
+                                                      typename Source::WideValueType, typename Target::WideValueType>>;
+
+/// @brief Smallest base type of the given signedness with at least Bits bits, with its wide type.
+template<bool Signed, std::size_t Bits>
+struct BaseTypeOfWidth
+{
+    static_assert(Bits <= 64, "the format needs more than 64 bits");
+};
+
+template<> struct BaseTypeOfWidth<true, 8> { using type = std::int8_t; using wide = std::int16_t; };
+template<> struct BaseTypeOfWidth<false, 8> { using type = std::uint8_t; using wide = std::uint16_t; };
+template<> struct BaseTypeOfWidth<true, 16> { using type = std::int16_t; using wide = std::int32_t; };
+template<> struct BaseTypeOfWidth<false, 16> { using type = std::uint16_t; using wide = std::uint32_t; };
+template<> struct BaseTypeOfWidth<true, 32> { using type = std::int32_t; using wide = std::int64_t; };
+template<> struct BaseTypeOfWidth<false, 32> { using type = std::uint32_t; using wide = std::uint64_t; };
+#if defined(__SIZEOF_INT128__)
+template<> struct BaseTypeOfWidth<true, 64> { using type = std::int64_t; using wide = int128; };
+template<> struct BaseTypeOfWidth<false, 64> { using type = std::uint64_t; using wide = uint128; };
+#endif
+
+// the standard width that Bits rounds up to
+[[nodiscard]] constexpr std::size_t StandardWidth(std::size_t bits) noexcept
+{
+    return bits <= 8 ? 8 : bits <= 16 ? 16 : bits <= 32 ? 32 : bits <= 64 ? 64 : bits;
+}
+
+/// @brief Number with at least NumBits bits of which NumFracBits are fractional, the remaining bits
+/// of the base type go to the integer part. The policies are those of NumberT.
+template<FixedPoint NumberT, std::size_t NumBits, std::size_t NumFracBits>
+struct FormatWithBits
+{
+    using Base = BaseTypeOfWidth<NumberT::kIsSigned, StandardWidth(NumBits)>;
+    using type = Number<typename Base::type, typename Base::wide, StandardWidth(NumBits) - NumFracBits,
+                        typename NumberT::OverflowType, typename NumberT::RoundingType>;
+};
+
+}  // namespace detail
+
+/**
+ * @brief View of fixed-point numbers as their raw bits, without copies: element i is numbers[i].Bits().
+ *
+ * fp::Number is trivially copyable, standard layout, and has the size and alignment of its base
+ * type (checked at compile time for every instantiation), so a buffer of numbers can be handed to
+ * send(), a DMA engine or std::memcpy as a buffer of base type values, and std::as_bytes() works on
+ * it too. Writes through the view change the numbers.
+ */
+template<FixedPoint NumberT, std::size_t Extent>
+[[nodiscard]] std::span<detail::CopyConstT<NumberT, typename NumberT::ValueType>, Extent> AsBits(std::span<NumberT, Extent> numbers) noexcept
+{
+    static_assert(detail::kHasBaseLayout<NumberT>, "fp::Number must have the layout of its base type");
+    using ValueType = detail::CopyConstT<NumberT, typename NumberT::ValueType>;
+    return std::span<ValueType, Extent>(reinterpret_cast<ValueType*>(numbers.data()), numbers.size());
+}
+
+/**
+ * @brief View of raw bits (e.g. a receive buffer) as fixed-point numbers, the inverse of AsBits():
+ * element i is NumberT::FromBits(raw[i]).
+ */
+template<FixedPoint NumberT, typename T, std::size_t Extent>
+requires std::is_same_v<std::remove_const_t<T>, typename NumberT::ValueType>
+[[nodiscard]] std::span<detail::CopyConstT<T, NumberT>, Extent> AsNumbers(std::span<T, Extent> raw) noexcept
+{
+    static_assert(detail::kHasBaseLayout<NumberT>, "fp::Number must have the layout of its base type");
+    using Element = detail::CopyConstT<T, NumberT>;
+    return std::span<Element, Extent>(reinterpret_cast<Element*>(raw.data()), raw.size());
+}
+
+/**
+ * @brief Result type of a multiplication of the formats A and B: the integer and fractional bits
+ * add up (Q16.16 * Q8.24 is Q24.40), so the product is exact. It has the policies of A.
+ */
+template<FixedPoint A, FixedPoint B>
+using ProductType = typename detail::FormatWithBits<A, A::kNumBits + B::kNumBits, A::kNumFracBits + B::kNumFracBits>::type;
+
+/**
+ * @brief Result type of an addition of the formats A and B: the larger fractional part and the
+ * larger integer part plus a carry bit (Q16.16 + Q8.24 is Q40.24, in a 64-bit base type), so the
+ * sum is exact. It has the policies of A.
+ */
+template<FixedPoint A, FixedPoint B>
+using SumType = typename detail::FormatWithBits<A, std::max(A::kNumIntBits, B::kNumIntBits) + 1 + std::max(A::kNumFracBits, B::kNumFracBits),
+                                                std::max(A::kNumFracBits, B::kNumFracBits)>::type;
+
+/**
+ * @brief Converts x to the format Target with a single shift.
+ *
+ * Dropped fractional bits are truncated (towards minus infinity) and values out of the range of
+ * Target wrap, as for a conversion between integer types, whatever the policies. Use it where
+ * the value is known to fit, and Rescale() otherwise.
+ */
+template<FixedPoint Target, FixedPoint Source>
+[[nodiscard]] constexpr Target Convert(const Source& x) noexcept
+{
+    using Wide = detail::ConversionType<Target, Source>;
+    const auto raw = static_cast<Wide>(detail::RawBits(x));
+    if constexpr (Target::kNumFracBits >= Source::kNumFracBits)
+    {
+        return Target::FromBits(static_cast<typename Target::ValueType>(raw << (Target::kNumFracBits - Source::kNumFracBits)));
+    }
+    else
+    {
+        return Target::FromBits(static_cast<typename Target::ValueType>(raw >> (Source::kNumFracBits - Target::kNumFracBits)));
+    }
+}
+
+/**
+ * @brief Mixed-format arithmetic. Numbers of different formats (of the same signedness) combine
+ * into a format computed at compile time, ProductType or SumType, which holds the exact result.
+ * The operands are aligned with shifts only, there is no rounding and no overflow.
+ * Subtracting unsigned numbers wraps when the result is negative.
+ */
+template<FixedPoint A, FixedPoint B>
+requires (!std::is_same_v<A, B>) && (A::kIsSigned == B::kIsSigned)
+[[nodiscard]] constexpr ProductType<A, B> operator*(const A& a, const B& b) noexcept
+{
+    using Result = ProductType<A, B>;
+    using ValueType = typename Result::ValueType;
+    return Result::FromBits(static_cast<ValueType>(static_cast<ValueType>(detail::RawBits(a)) * static_cast<ValueType>(detail::RawBits(b))));
+}
+
+template<FixedPoint A, FixedPoint B>
+requires (!std::is_same_v<A, B>) && (A::kIsSigned == B::kIsSigned)
+[[nodiscard]] constexpr SumType<A, B> operator+(const A& a, const B& b) noexcept
+{
+    using Result = SumType<A, B>;
+    using ValueType = typename Result::ValueType;
+    return Result::FromBits(static_cast<ValueType>(detail::RawBits(Convert<Result>(a)) + detail::RawBits(Convert<Result>(b))));
+}
+
+template<FixedPoint A, FixedPoint B>
+requires (!std::is_same_v<A, B>) && (A::kIsSigned == B::kIsSigned)
+[[nodiscard]] constexpr SumType<A, B> operator-(const A& a, const B& b) noexcept
+{
+    using Result = SumType<A, B>;
+    using ValueType = typename Result::ValueType;
+    return Result::FromBits(static_cast<ValueType>(detail::RawBits(Convert<Result>(a)) - detail::RawBits(Convert<Result>(b))));
+}
+
+/**
+ * @brief Converts x to the format Target, e.g. from Q16.16 to Q8.8 or to a higher precision.
+ *
+ * Dropped fractional bits are rounded with the rounding policy of Target, results out of its range
+ * are narrowed with its overflow policy. Gaining fractional bits is exact.
+ */
+template<FixedPoint Target, FixedPoint Source>
+[[nodiscard]] constexpr Target Rescale(const Source& x) noexcept
+{
+    using Wide = detail::ConversionType<Target, Source>;
+    const auto raw = static_cast<Wide>(detail::RawBits(x));
+
+    Wide scaled {raw};
+    if constexpr (Target::kNumFracBits > Source::kNumFracBits)
+    {
+        scaled = static_cast<Wide>(raw * (static_cast<Wide>(1) << (Target::kNumFracBits - Source::kNumFracBits)));
+    }
+    else if constexpr (Target::kNumFracBits < Source::kNumFracBits)
+    {
+        scaled = Target::BoundRoundingType::RoundShift(raw, Source::kNumFracBits - Target::kNumFracBits);
+    }
+    return Target::FromBits(Target::BoundOverflowType::template Narrow<typename Target::ValueType>(scaled));
+}
+
 // Stream operator for convenient printing
-template <Integral IntType, Integral WideType, size_t NumIntBits>
-std::ostream& operator<<(std::ostream& os, const Number<IntType, WideType, NumIntBits>& fp) 
+template <Integral IntType, Integral WideType, size_t NumIntBits, typename Overflow, typename Rounding>
+std::ostream& operator<<(std::ostream& os, const Number<IntType, WideType, NumIntBits, Overflow, Rounding>& fp) 
 {
     os << static_cast<double>(fp);
     return os;
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "fixed_point.hpp"
+#include "profile.hpp"
+#include "simd.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+template<FixedPoint NumberT, typename FloatType>
+constexpr void FromFloatingPoint(std::span<const FloatType> in, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::FromFloats", out.size());
+    std::size_t i {0};
+    if (!std::is_constant_evaluated())
+    {
+        i = simd::detail::FromFloatsKernel<NumberT>(in.data(), out.data(), out.size());
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = NumberT(in[i]);
+    }
+}
+
+template<FixedPoint NumberT, typename FloatType>
+constexpr void ToFloatingPoint(std::span<const NumberT> in, std::span<FloatType> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::ToFloats", out.size());
+    std::size_t i {0};
+    if (!std::is_constant_evaluated())
+    {
+        i = simd::detail::ToFloatsKernel<NumberT>(in.data(), out.data(), out.size());
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = static_cast<FloatType>(in[i]);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Bulk conversion from floats: out[i] = NumberT(in[i]).
+ *
+ * Same results as the converting constructor, rounding and overflow policies included. Vectorized
+ * with cvttps2dq (AVX2) for signed 32-bit and all 16-bit base types, or vcvtq_s32_f32 (NEON) for
+ * signed 32-bit ones, when the overflow policy is fp::Wrap or fp::Saturate and the rounding policy
+ * is fp::Truncate, fp::RoundHalfUp or fp::RoundHalfEven. Other types and policies use the scalar loop.
+ * Processes out.size() elements, in must be at least that long.
+ */
+template<FixedPoint NumberT>
+constexpr void FromFloats(std::span<const float> in, std::span<NumberT> out) noexcept
+{
+    detail::FromFloatingPoint<NumberT, float>(in, out);
+}
+
+// bulk conversion from doubles, vectorized with cvttpd2dq (AVX2) for signed 32-bit base types
+template<FixedPoint NumberT>
+constexpr void FromFloats(std::span<const double> in, std::span<NumberT> out) noexcept
+{
+    detail::FromFloatingPoint<NumberT, double>(in, out);
+}
+
+/**
+ * @brief Bulk conversion to floats: out[i] = static_cast<float>(in[i]).
+ *
+ * Same results as the conversion operator: the integer conversion rounds to nearest and the
+ * scaling by a power of two is exact. Vectorized with cvtdq2ps (AVX2) for signed 32-bit and all
+ * 16-bit base types, or vcvtq_f32_s32 (NEON) for signed 32-bit ones, whatever the policies.
+ * Processes out.size() elements, in must be at least that long.
+ */
+template<FixedPoint NumberT>
+constexpr void ToFloats(std::span<const std::type_identity_t<NumberT>> in, std::span<float> out) noexcept
+{
+    detail::ToFloatingPoint<NumberT, float>(in, out);
+}
+
+// bulk conversion to doubles, vectorized with cvtdq2pd (AVX2) for signed 32-bit base types
+template<FixedPoint NumberT>
+constexpr void ToFloats(std::span<const std::type_identity_t<NumberT>> in, std::span<double> out) noexcept
+{
+    detail::ToFloatingPoint<NumberT, double>(in, out);
+}
+
+}  // namespace fp
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "fixed_point.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+/// @brief Counters of one thread for one instrumentation key. Only the owning thread writes them,
+/// with relaxed loads and stores (plain moves, no locked instructions), snapshots read them from
+/// any thread.
+struct CounterBlock
+{
+    std::atomic<std::uint64_t> overflows {0};
+    std::atomic<std::uint64_t> inexact {0};
+    std::atomic<std::uint64_t> divisions_by_zero {0};
+    std::atomic<std::uint64_t> max_magnitude {0};
+    CounterBlock* next {nullptr};
+};
+
+// counter += n by its only writer
+inline void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t n = 1) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/**
+ * @brief The counter blocks of all threads for Key, in a lock-free list.
+ *
+ * A thread allocates its block on its first count. Blocks are never freed, so the counts of
+ * exited threads stay in the totals: one block per thread and key that ever counted.
+ */
+template<typename Key>
+struct CounterRegistry
+{
+    static inline std::atomic<CounterBlock*> head {nullptr};
+    static inline thread_local CounterBlock* local {nullptr};
+    // used by the threads whose block can't be allocated, its counts may lose concurrent increments
+    static inline CounterBlock shared {};
+
+    [[nodiscard]] static CounterBlock& Local() noexcept
+    {
+        if (local == nullptr) [[unlikely]]
+        {
+            local = Register();
+        }
+        return *local;
+    }
+
+    [[nodiscard]] static CounterBlock* Register() noexcept
+    {
+        auto* block = new (std::nothrow) CounterBlock;
+        if (block == nullptr)
+        {
+            return &shared;
+        }
+        block->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return block;
+    }
+
+    // calls func(block) for every block, the shared one included
+    template<typename Func>
+    static void ForEach(Func func) noexcept
+    {
+        func(shared);
+        for (CounterBlock* block = head.load(std::memory_order_acquire); block != nullptr; block = block->next)
+        {
+            func(*block);
+        }
+    }
+};
+
+// |value| in raw units, saturated to 64 bits, NaN counts as the largest magnitude
+template<typename T>
+[[nodiscard]] constexpr std::uint64_t SaturatedMagnitude(T value) noexcept
+{
+    constexpr auto kMax = std::numeric_limits<std::uint64_t>::max();
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        const T magnitude {value < 0 ? -value : value};
+        return magnitude < static_cast<T>(kMax) ? static_cast<std::uint64_t>(magnitude) : kMax;
+    }
+    else
+    {
+        auto magnitude = static_cast<MakeUnsignedT<T>>(value);
+        if constexpr (std::numeric_limits<T>::is_signed)
+        {
+            magnitude = value < 0 ? static_cast<MakeUnsignedT<T>>(0 - magnitude) : magnitude;
+        }
+        return magnitude < kMax ? static_cast<std::uint64_t>(magnitude) : kMax;
+    }
+}
+
+// counts a narrowing of value to IntType under Key, its magnitude under MaxKey, in the raw units of one format
+template<typename Key, typename MaxKey, typename IntType, typename T>
+inline void RecordNarrowing(T value) noexcept
+{
+    CounterBlock& block = CounterRegistry<Key>::Local();
+    if (AboveRange<IntType>(value) || BelowRange<IntType>(value) || IsNaN(value)) [[unlikely]]
+    {
+        Bump(block.overflows);
+    }
+    // a second thread-local load only for the types that share their counts through a Tag
+    CounterBlock& max_block = std::is_same_v<Key, MaxKey> ? block : CounterRegistry<MaxKey>::Local();
+    const std::uint64_t magnitude {SaturatedMagnitude(value)};
+    if (magnitude > max_block.max_magnitude.load(std::memory_order_relaxed))
+    {
+        max_block.max_magnitude.store(magnitude, std::memory_order_relaxed);
+    }
+}
+
+// counts a rounding that discarded nonzero bits
+template<typename Key>
+inline void RecordInexact(bool inexact) noexcept
+{
+    if (inexact)
+    {
+        Bump(CounterRegistry<Key>::Local().inexact);
+    }
+}
+
+/// @brief Key of the counters of an instrumented policy, void when there is none.
+template<typename Policy>
+struct InstrumentKey
+{
+    using type = void;
+};
+
+template<typename Policy>
+requires requires { typename Policy::InstrumentKeyType; }
+struct InstrumentKey<Policy>
+{
+    using type = typename Policy::InstrumentKeyType;
+};
+
+/**
+ * @brief The overflow policy of Instrumented as a number type applies it: counts under Key, the
+ * largest magnitude under MaxKey, the number type, so that it is in the raw units of one format.
+ */
+template<typename Inner, typename Key, typename MaxKey>
+struct InstrumentedOverflow
+{
+    using InstrumentKeyType = Key;
+
+    template<typename IntType, typename T>
+    [[nodiscard]] static constexpr IntType Narrow(T value) noexcept
+    {
+        if (!std::is_constant_evaluated())
+        {
+            RecordNarrowing<Key, MaxKey, IntType>(value);
+        }
+        return Inner::template Narrow<IntType>(value);
+    }
+
+    // result of a division by zero, before narrowing
+    template<typename IntType, typename T>
+    [[nodiscard]] static constexpr T DivideByZero(T numerator) noexcept
+    {
+        if (!std::is_constant_evaluated())
+        {
+            Bump(CounterRegistry<Key>::Local().divisions_by_zero);
+        }
+        if (numerator == 0)
+        {
+            return T{0};
+        }
+        if constexpr (std::numeric_limits<T>::is_signed)
+        {
+            if (numerator < 0)
+            {
+                return static_cast<T>(std::numeric_limits<IntType>::min());
+            }
+        }
+        return static_cast<T>(std::numeric_limits<IntType>::max());
+    }
+};
+
+/// @brief The rounding policy of InstrumentedRounding as a number type applies it, counts under Key.
+template<typename Inner, typename Key>
+struct InstrumentedRound
+{
+    using InstrumentKeyType = Key;
+
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundShift(T value, std::size_t shift) noexcept
+    {
+        if (!std::is_constant_evaluated())
+        {
+            RecordInexact<Key>((value & static_cast<T>((static_cast<T>(1) << shift) - 1)) != 0);
+        }
+        return Inner::RoundShift(value, shift);
+    }
+
+    template<typename T>
+    [[nodiscard]] static constexpr T RoundQuotient(T quotient, T remainder, T denominator) noexcept
+    {
+        if (!std::is_constant_evaluated())
+        {
+            RecordInexact<Key>(remainder != 0);
+        }
+        return Inner::RoundQuotient(quotient, remainder, denominator);
+    }
+
+    template<std::floating_point T>
+    [[nodiscard]] static constexpr T RoundFloat(T value) noexcept
+    {
+        if (!std::is_constant_evaluated())
+        {
+            RecordInexact<Key>(Floor(value) != value);
+        }
+        return Inner::RoundFloat(value);
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Overflow policy that counts what Inner does, for canary and debug builds.
+ *
+ * Every narrowing (by the arithmetic operators, the constructors, Accumulator::Result(), ...) is
+ * checked per thread: the results out of range, the ones Inner wraps, saturates or traps on, are
+ * counted and the largest magnitude before narrowing is kept. Division by zero is
+ * counted as well, it returns the limit of the sign of the numerator (zero for 0 / 0) instead of
+ * faulting. Read the counts with ReadCounters().
+ *
+ * Every number type has its own counters: it applies Bind<NumberT> (see Number::BoundOverflowType),
+ * keyed by the type. The types that pass the same Tag add up their counts, the largest magnitude
+ * is still kept per type, in its own raw units.
+ *
+ * The results are those of Inner, in constant expressions nothing is counted. The cost is a
+ * thread-local load, a range check and a compare with the largest magnitude per operation (about 1
+ * ns on x86-64, fixed-point-bench S32_16_Instrumented), one more load with a Tag, nothing is
+ * written on the common path. The vector kernels of simd.hpp fall back to the scalar operators.
+ * Not using the policy leaves the code as it is, also see MaybeInstrumented.
+ *
+ * @tparam Inner The overflow policy applied to the results.
+ * @tparam Tag Key of the counts of every type that passes it, shared with an InstrumentedRounding of
+ * the same Tag.
+ */
+template<typename Inner = Wrap, typename Tag = void>
+struct Instrumented : detail::InstrumentedOverflow<Inner, std::conditional_t<std::is_void_v<Tag>, Instrumented<Inner, Tag>, Tag>, Instrumented<Inner, Tag>>
+{
+    // what NumberT applies, counts under NumberT or Tag
+    template<typename NumberT>
+    using Bind = detail::InstrumentedOverflow<Inner, std::conditional_t<std::is_void_v<Tag>, NumberT, Tag>, NumberT>;
+};
+
+/**
+ * @brief Rounding policy that counts the inexact results of Inner: products and floating point
+ * values with discarded nonzero bits, divisions with a remainder.
+ *
+ * Same results, costs and keys as Instrumented, which counts everything else.
+ *
+ * @tparam Inner The rounding policy applied to the results.
+ * @tparam Tag Key of the counts of every type that passes it, shared with an Instrumented of the
+ * same Tag.
+ */
+template<typename Inner = Truncate, typename Tag = void>
+struct InstrumentedRounding : detail::InstrumentedRound<Inner, std::conditional_t<std::is_void_v<Tag>, InstrumentedRounding<Inner, Tag>, Tag>>
+{
+    // what NumberT applies, counts under NumberT or Tag
+    template<typename NumberT>
+    using Bind = detail::InstrumentedRound<Inner, std::conditional_t<std::is_void_v<Tag>, NumberT, Tag>>;
+};
+
+#if defined(FP_INSTRUMENT)
+/// @brief Instrumented<Inner, Tag> when FP_INSTRUMENT is defined, Inner otherwise: one build flag
+/// switches the instrumentation of the types declared with it.
+template<typename Inner, typename Tag = void>
+using MaybeInstrumented = Instrumented<Inner, Tag>;
+
+/// @brief InstrumentedRounding<Inner, Tag> when FP_INSTRUMENT is defined, Inner otherwise.
+template<typename Inner, typename Tag = void>
+using MaybeInstrumentedRounding = InstrumentedRounding<Inner, Tag>;
+#else
+template<typename Inner, typename Tag = void>
+using MaybeInstrumented = Inner;
+
+template<typename Inner, typename Tag = void>
+using MaybeInstrumentedRounding = Inner;
+#endif
+
+/// @brief Counts of an instrumented number type, summed over all threads.
+struct Counters
+{
+    std::uint64_t overflows {0};
+    std::uint64_t inexact {0};
+    std::uint64_t divisions_by_zero {0};
+    // largest magnitude before narrowing to this type alone, in its raw units (saturated to 64 bits) and as a value
+    std::uint64_t max_magnitude {0};
+    double max_value {0.0};
+};
+
+/**
+ * @brief Snapshot of the counters of NumberT, summed over all threads that counted.
+ *
+ * Reads every thread's counters with relaxed loads: cheap (a walk over one small block per
+ * thread), wait-free for the counting threads, and each count is one that was current at some
+ * point during the call. The counts include those of the types sharing a Tag with NumberT, the
+ * largest magnitude doesn't. All zero when NumberT isn't instrumented.
+ */
+template<FixedPoint NumberT>
+[[nodiscard]] Counters ReadCounters() noexcept
+{
+    using OverflowKey = typename detail::InstrumentKey<typename NumberT::BoundOverflowType>::type;
+    using RoundingKey = typename detail::InstrumentKey<typename NumberT::BoundRoundingType>::type;
+
+    Counters counters;
+    const auto add = [&counters](const detail::CounterBlock& block) {
+        counters.overflows += block.overflows.load(std::memory_order_relaxed);
+        counters.inexact += block.inexact.load(std::memory_order_relaxed);
+        counters.divisions_by_zero += block.divisions_by_zero.load(std::memory_order_relaxed);
+    };
+    if constexpr (!std::is_void_v<OverflowKey>)
+    {
+        detail::CounterRegistry<OverflowKey>::ForEach(add);
+        detail::CounterRegistry<NumberT>::ForEach([&counters](const detail::CounterBlock& block) {
+            counters.max_magnitude = std::max(counters.max_magnitude, block.max_magnitude.load(std::memory_order_relaxed));
+        });
+    }
+    if constexpr (!std::is_void_v<RoundingKey> && !std::is_same_v<RoundingKey, OverflowKey>)
+    {
+        detail::CounterRegistry<RoundingKey>::ForEach(add);
+    }
+    counters.max_value = static_cast<double>(counters.max_magnitude) / static_cast<double>(std::uint64_t{1} << NumberT::kNumFracBits);
+    return counters;
+}
+
+/**
+ * @brief Sets the counters of NumberT to zero on all threads.
+ *
+ * Meant for quiescent points (between test cases, after an export): an increment running
+ * concurrently on another thread may overwrite the reset of its own counter. Resets the counts of
+ * the types sharing a Tag with NumberT as well.
+ */
+template<FixedPoint NumberT>
+void ResetCounters() noexcept
+{
+    using OverflowKey = typename detail::InstrumentKey<typename NumberT::BoundOverflowType>::type;
+    using RoundingKey = typename detail::InstrumentKey<typename NumberT::BoundRoundingType>::type;
+
+    const auto reset = [](detail::CounterBlock& block) {
+        block.overflows.store(0, std::memory_order_relaxed);
+        block.inexact.store(0, std::memory_order_relaxed);
+        block.divisions_by_zero.store(0, std::memory_order_relaxed);
+        block.max_magnitude.store(0, std::memory_order_relaxed);
+    };
+    if constexpr (!std::is_void_v<OverflowKey>)
+    {
+        detail::CounterRegistry<OverflowKey>::ForEach(reset);
+        if constexpr (!std::is_same_v<OverflowKey, NumberT>)
+        {
+            detail::CounterRegistry<NumberT>::ForEach(reset);
+        }
+    }
+    if constexpr (!std::is_void_v<RoundingKey> && !std::is_same_v<RoundingKey, OverflowKey>)
+    {
+        detail::CounterRegistry<RoundingKey>::ForEach(reset);
+    }
+}
+
+}  // namespace fp
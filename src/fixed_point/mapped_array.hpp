@@ -0,0 +1,255 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FP_HAS_MMAP 1
+#endif
+
+#include "fixed_point.hpp"
+
+namespace fp
+{
+
+/**
+ * @brief Header of the binary array format.
+ *
+ * A file is this 64-byte header followed by `count` raw values (the bits returned by
+ * Number::FromBits() / stored in value_), in the byte order recorded by big_endian. 64 bytes keep
+ * the values of a mapped file aligned to a cache line. The header fields are stored in the same
+ * byte order as the values. The overflow and rounding policies aren't recorded: they don't change
+ * the bits, a file can be read with any policy.
+ */
+struct ArrayFileHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint8_t value_bits;  // kNumBits of the base type
+    std::uint8_t int_bits;    // kNumIntBits
+    std::uint8_t is_signed;
+    std::uint8_t big_endian;
+    std::uint64_t count;      // number of values after the header
+    std::array<std::uint8_t, 40> reserved;
+};
+
+static_assert(sizeof(ArrayFileHeader) == 64, "fp::ArrayFileHeader must be 64 bytes");
+
+namespace detail
+{
+
+inline constexpr std::array<char, 8> kArrayMagic {'F', 'P', 'A', 'R', 'R', 'A', 'Y', '\0'};
+inline constexpr std::uint32_t kArrayVersion {1};
+
+// value with its bytes in reverse order
+template<Integral T>
+[[nodiscard]] constexpr T ByteSwap(T value) noexcept
+{
+    using UnsignedType = MakeUnsignedT<T>;
+    auto bits = static_cast<UnsignedType>(value);
+    UnsignedType swapped {0};
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        swapped = static_cast<UnsignedType>((swapped << 8) | (bits & 0xFF));
+        bits = static_cast<UnsignedType>(bits >> 8);
+    }
+    return static_cast<T>(swapped);
+}
+
+// true if a file with this header holds values of NumberT, in either byte order
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr bool MatchesFormat(const ArrayFileHeader& header) noexcept
+{
+    const bool swapped {(header.big_endian != 0) != (std::endian::native == std::endian::big)};
+    const std::uint32_t version {swapped ? ByteSwap(header.version) : header.version};
+    return header.magic == kArrayMagic && version == kArrayVersion && header.value_bits == NumberT::kNumBits &&
+           header.int_bits == NumberT::kNumIntBits && (header.is_signed != 0) == NumberT::kIsSigned;
+}
+
+}  // namespace detail
+
+// header for count values of NumberT in the native byte order
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr ArrayFileHeader MakeArrayHeader(std::uint64_t count) noexcept
+{
+    return ArrayFileHeader{detail::kArrayMagic,
+                           detail::kArrayVersion,
+                           static_cast<std::uint8_t>(NumberT::kNumBits),
+                           static_cast<std::uint8_t>(NumberT::kNumIntBits),
+                           static_cast<std::uint8_t>(NumberT::kIsSigned ? 1 : 0),
+                           static_cast<std::uint8_t>(std::endian::native == std::endian::big ? 1 : 0),
+                           count,
+                           {}};
+}
+
+/**
+ * @brief Writes values in the binary array format: the header, then the raw bits as they are in memory.
+ *
+ * No per-element conversion, a write is one copy of the span. Returns false if the stream fails,
+ * or throws if exceptions are enabled on it.
+ */
+template<FixedPoint NumberT>
+[[nodiscard]] bool WriteArray(std::ostream& os, std::span<const std::type_identity_t<NumberT>> values)
+{
+    static_assert(detail::kHasBaseLayout<NumberT>, "fp::Number must have the layout of its base type");
+    const ArrayFileHeader header {MakeArrayHeader<NumberT>(values.size())};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+    return os.good();
+}
+
+#if defined(FP_HAS_MMAP)
+/**
+ * @brief Read-only, memory-mapped array of fixed-point numbers in the binary array format.
+ *
+ * Open() maps the whole file and checks its header against NumberT, nothing is read or copied
+ * until an element is accessed, so opening takes the same time for any file size. Elements are
+ * returned through FromBits(). Files in the native byte order can also be used in place through
+ * Span(), without any copy. Files written on a machine of the other byte order are swapped on
+ * access, Span() is empty for them.
+ *
+ * @tparam NumberT Element type, a specialization of fp::Number.
+ */
+template<FixedPoint NumberT>
+class MappedArray
+{
+public:
+    using value_type = NumberT;
+    using ValueType = typename NumberT::ValueType;
+
+    static_assert(detail::kHasBaseLayout<NumberT>, "fp::Number must have the layout of its base type");
+
+    /**
+     * @brief Factory method, maps the file at path.
+     *
+     * Returns std::nullopt if the file can't be opened or mapped, if its header doesn't describe
+     * values of NumberT (base type width, integer bits, signedness), or if it is shorter than the
+     * header says.
+     */
+    [[nodiscard]] static std::optional<MappedArray> Open(const char* path) noexcept
+    {
+        const int fd {::open(path, O_RDONLY)};
+        if (fd < 0)
+        {
+            return std::nullopt;
+        }
+
+        struct stat info {};
+        void* mapping {MAP_FAILED};
+        std::size_t length {0};
+        if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(ArrayFileHeader))
+        {
+            length = static_cast<std::size_t>(info.st_size);
+            mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            return std::nullopt;
+        }
+
+        MappedArray array(mapping, length);
+        const auto& header = *static_cast<const ArrayFileHeader*>(mapping);
+        if (!detail::MatchesFormat<NumberT>(header))
+        {
+            return std::nullopt;
+        }
+
+        array.swapped_ = (header.big_endian != 0) != (std::endian::native == std::endian::big);
+        const std::uint64_t count {array.swapped_ ? detail::ByteSwap(header.count) : header.count};
+        if (count > (length - sizeof(ArrayFileHeader)) / sizeof(ValueType))
+        {
+            return std::nullopt;
+        }
+        array.size_ = static_cast<std::size_t>(count);
+        return array;
+    }
+
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    MappedArray(MappedArray&& other) noexcept
+        : mapping_{std::exchange(other.mapping_, nullptr)}, length_{std::exchange(other.length_, 0)}, size_{std::exchange(other.size_, 0)},
+          swapped_{other.swapped_}
+    {
+    }
+
+    MappedArray& operator=(MappedArray&& other) noexcept
+    {
+        MappedArray moved(std::move(other));
+        std::swap(mapping_, moved.mapping_);
+        std::swap(length_, moved.length_);
+        std::swap(size_, moved.size_);
+        std::swap(swapped_, moved.swapped_);
+        return *this;
+    }
+
+    ~MappedArray()
+    {
+        if (mapping_ != nullptr)
+        {
+            ::munmap(mapping_, length_);
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // true if the file is in the native byte order, the elements are then usable in place
+    [[nodiscard]] bool IsNativeByteOrder() const noexcept
+    {
+        return !swapped_;
+    }
+
+    // element i, built with FromBits()
+    [[nodiscard]] NumberT operator[](std::size_t i) const noexcept
+    {
+        const ValueType raw {Raw()[i]};
+        return NumberT::FromBits(swapped_ ? detail::ByteSwap(raw) : raw);
+    }
+
+    // raw values as stored in the file
+    [[nodiscard]] std::span<const ValueType> Raw() const noexcept
+    {
+        return {reinterpret_cast<const ValueType*>(static_cast<const std::byte*>(mapping_) + sizeof(ArrayFileHeader)), size_};
+    }
+
+    // the elements in place (e.g. for the fp::simd kernels), empty if the file isn't in the native byte order
+    [[nodiscard]] std::span<const NumberT> Span() const noexcept
+    {
+        if (swapped_)
+        {
+            return {};
+        }
+        return {reinterpret_cast<const NumberT*>(Raw().data()), size_};
+    }
+
+private:
+    MappedArray(void* mapping, std::size_t length) noexcept : mapping_{mapping}, length_{length} {}
+
+    void* mapping_;
+    std::size_t length_;
+    std::size_t size_ {0};
+    bool swapped_ {false};
+};
+#endif
+
+}  // namespace fp
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "profile.hpp"
+
+namespace fp
+{
+
+namespace detail
+{
+
+/// @brief Cache blocking of Gemm(): a block of B is kGemmBlockN columns of kGemmBlockK elements
+/// (64 KiB for 32-bit base types, in L2), a row of A contributes kGemmBlockK elements (in L1).
+inline constexpr std::size_t kGemmBlockK {256};
+inline constexpr std::size_t kGemmBlockN {64};
+inline constexpr std::size_t kGemmBlockM {64};
+
+// sum of lhs(i) * rhs(i) for i in [0, K), rounded once, with the products unrolled
+template<FixedPoint NumberT, std::size_t K, typename Lhs, typename Rhs>
+[[nodiscard]] constexpr NumberT UnrolledDot(Lhs lhs, Rhs rhs) noexcept
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        Accumulator<NumberT> sum;
+        (sum.MulAdd(lhs(I), rhs(I)), ...);
+        return sum.Result();
+    }(std::make_index_sequence<K>{});
+}
+
+// out[i] = op(i) for i in [0, N), unrolled
+template<std::size_t N, typename Array, typename Op>
+constexpr void UnrolledFill(Array&& out, Op op) noexcept
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((out[I] = op(I)), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+}  // namespace detail
+
+/**
+ * @brief Fixed-size vector of fixed-point numbers, stored inline.
+ *
+ * Meant for small sizes (2 to 16 or so): every operation is unrolled at compile time and a Vec
+ * never allocates. Element-wise operations use the scalar Number operators, Dot() sums the exact
+ * products and rounds once. For long, dynamically sized data see fp::Vector.
+ *
+ * @tparam NumberT Element type, a specialization of fp::Number.
+ * @tparam N Number of elements.
+ */
+template<FixedPoint NumberT, std::size_t N>
+class Vec
+{
+public:
+    using value_type = NumberT;
+
+    static constexpr std::size_t kSize {N};
+
+    // constructor, elements are zero
+    constexpr Vec() noexcept {}
+
+    // constructor from the N elements
+    template<std::same_as<NumberT>... Elements>
+    requires (sizeof...(Elements) == N)
+    constexpr Vec(Elements... elements) noexcept : elements_{elements...} {}
+
+    constexpr explicit Vec(const std::array<NumberT, N>& elements) noexcept : elements_{elements} {}
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept
+    {
+        return N;
+    }
+
+    [[nodiscard]] constexpr NumberT& operator[](std::size_t i) noexcept
+    {
+        return elements_[i];
+    }
+
+    [[nodiscard]] constexpr const NumberT& operator[](std::size_t i) const noexcept
+    {
+        return elements_[i];
+    }
+
+    [[nodiscard]] constexpr NumberT* data() noexcept
+    {
+        return elements_.data();
+    }
+
+    [[nodiscard]] constexpr const NumberT* data() const noexcept
+    {
+        return elements_.data();
+    }
+
+    // iterators, a Vec is a contiguous range and converts to std::span
+    [[nodiscard]] constexpr NumberT* begin() noexcept
+    {
+        return elements_.data();
+    }
+
+    [[nodiscard]] constexpr NumberT* end() noexcept
+    {
+        return elements_.data() + N;
+    }
+
+    [[nodiscard]] constexpr const NumberT* begin() const noexcept
+    {
+        return elements_.data();
+    }
+
+    [[nodiscard]] constexpr const NumberT* end() const noexcept
+    {
+        return elements_.data() + N;
+    }
+
+    constexpr Vec& operator+=(const Vec& other) noexcept
+    {
+        detail::UnrolledFill<N>(elements_, [&](std::size_t i) { return elements_[i] + other.elements_[i]; });
+        return *this;
+    }
+
+    constexpr Vec& operator-=(const Vec& other) noexcept
+    {
+        detail::UnrolledFill<N>(elements_, [&](std::size_t i) { return elements_[i] - other.elements_[i]; });
+        return *this;
+    }
+
+    constexpr Vec& operator*=(const NumberT& scalar) noexcept
+    {
+        detail::UnrolledFill<N>(elements_, [&](std::size_t i) { return elements_[i] * scalar; });
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr Vec operator+(Vec lhs, const Vec& rhs) noexcept
+    {
+        return lhs += rhs;
+    }
+
+    [[nodiscard]] friend constexpr Vec operator-(Vec lhs, const Vec& rhs) noexcept
+    {
+        return lhs -= rhs;
+    }
+
+    [[nodiscard]] friend constexpr Vec operator-(const Vec& operand) noexcept
+    {
+        Vec result;
+        detail::UnrolledFill<N>(result.elements_, [&](std::size_t i) { return -operand.elements_[i]; });
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr Vec operator*(Vec lhs, const NumberT& scalar) noexcept
+    {
+        return lhs *= scalar;
+    }
+
+    [[nodiscard]] friend constexpr Vec operator*(const NumberT& scalar, Vec rhs) noexcept
+    {
+        return rhs *= scalar;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const Vec& lhs, const Vec& rhs) noexcept
+    {
+        return lhs.elements_ == rhs.elements_;
+    }
+
+    // sum of a[i] * b[i], rounded and narrowed once like fp::Dot()
+    [[nodiscard]] friend constexpr NumberT Dot(const Vec& a, const Vec& b) noexcept
+    {
+        return detail::UnrolledDot<NumberT, N>([&](std::size_t i) { return a.elements_[i]; }, [&](std::size_t i) { return b.elements_[i]; });
+    }
+
+private:
+    std::array<NumberT, N> elements_;
+};
+
+/**
+ * @brief Fixed-size, row-major matrix of fixed-point numbers, stored inline.
+ *
+ * Like fp::Vec, meant for small sizes (3x3 and 4x4 transforms, Kalman filter states) and unrolled
+ * at compile time. Every element of a matrix product is an exact sum of products rounded and
+ * narrowed once, so `a * b` is as precise as a single multiplication per element, whatever the
+ * inner dimension. For large, dynamically sized matrices see Gemm().
+ *
+ * @tparam NumberT Element type, a specialization of fp::Number.
+ * @tparam Rows Number of rows.
+ * @tparam Cols Number of columns.
+ */
+template<FixedPoint NumberT, std::size_t Rows, std::size_t Cols>
+class Mat
+{
+public:
+    using value_type = NumberT;
+
+    static constexpr std::size_t kRows {Rows};
+    static constexpr std::size_t kCols {Cols};
+
+    // constructor, elements are zero
+    constexpr Mat() noexcept {}
+
+    // constructor from the Rows * Cols elements, row by row
+    template<std::same_as<NumberT>... Elements>
+    requires (sizeof...(Elements) == Rows * Cols)
+    constexpr Mat(Elements... elements) noexcept : elements_{elements...} {}
+
+    // factory method for the identity matrix
+    [[nodiscard]] static constexpr Mat Identity() noexcept
+    requires (Rows == Cols)
+    {
+        Mat result;
+        for (std::size_t i = 0; i < Rows; ++i)
+        {
+            result(i, i) = NumberT::PosOne();
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr NumberT& operator()(std::size_t row, std::size_t col) noexcept
+    {
+        return elements_[row * Cols + col];
+    }
+
+    [[nodiscard]] constexpr const NumberT& operator()(std::size_t row, std::size_t col) const noexcept
+    {
+        return elements_[row * Cols + col];
+    }
+
+    // the elements row by row
+    [[nodiscard]] constexpr std::span<NumberT, Rows * Cols> Elements() noexcept
+    {
+        return elements_;
+    }
+
+    [[nodiscard]] constexpr std::span<const NumberT, Rows * Cols> Elements() const noexcept
+    {
+        return elements_;
+    }
+
+    [[nodiscard]] constexpr Vec<NumberT, Cols> Row(std::size_t row) const noexcept
+    {
+        Vec<NumberT, Cols> result;
+        detail::UnrolledFill<Cols>(result, [&](std::size_t col) { return (*this)(row, col); });
+        return result;
+    }
+
+    [[nodiscard]] constexpr Vec<NumberT, Rows> Col(std::size_t col) const noexcept
+    {
+        Vec<NumberT, Rows> result;
+        detail::UnrolledFill<Rows>(result, [&](std::size_t row) { return (*this)(row, col); });
+        return result;
+    }
+
+    [[nodiscard]] constexpr Mat<NumberT, Cols, Rows> Transposed() const noexcept
+    {
+        Mat<NumberT, Cols, Rows> result;
+        for (std::size_t row = 0; row < Rows; ++row)
+        {
+            for (std::size_t col = 0; col < Cols; ++col)
+            {
+                result(col, row) = (*this)(row, col);
+            }
+        }
+        return result;
+    }
+
+    constexpr Mat& operator+=(const Mat& other) noexcept
+    {
+        detail::UnrolledFill<Rows * Cols>(elements_, [&](std::size_t i) { return elements_[i] + other.elements_[i]; });
+        return *this;
+    }
+
+    constexpr Mat& operator-=(const Mat& other) noexcept
+    {
+        detail::UnrolledFill<Rows * Cols>(elements_, [&](std::size_t i) { return elements_[i] - other.elements_[i]; });
+        return *this;
+    }
+
+    constexpr Mat& operator*=(const NumberT& scalar) noexcept
+    {
+        detail::UnrolledFill<Rows * Cols>(elements_, [&](std::size_t i) { return elements_[i] * scalar; });
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr Mat operator+(Mat lhs, const Mat& rhs) noexcept
+    {
+        return lhs += rhs;
+    }
+
+    [[nodiscard]] friend constexpr Mat operator-(Mat lhs, const Mat& rhs) noexcept
+    {
+        return lhs -= rhs;
+    }
+
+    [[nodiscard]] friend constexpr Mat operator-(const Mat& operand) noexcept
+    {
+        Mat result;
+        detail::UnrolledFill<Rows * Cols>(result.elements_, [&](std::size_t i) { return -operand.elements_[i]; });
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr Mat operator*(Mat lhs, const NumberT& scalar) noexcept
+    {
+        return lhs *= scalar;
+    }
+
+    [[nodiscard]] friend constexpr Mat operator*(const NumberT& scalar, Mat rhs) noexcept
+    {
+        return rhs *= scalar;
+    }
+
+    // matrix product, every element rounded once
+    template<std::size_t OtherCols>
+    [[nodiscard]] friend constexpr Mat<NumberT, Rows, OtherCols> operator*(const Mat& lhs, const Mat<NumberT, Cols, OtherCols>& rhs) noexcept
+    {
+        Mat<NumberT, Rows, OtherCols> result;
+        detail::UnrolledFill<Rows * OtherCols>(result.Elements(), [&](std::size_t i) {
+            const std::size_t row {i / OtherCols};
+            const std::size_t col {i % OtherCols};
+            return detail::UnrolledDot<NumberT, Cols>([&](std::size_t k) { return lhs(row, k); }, [&](std::size_t k) { return rhs(k, col); });
+        });
+        return result;
+    }
+
+    // matrix-vector product, every element rounded once
+    [[nodiscard]] friend constexpr Vec<NumberT, Rows> operator*(const Mat& lhs, const Vec<NumberT, Cols>& rhs) noexcept
+    {
+        Vec<NumberT, Rows> result;
+        detail::UnrolledFill<Rows>(result, [&](std::size_t row) {
+            return detail::UnrolledDot<NumberT, Cols>([&](std::size_t k) { return lhs(row, k); }, [&](std::size_t k) { return rhs[k]; });
+        });
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const Mat& lhs, const Mat& rhs) noexcept
+    {
+        return lhs.elements_ == rhs.elements_;
+    }
+
+private:
+    std::array<NumberT, Rows * Cols> elements_;
+};
+
+namespace detail
+{
+
+// Gemm() with the scratch buffers given: packed holds block_n * k numbers, sums block_m * block_n accumulators
+template<FixedPoint NumberT>
+constexpr void GemmBlocks(std::size_t m, std::size_t n, std::size_t k, std::span<const NumberT> a, std::span<const NumberT> b, std::span<NumberT> c,
+                          std::span<NumberT> packed, std::span<Accumulator<NumberT>> sums) noexcept
+{
+    const std::size_t block_n {std::min(n, kGemmBlockN)};
+    const std::size_t block_m {std::min(m, kGemmBlockM)};
+    for (std::size_t jc = 0; jc < n; jc += block_n)
+    {
+        const std::size_t nb {std::min(block_n, n - jc)};
+        // column jc + j of b becomes row j of packed
+        for (std::size_t p = 0; p < k; ++p)
+        {
+            for (std::size_t j = 0; j < nb; ++j)
+            {
+                packed[j * k + p] = b[p * n + jc + j];
+            }
+        }
+
+        for (std::size_t ic = 0; ic < m; ic += block_m)
+        {
+            const std::size_t mb {std::min(block_m, m - ic)};
+            std::fill_n(sums.begin(), mb * nb, Accumulator<NumberT>{});
+            for (std::size_t pc = 0; pc < k; pc += kGemmBlockK)
+            {
+                const std::size_t kb {std::min(kGemmBlockK, k - pc)};
+                for (std::size_t i = 0; i < mb; ++i)
+                {
+                    const auto row = a.subspan((ic + i) * k + pc, kb);
+                    for (std::size_t j = 0; j < nb; ++j)
+                    {
+                        sums[i * nb + j].MulAdd(row, std::span<const NumberT>(packed).subspan(j * k + pc, kb));
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < mb; ++i)
+            {
+                for (std::size_t j = 0; j < nb; ++j)
+                {
+                    c[(ic + i) * n + jc + j] = sums[i * nb + j].Result();
+                }
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Matrix product c = a * b of dynamically sized, row-major matrices.
+ *
+ * a is m x k, b is k x n and c is m x n. Every element of c is the exact sum of its k products
+ * in an fp::Accumulator, rounded and narrowed once: the result equals fp::Dot() of a row of a and
+ * a column of b, and doesn't depend on the blocking.
+ *
+ * Columns of b are packed into contiguous rows (once per kGemmBlockN columns) and the products
+ * are summed in blocks of kGemmBlockK elements, so the data of the inner loop stays in cache;
+ * each block is one vectorized Accumulator::MulAdd(). Allocates the packed columns of b and
+ * the accumulators of one block of c, see the overload with a memory resource to avoid the heap.
+ */
+template<FixedPoint NumberT>
+constexpr void Gemm(std::size_t m, std::size_t n, std::size_t k, std::span<const std::type_identity_t<NumberT>> a,
+                    std::span<const std::type_identity_t<NumberT>> b, std::span<NumberT> c)
+{
+    FP_PROFILE_SCOPE("fp::Gemm", m * n * k);
+    std::vector<NumberT> packed(std::min(n, detail::kGemmBlockN) * k);
+    std::vector<Accumulator<NumberT>> sums(std::min(m, detail::kGemmBlockM) * std::min(n, detail::kGemmBlockN));
+    detail::GemmBlocks<NumberT>(m, n, k, a, b, c, packed, sums);
+}
+
+/**
+ * @brief Gemm() with its scratch buffers, GemmScratchBytes() in total, allocated from resource,
+ * e.g. an fp::FrameArena (memory.hpp).
+ */
+template<FixedPoint NumberT>
+void Gemm(std::size_t m, std::size_t n, std::size_t k, std::span<const std::type_identity_t<NumberT>> a,
+          std::span<const std::type_identity_t<NumberT>> b, std::span<NumberT> c, std::pmr::memory_resource* resource)
+{
+    FP_PROFILE_SCOPE("fp::Gemm", m * n * k);
+    std::pmr::vector<NumberT> packed(std::min(n, detail::kGemmBlockN) * k, resource);
+    std::pmr::vector<Accumulator<NumberT>> sums(std::min(m, detail::kGemmBlockM) * std::min(n, detail::kGemmBlockN), resource);
+    detail::GemmBlocks<NumberT>(m, n, k, a, b, c, packed, sums);
+}
+
+// bytes Gemm() allocates for the given sizes, with the alignment padding of an arena
+template<FixedPoint NumberT>
+[[nodiscard]] constexpr std::size_t GemmScratchBytes(std::size_t m, std::size_t n, std::size_t k) noexcept
+{
+    const std::size_t block_n {std::min(n, detail::kGemmBlockN)};
+    return block_n * k * sizeof(NumberT) + alignof(NumberT) + std::min(m, detail::kGemmBlockM) * block_n * sizeof(Accumulator<NumberT>) +
+           alignof(Accumulator<NumberT>);
+}
+
+}  // namespace fp
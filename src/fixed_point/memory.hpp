@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+
+namespace fp
+{
+
+/**
+ * @brief Monotonic arena over a fixed buffer, released as a whole by Reset().
+ *
+ * For threads that must not call malloc: the arena hands out memory by bumping a pointer through a
+ * buffer they own, and Reset() releases all of it at once, e.g. at the start of every audio frame.
+ * FixedPool serves buffers that are released in any order. Both are std::pmr::memory_resource, so
+ * std::pmr containers can use them, as can fp::Vector and fp::Gemm() through their memory resource
+ * parameter. Allocations and deallocations are O(1), as is Reset() of an arena, and never lock or
+ * call the system allocator. A resource is used by one thread at a time.
+ *
+ * When the buffer is exhausted, allocate() throws std::bad_alloc as the memory resources of the
+ * standard library do, TryAllocate() returns nullptr instead. The engines that hold their state
+ * inline (fp::FFT, fp::FIR, fp::Biquad, fp::Vec, fp::Mat) never allocate.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    // constructor, the arena uses buffer, which must outlive it
+    explicit FrameArena(std::span<std::byte> buffer) noexcept : begin_{buffer.data()}, size_{buffer.size()} {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // bytes bytes aligned to alignment (a power of two), nullptr when they don't fit
+    [[nodiscard]] void* TryAllocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        void* p {begin_ + used_};
+        std::size_t space {size_ - used_};
+        if (std::align(alignment, bytes, p, space) == nullptr)
+        {
+            return nullptr;
+        }
+        used_ = size_ - space + bytes;
+        peak_ = used_ > peak_ ? used_ : peak_;
+        return p;
+    }
+
+    // releases every allocation
+    void Reset() noexcept
+    {
+        used_ = 0;
+    }
+
+    // bytes in use, alignment padding included
+    [[nodiscard]] std::size_t Used() const noexcept
+    {
+        return used_;
+    }
+
+    // largest Used() since construction, to size the buffer
+    [[nodiscard]] std::size_t Peak() const noexcept
+    {
+        return peak_;
+    }
+
+    [[nodiscard]] std::size_t Capacity() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        void* p {TryAllocate(bytes, alignment)};
+        if (p == nullptr) [[unlikely]]
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    // memory is only released by Reset()
+    void do_deallocate(void* /* p */, std::size_t /* bytes */, std::size_t /* alignment */) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::byte* begin_;
+    std::size_t size_;
+    std::size_t used_ {0};
+    std::size_t peak_ {0};
+};
+
+/**
+ * @brief Pool of equal, aligned blocks over a fixed buffer, released one by one in any order.
+ *
+ * A free block holds the pointer to the next free one, so allocate() and deallocate() are a pop
+ * and a push. Requests larger than a block, or aligned more strictly than the blocks, don't fit.
+ * Reset() rebuilds the free list, linear in the number of blocks.
+ */
+class FixedPool : public std::pmr::memory_resource
+{
+public:
+    // default alignment of the blocks, one cache line as the storage of fp::Vector
+    static constexpr std::size_t kDefaultAlignment {64};
+
+    // constructor, as many blocks of block_size bytes as buffer holds, buffer must outlive the pool
+    FixedPool(std::span<std::byte> buffer, std::size_t block_size, std::size_t block_alignment = kDefaultAlignment) noexcept
+        : alignment_{block_alignment}, block_size_{RoundUp(block_size < sizeof(Block) ? sizeof(Block) : block_size, block_alignment)}
+    {
+        void* p {buffer.data()};
+        std::size_t space {buffer.size()};
+        if (std::align(alignment_, block_size_, p, space) != nullptr)
+        {
+            begin_ = static_cast<std::byte*>(p);
+            count_ = space / block_size_;
+        }
+        Reset();
+    }
+
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+
+    // a block for bytes bytes aligned to alignment, nullptr when none is free or the request doesn't fit a block
+    [[nodiscard]] void* TryAllocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        if (free_ == nullptr || bytes > block_size_ || alignment > alignment_) [[unlikely]]
+        {
+            return nullptr;
+        }
+        Block* block {free_};
+        free_ = block->next;
+        ++used_;
+        return block;
+    }
+
+    // returns a block of TryAllocate()
+    void Release(void* p) noexcept
+    {
+        auto* block = ::new (p) Block{free_};
+        free_ = block;
+        --used_;
+    }
+
+    // releases every block
+    void Reset() noexcept
+    {
+        free_ = nullptr;
+        for (std::size_t i = count_; i > 0; --i)
+        {
+            free_ = ::new (begin_ + (i - 1) * block_size_) Block{free_};
+        }
+        used_ = 0;
+    }
+
+    // size of a block, the requested size rounded up to the alignment
+    [[nodiscard]] std::size_t BlockSize() const noexcept
+    {
+        return block_size_;
+    }
+
+    [[nodiscard]] std::size_t BlockCount() const noexcept
+    {
+        return count_;
+    }
+
+    // blocks in use
+    [[nodiscard]] std::size_t Used() const noexcept
+    {
+        return used_;
+    }
+
+private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    [[nodiscard]] static constexpr std::size_t RoundUp(std::size_t value, std::size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        void* p {TryAllocate(bytes, alignment)};
+        if (p == nullptr) [[unlikely]]
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void do_deallocate(void* p, std::size_t /* bytes */, std::size_t /* alignment */) override
+    {
+        Release(p);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::size_t alignment_;
+    std::size_t block_size_;
+    std::byte* begin_ {nullptr};
+    std::size_t count_ {0};
+    std::size_t used_ {0};
+    Block* free_ {nullptr};
+};
+
+/**
+ * @brief Buffer of Bytes bytes for a FrameArena or FixedPool, e.g. a static or a member of the
+ * object that owns the real-time thread.
+ */
+template<std::size_t Bytes>
+struct alignas(64) ArenaBuffer
+{
+    std::array<std::byte, Bytes> bytes;
+
+    [[nodiscard]] std::span<std::byte> Span() noexcept
+    {
+        return bytes;
+    }
+};
+
+}  // namespace fp
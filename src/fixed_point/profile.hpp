@@ -0,0 +1,474 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#endif
+
+namespace fp
+{
+
+/**
+ * @brief Current value of the cycle counter: rdtsc on x86, the virtual counter cntvct_el0 on
+ * AArch64, steady_clock nanoseconds elsewhere.
+ *
+ * Not serializing: a few cycles of the code around it may execute on either side of the read,
+ * which only matters for regions of a few dozen cycles.
+ */
+[[nodiscard]] inline std::uint64_t ReadCycleCounter() noexcept
+{
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    return __rdtsc();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    std::uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @brief Ticks of ReadCycleCounter() per second.
+ *
+ * cntfrq_el0 on AArch64. The TSC of x86 has no architectural frequency register, it is measured
+ * against steady_clock over 10 ms on the first call (the TSC of every x86-64 CPU of the last
+ * decade runs at a constant rate, whatever the clock of the core).
+ */
+[[nodiscard]] inline double CycleCounterFrequency() noexcept
+{
+    static const double frequency = [] {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        const std::uint64_t start_ticks {ReadCycleCounter()};
+        auto now = start;
+        while (now - start < std::chrono::milliseconds(10))
+        {
+            now = Clock::now();
+        }
+        const std::uint64_t ticks {ReadCycleCounter() - start_ticks};
+        return static_cast<double>(ticks) / std::chrono::duration<double>(now - start).count();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        std::uint64_t ticks_per_second;
+        __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(ticks_per_second));
+        return static_cast<double>(ticks_per_second);
+#else
+        return 1e9;
+#endif
+    }();
+    return frequency;
+}
+
+namespace detail
+{
+
+// distinct regions per thread, a power of two
+inline constexpr std::size_t kProfileRegions {256};
+
+// trace events kept per thread, the later ones are only counted in the totals
+inline constexpr std::size_t kProfileEvents {std::size_t{1} << 16};
+
+/// @brief Totals of one region on one thread. Only the owning thread writes them, with relaxed
+/// loads and stores, as the counters of instrument.hpp.
+struct ProfileTotals
+{
+    std::atomic<const char*> name {nullptr};
+    std::atomic<std::uint64_t> calls {0};
+    std::atomic<std::uint64_t> elements {0};
+    std::atomic<std::uint64_t> cycles {0};
+    std::atomic<std::uint64_t> max_cycles {0};
+};
+
+// one execution of a region, for the trace
+struct ProfileEvent
+{
+    const char* name;
+    std::uint64_t begin;
+    std::uint64_t cycles;
+    std::uint64_t elements;
+};
+
+/**
+ * @brief Profile of one thread: the totals per region in an open-addressing table keyed by the
+ * address of the name, and the first kProfileEvents executions for the trace.
+ *
+ * An event is written before the release store of the new size, so readers see complete events.
+ */
+struct ProfileBuffer
+{
+    std::array<ProfileTotals, kProfileRegions> totals {};
+    std::unique_ptr<ProfileEvent[]> events;
+    std::atomic<std::size_t> size {0};
+    // executions missing from the trace, or from the totals when the table is full
+    std::atomic<std::uint64_t> dropped {0};
+    std::uint64_t thread {0};
+    ProfileBuffer* next {nullptr};
+
+    // counter += n by its only writer
+    static void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t n = 1) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    // the totals of name, claims a free slot on its first execution, nullptr when the table is full
+    [[nodiscard]] ProfileTotals* Find(const char* name) noexcept
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(name);
+        std::size_t slot {static_cast<std::size_t>((static_cast<std::uint64_t>(address) * 0x9E3779B97F4A7C15ULL) >> (64 - std::countr_zero(kProfileRegions)))};
+        for (std::size_t probe = 0; probe < kProfileRegions; ++probe, ++slot)
+        {
+            ProfileTotals& region = totals[slot % kProfileRegions];
+            const char* owner {region.name.load(std::memory_order_relaxed)};
+            if (owner == name)
+            {
+                return &region;
+            }
+            if (owner == nullptr)
+            {
+                region.name.store(name, std::memory_order_release);
+                return &region;
+            }
+        }
+        return nullptr;
+    }
+
+    void Record(const char* name, std::uint64_t begin, std::uint64_t cycles, std::uint64_t count) noexcept
+    {
+        ProfileTotals* region {Find(name)};
+        if (region == nullptr) [[unlikely]]
+        {
+            Bump(dropped);
+            return;
+        }
+        Bump(region->calls);
+        Bump(region->elements, count);
+        Bump(region->cycles, cycles);
+        if (cycles > region->max_cycles.load(std::memory_order_relaxed))
+        {
+            region->max_cycles.store(cycles, std::memory_order_relaxed);
+        }
+
+        const std::size_t n {size.load(std::memory_order_relaxed)};
+        if (n < kProfileEvents && events != nullptr) [[likely]]
+        {
+            events[n] = {name, begin, cycles, count};
+            size.store(n + 1, std::memory_order_release);
+        }
+        else
+        {
+            Bump(dropped);
+        }
+    }
+};
+
+/**
+ * @brief The profile buffers of all threads, in a lock-free list.
+ *
+ * A thread allocates its buffer on its first region: about 2.2 MB, most of it the trace events.
+ * Buffers are never freed, so the profiles of exited threads stay in the reports.
+ */
+struct ProfileRegistry
+{
+    static inline std::atomic<ProfileBuffer*> head {nullptr};
+    static inline std::atomic<std::uint64_t> threads {0};
+    static inline thread_local ProfileBuffer* local {nullptr};
+
+    // the buffer of the calling thread, nullptr when it can't be allocated
+    [[nodiscard]] static ProfileBuffer* Local() noexcept
+    {
+        if (local == nullptr) [[unlikely]]
+        {
+            local = Register();
+        }
+        return local;
+    }
+
+    [[nodiscard]] static ProfileBuffer* Register() noexcept
+    {
+        auto* buffer = new (std::nothrow) ProfileBuffer;
+        if (buffer == nullptr)
+        {
+            return nullptr;
+        }
+        // without trace events the totals are still counted
+        buffer->events.reset(new (std::nothrow) ProfileEvent[kProfileEvents]);
+        buffer->thread = threads.fetch_add(1, std::memory_order_relaxed) + 1;
+        buffer->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return buffer;
+    }
+
+    // calls func(buffer) for every buffer
+    template<typename Func>
+    static void ForEach(Func func) noexcept
+    {
+        for (ProfileBuffer* buffer = head.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next)
+        {
+            func(*buffer);
+        }
+    }
+};
+
+// writes text as the contents of a JSON string
+inline void WriteJsonString(std::ostream& out, std::string_view text)
+{
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            out << ' ';
+        }
+        else
+        {
+            out << c;
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Scoped profiling region: records its cycles, a call and an element count into the profile
+ * of the calling thread when it ends.
+ *
+ * The name must be a string with static storage duration (a literal), regions are told apart by
+ * its address and merged by its text in the reports. Regions nest, the cycles of a region include
+ * the ones of the regions inside it. The cost is two reads of the cycle counter, a thread-local
+ * lookup and a few stores, some 50 ns on x86-64 (fixed-point-bench-profile against
+ * fixed-point-bench); the buffer of a thread is allocated by its first region. Nothing is
+ * recorded in constant expressions.
+ *
+ * The batch kernels and engines of the library (fp::simd, fp::FromFloats / fp::ToFloats,
+ * fp::FFT, fp::FIR, fp::Biquad, fp::Gemm, ...) open a region per call when FP_PROFILE is
+ * defined, see FP_PROFILE_SCOPE. Read the results with ReadProfile(), WriteProfileSummary() and
+ * WriteChromeTrace().
+ */
+class ProfileRegion
+{
+public:
+    // constructor, starts the region, elements is the amount of work it counts, e.g. samples
+    constexpr explicit ProfileRegion(const char* name, std::size_t elements = 0) noexcept : name_{name}, elements_{elements}
+    {
+        if (!std::is_constant_evaluated())
+        {
+            begin_ = ReadCycleCounter();
+        }
+    }
+
+    ProfileRegion(const ProfileRegion&) = delete;
+    ProfileRegion& operator=(const ProfileRegion&) = delete;
+
+    // ends the region
+    constexpr ~ProfileRegion()
+    {
+        if (!std::is_constant_evaluated())
+        {
+            const std::uint64_t end {ReadCycleCounter()};
+            if (detail::ProfileBuffer* buffer = detail::ProfileRegistry::Local(); buffer != nullptr)
+            {
+                buffer->Record(name_, begin_, end - begin_, elements_);
+            }
+        }
+    }
+
+    // sets the element count, when it is only known at the end of the region
+    constexpr void SetElements(std::size_t elements) noexcept
+    {
+        elements_ = elements;
+    }
+
+private:
+    const char* name_;
+    std::uint64_t begin_ {0};
+    std::size_t elements_;
+};
+
+#define FP_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FP_PROFILE_CONCAT(a, b) FP_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(FP_PROFILE)
+/// @brief fp::ProfileRegion until the end of the scope when FP_PROFILE is defined, nothing
+/// otherwise: one build flag switches the hooks of the library and the ones of the application.
+#define FP_PROFILE_SCOPE(name, elements) const ::fp::ProfileRegion FP_PROFILE_CONCAT(fp_profile_region_, __LINE__)(name, elements)
+#else
+#define FP_PROFILE_SCOPE(name, elements) static_cast<void>(0)
+#endif
+
+/// @brief Totals of one region, summed over all threads.
+struct ProfileEntry
+{
+    std::string name;
+    std::uint64_t calls {0};
+    std::uint64_t elements {0};
+    std::uint64_t cycles {0};
+    std::uint64_t max_cycles {0};
+};
+
+/**
+ * @brief Snapshot of the profile: the totals of every region over all threads, the most cycles
+ * first.
+ *
+ * Reads every thread's totals with relaxed loads, wait-free for the profiled threads, as
+ * ReadCounters(). Allocates, not for real-time threads.
+ */
+[[nodiscard]] inline std::vector<ProfileEntry> ReadProfile()
+{
+    std::vector<ProfileEntry> entries;
+    detail::ProfileRegistry::ForEach([&entries](const detail::ProfileBuffer& buffer) {
+        for (const auto& totals : buffer.totals)
+        {
+            const char* name {totals.name.load(std::memory_order_acquire)};
+            const std::uint64_t calls {totals.calls.load(std::memory_order_relaxed)};
+            if (name == nullptr || calls == 0)
+            {
+                continue;
+            }
+            auto entry = std::find_if(entries.begin(), entries.end(), [name](const ProfileEntry& e) { return e.name == name; });
+            if (entry == entries.end())
+            {
+                entry = entries.insert(entries.end(), ProfileEntry{name});
+            }
+            entry->calls += calls;
+            entry->elements += totals.elements.load(std::memory_order_relaxed);
+            entry->cycles += totals.cycles.load(std::memory_order_relaxed);
+            entry->max_cycles = std::max(entry->max_cycles, totals.max_cycles.load(std::memory_order_relaxed));
+        }
+    });
+    std::sort(entries.begin(), entries.end(), [](const ProfileEntry& a, const ProfileEntry& b) { return a.cycles > b.cycles; });
+    return entries;
+}
+
+// executions of all threads missing from the trace (or, when a thread has too many regions, from the totals)
+[[nodiscard]] inline std::uint64_t DroppedProfileEvents() noexcept
+{
+    std::uint64_t dropped {0};
+    detail::ProfileRegistry::ForEach([&dropped](const detail::ProfileBuffer& buffer) { dropped += buffer.dropped.load(std::memory_order_relaxed); });
+    return dropped;
+}
+
+/**
+ * @brief Writes ReadProfile() as a table: calls, elements, total time, cycles per call and per
+ * element, longest call.
+ */
+inline void WriteProfileSummary(std::ostream& out)
+{
+    const auto entries = ReadProfile();
+    const double frequency {CycleCounterFrequency()};
+    std::size_t width {6};
+    for (const auto& entry : entries)
+    {
+        width = std::max(width, entry.name.size());
+    }
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::left << std::setw(static_cast<int>(width)) << "region" << std::right << std::setw(12) << "calls" << std::setw(14) << "elements" << std::setw(12)
+        << "total ms" << std::setw(14) << "cycles/call" << std::setw(14) << "cycles/elem" << std::setw(14) << "max cycles" << '\n';
+    out << std::fixed;
+    for (const auto& entry : entries)
+    {
+        const double cycles {static_cast<double>(entry.cycles)};
+        out << std::left << std::setw(static_cast<int>(width)) << entry.name << std::right << std::setw(12) << entry.calls << std::setw(14) << entry.elements
+            << std::setprecision(3) << std::setw(12) << cycles / frequency * 1e3 << std::setprecision(1) << std::setw(14)
+            << cycles / static_cast<double>(entry.calls) << std::setw(14);
+        if (entry.elements != 0)
+        {
+            out << std::setprecision(2) << cycles / static_cast<double>(entry.elements);
+        }
+        else
+        {
+            out << '-';
+        }
+        out << std::setw(14) << entry.max_cycles << '\n';
+    }
+    out << "counter: " << std::setprecision(0) << frequency << " ticks/s, dropped trace events: " << DroppedProfileEvents() << '\n';
+    out.flags(flags);
+    out.precision(precision);
+}
+
+/**
+ * @brief Writes the recorded executions as a Chrome trace (JSON "complete" events), for
+ * chrome://tracing, ui.perfetto.dev or speedscope.
+ *
+ * One track per thread, times in microseconds from the first recorded execution, the element
+ * count as an argument of every event. Holds the first executions of each thread, see
+ * DroppedProfileEvents() for the rest. Meant for quiescent points, as ResetProfile().
+ */
+inline void WriteChromeTrace(std::ostream& out)
+{
+    std::uint64_t origin {~std::uint64_t{0}};
+    detail::ProfileRegistry::ForEach([&origin](const detail::ProfileBuffer& buffer) {
+        const std::size_t size {buffer.size.load(std::memory_order_acquire)};
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            origin = std::min(origin, buffer.events[i].begin);
+        }
+    });
+    const double microseconds_per_tick {1e6 / CycleCounterFrequency()};
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first {true};
+    detail::ProfileRegistry::ForEach([&](const detail::ProfileBuffer& buffer) {
+        const std::size_t size {buffer.size.load(std::memory_order_acquire)};
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const detail::ProfileEvent& event = buffer.events[i];
+            out << (first ? "\n" : ",\n") << "{\"name\":\"";
+            detail::WriteJsonString(out, event.name);
+            out << "\",\"cat\":\"fp\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.thread << ",\"ts\":" << static_cast<double>(event.begin - origin) * microseconds_per_tick
+                << ",\"dur\":" << static_cast<double>(event.cycles) * microseconds_per_tick << ",\"args\":{\"elements\":" << event.elements << "}}";
+            first = false;
+        }
+    });
+    out << "\n]}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+/**
+ * @brief Clears the totals and trace events of all threads.
+ *
+ * Meant for quiescent points (between benchmarks, after a dump): a region ending concurrently on
+ * another thread may be lost or overwrite the reset.
+ */
+inline void ResetProfile() noexcept
+{
+    detail::ProfileRegistry::ForEach([](detail::ProfileBuffer& buffer) {
+        for (auto& totals : buffer.totals)
+        {
+            totals.calls.store(0, std::memory_order_relaxed);
+            totals.elements.store(0, std::memory_order_relaxed);
+            totals.cycles.store(0, std::memory_order_relaxed);
+            totals.max_cycles.store(0, std::memory_order_relaxed);
+        }
+        buffer.size.store(0, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+    });
+}
+
+}  // namespace fp
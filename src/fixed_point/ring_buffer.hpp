@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <utility>
+
+#include "fixed_point.hpp"
+#include "vector.hpp"
+
+namespace fp
+{
+
+/**
+ * @brief Lock-free single-producer / single-consumer queue of fixed-point samples.
+ *
+ * One thread writes, another one reads, neither ever waits or locks. Instead of copying samples
+ * in and out, each side gets the contiguous part of the buffer it may access as a span: the
+ * producer fills WriteRegion() (e.g. with a DMA transfer into fp::AsBits() of it, or as the output
+ * of a batch kernel) and publishes it with CommitWrite(), the consumer processes ReadRegion() in
+ * place and frees it with CommitRead(). A region ends at the end of the buffer, the rest of the
+ * data is in the region returned after the commit.
+ *
+ * The read and write positions are free-running counters, each in its own cache line next to the
+ * side's cached copy of the other position, so a side only touches the other's cache line when its
+ * cached view runs out of data or space. Committing is one release store, reading the other
+ * position one acquire load.
+ *
+ * The storage is an fp::Vector: owned (from operator new or a memory resource, see memory.hpp) or
+ * a view of external memory. Its size, the capacity, is a power of two.
+ *
+ * @tparam NumberT The fixed point number type.
+ */
+template<FixedPoint NumberT>
+class RingBuffer
+{
+public:
+    // constructor, owned storage for capacity samples rounded up to a power of two, from resource (nullptr: operator new)
+    explicit RingBuffer(std::size_t capacity, std::pmr::memory_resource* resource = nullptr)
+        : RingBuffer(Vector<NumberT>(std::bit_ceil(capacity), resource))
+    {
+    }
+
+    // constructor, takes storage of a power of two size, e.g. Vector<NumberT>::View() of a DMA buffer
+    explicit RingBuffer(Vector<NumberT> storage) noexcept : storage_{std::move(storage)}, mask_{storage_.size() - 1}
+    {
+        // the positions are mapped to slots with the mask, any other size (zero included) would mix up the data
+        assert(std::has_single_bit(storage_.size()) && "fp::RingBuffer storage must have a power of two size");
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // producer: the free samples up to the end of the buffer, to be filled then published with CommitWrite()
+    [[nodiscard]] std::span<NumberT> WriteRegion() noexcept
+    {
+        const std::size_t write {producer_.position.load(std::memory_order_relaxed)};
+        if (write - producer_.cached_other == Capacity())
+        {
+            producer_.cached_other = consumer_.position.load(std::memory_order_acquire);
+        }
+        const std::size_t offset {write & mask_};
+        const std::size_t free {Capacity() - (write - producer_.cached_other)};
+        return {storage_.data() + offset, std::min(free, Capacity() - offset)};
+    }
+
+    // producer: publishes the first n samples of WriteRegion()
+    void CommitWrite(std::size_t n) noexcept
+    {
+        producer_.position.store(producer_.position.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    // consumer: the available samples up to the end of the buffer, to be processed then freed with CommitRead()
+    [[nodiscard]] std::span<NumberT> ReadRegion() noexcept
+    {
+        const std::size_t read {consumer_.position.load(std::memory_order_relaxed)};
+        if (read == consumer_.cached_other)
+        {
+            consumer_.cached_other = producer_.position.load(std::memory_order_acquire);
+        }
+        const std::size_t offset {read & mask_};
+        const std::size_t available {consumer_.cached_other - read};
+        return {storage_.data() + offset, std::min(available, Capacity() - offset)};
+    }
+
+    // consumer: frees the first n samples of ReadRegion()
+    void CommitRead(std::size_t n) noexcept
+    {
+        consumer_.position.store(consumer_.position.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    // producer: copies as many samples of in as fit (in up to two regions), returns their number
+    std::size_t Push(std::span<const NumberT> in) noexcept
+    {
+        std::size_t done {0};
+        while (done < in.size())
+        {
+            const auto region = WriteRegion();
+            const std::size_t n {std::min(region.size(), in.size() - done)};
+            if (n == 0)
+            {
+                break;
+            }
+            std::copy_n(in.data() + done, n, region.data());
+            CommitWrite(n);
+            done += n;
+        }
+        return done;
+    }
+
+    // consumer: copies as many samples as are available into out, returns their number
+    std::size_t Pop(std::span<NumberT> out) noexcept
+    {
+        std::size_t done {0};
+        while (done < out.size())
+        {
+            const auto region = ReadRegion();
+            const std::size_t n {std::min(region.size(), out.size() - done)};
+            if (n == 0)
+            {
+                break;
+            }
+            std::copy_n(region.data(), n, out.data() + done);
+            CommitRead(n);
+            done += n;
+        }
+        return done;
+    }
+
+    // number of samples stored, exact only on a quiescent queue
+    [[nodiscard]] std::size_t Size() const noexcept
+    {
+        return producer_.position.load(std::memory_order_acquire) - consumer_.position.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return Size() == 0;
+    }
+
+    [[nodiscard]] std::size_t Capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+private:
+    // the position of one side and its last seen value of the other side's, alone in a cache line
+    struct alignas(kVectorAlignment) Side
+    {
+        std::atomic<std::size_t> position {0};
+        std::size_t cached_other {0};
+    };
+
+    static_assert(std::atomic<std::size_t>::is_always_lock_free, "fp::RingBuffer needs lock-free atomic positions");
+
+    Vector<NumberT> storage_;
+    std::size_t mask_;
+    Side producer_;
+    Side consumer_;
+};
+
+}  // namespace fp
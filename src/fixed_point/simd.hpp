@@ -0,0 +1,1080 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "fixed_point.hpp"
+#include "profile.hpp"
+
+namespace fp::simd
+{
+
+namespace detail
+{
+
+/// @brief Concept: NumberT has a 32-bit base type widened to 64 bits, which is what the vector kernels handle.
+template<typename NumberT>
+concept Vectorizable32 = (sizeof(typename NumberT::ValueType) == 4) && (sizeof(typename NumberT::WideValueType) == 8);
+
+/// @brief Concept: NumberT has a 16-bit base type widened to 32 bits.
+template<typename NumberT>
+concept Vectorizable16 = (sizeof(typename NumberT::ValueType) == 2) && (sizeof(typename NumberT::WideValueType) == 4);
+
+/// @brief Concept: NumberT wraps on overflow and truncates products, the multiply kernels only match the scalar operator then.
+template<typename NumberT>
+concept WrappingTruncating = std::is_same_v<typename NumberT::OverflowType, Wrap> && std::is_same_v<typename NumberT::RoundingType, Truncate>;
+
+/// @brief Concept: NumberT saturates on overflow, its additions map onto the saturating vector instructions.
+template<typename NumberT>
+concept Saturating = std::is_same_v<typename NumberT::OverflowType, Saturate>;
+
+#if defined(__AVX512F__)
+// 16 lanes of (a * b) >> kNumFracBits for 32-bit base types
+template<FixedPoint NumberT>
+inline __m512i Mul32x16(__m512i a, __m512i b) noexcept
+{
+    constexpr unsigned int kShift = NumberT::kNumFracBits;
+
+    // the zero-masked forms avoid GCC's false -Wmaybe-uninitialized on the unmasked intrinsics
+    constexpr __mmask8 kAll {0xFF};
+
+    // even lanes: the 64-bit product is in place, only its low 32 bits are kept
+    const __m512i even = NumberT::kIsSigned ? _mm512_maskz_mul_epi32(kAll, a, b) : _mm512_maskz_mul_epu32(kAll, a, b);
+
+    // odd lanes: move the operands down, then move bits [shift, shift + 32) of the product into the upper half
+    const __m512i a_odd = _mm512_maskz_srli_epi64(kAll, a, 32);
+    const __m512i b_odd = _mm512_maskz_srli_epi64(kAll, b, 32);
+    const __m512i odd = NumberT::kIsSigned ? _mm512_maskz_mul_epi32(kAll, a_odd, b_odd) : _mm512_maskz_mul_epu32(kAll, a_odd, b_odd);
+
+    return _mm512_mask_blend_epi32(0xAAAA, _mm512_maskz_srli_epi64(kAll, even, kShift), _mm512_maskz_slli_epi64(kAll, odd, 32 - kShift));
+}
+#endif
+
+#if defined(__AVX2__)
+// 8 lanes of (a * b) >> kNumFracBits for 32-bit base types
+template<FixedPoint NumberT>
+inline __m256i Mul32x8(__m256i a, __m256i b) noexcept
+{
+    constexpr int kShift = NumberT::kNumFracBits;
+
+    const __m256i even = NumberT::kIsSigned ? _mm256_mul_epi32(a, b) : _mm256_mul_epu32(a, b);
+
+    const __m256i a_odd = _mm256_srli_epi64(a, 32);
+    const __m256i b_odd = _mm256_srli_epi64(b, 32);
+    const __m256i odd = NumberT::kIsSigned ? _mm256_mul_epi32(a_odd, b_odd) : _mm256_mul_epu32(a_odd, b_odd);
+
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, kShift), _mm256_slli_epi64(odd, 32 - kShift), 0xAA);
+}
+
+// 16 lanes of (a * b) >> kNumFracBits for 16-bit base types
+template<FixedPoint NumberT>
+inline __m256i Mul16x16(__m256i a, __m256i b) noexcept
+{
+    constexpr int kShift = NumberT::kNumFracBits;
+
+    // the 32-bit product is split into its low and high halves, recombine the bits [shift, shift + 16)
+    const __m256i lo = _mm256_mullo_epi16(a, b);
+    const __m256i hi = NumberT::kIsSigned ? _mm256_mulhi_epi16(a, b) : _mm256_mulhi_epu16(a, b);
+
+    return _mm256_or_si256(_mm256_srli_epi16(lo, kShift), _mm256_slli_epi16(hi, 16 - kShift));
+}
+#endif
+
+#if defined(__AVX2__)
+// 8 lanes of saturating a + b (or a - b) for 32-bit base types, AVX2 has no instruction for it
+template<FixedPoint NumberT, bool Subtract>
+inline __m256i AddSat32x8(__m256i a, __m256i b) noexcept
+{
+    if constexpr (NumberT::kIsSigned)
+    {
+        // overflow iff the operands (b negated for a subtraction) agree in sign and the result doesn't,
+        // then the result saturates towards the sign of a
+        const __m256i r = Subtract ? _mm256_sub_epi32(a, b) : _mm256_add_epi32(a, b);
+        const __m256i overflow = Subtract ? _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, r))
+                                          : _mm256_and_si256(_mm256_xor_si256(a, r), _mm256_xor_si256(b, r));
+        const __m256i saturated = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(0x7FFFFFFF));
+        return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(r), _mm256_castsi256_ps(saturated), _mm256_castsi256_ps(overflow)));
+    }
+    else if constexpr (Subtract)
+    {
+        // max(a, b) - b is a - b clamped at zero
+        return _mm256_sub_epi32(_mm256_max_epu32(a, b), b);
+    }
+    else
+    {
+        // b is clamped to the headroom ~a of a
+        return _mm256_add_epi32(a, _mm256_min_epu32(b, _mm256_xor_si256(a, _mm256_set1_epi32(-1))));
+    }
+}
+#endif
+
+// vectorized part of Add() and Sub() for saturating numbers, returns the number of elements processed
+template<FixedPoint NumberT, bool Subtract>
+inline std::size_t AddSatKernel(const NumberT* a, const NumberT* b, NumberT* out, std::size_t n) noexcept
+{
+    std::size_t i {0};
+
+    if constexpr (Vectorizable32<NumberT>)
+    {
+#if defined(__AVX2__)
+        for (; i + 8 <= n; i += 8)
+        {
+            const auto load = [](const NumberT* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), AddSat32x8<NumberT, Subtract>(load(a + i), load(b + i)));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        for (; i + 4 <= n; i += 4)
+        {
+            if constexpr (NumberT::kIsSigned)
+            {
+                const int32x4_t va = vld1q_s32(reinterpret_cast<const std::int32_t*>(a + i));
+                const int32x4_t vb = vld1q_s32(reinterpret_cast<const std::int32_t*>(b + i));
+                vst1q_s32(reinterpret_cast<std::int32_t*>(out + i), Subtract ? vqsubq_s32(va, vb) : vqaddq_s32(va, vb));
+            }
+            else
+            {
+                const uint32x4_t va = vld1q_u32(reinterpret_cast<const std::uint32_t*>(a + i));
+                const uint32x4_t vb = vld1q_u32(reinterpret_cast<const std::uint32_t*>(b + i));
+                vst1q_u32(reinterpret_cast<std::uint32_t*>(out + i), Subtract ? vqsubq_u32(va, vb) : vqaddq_u32(va, vb));
+            }
+        }
+#endif
+    }
+    else if constexpr (Vectorizable16<NumberT>)
+    {
+#if defined(__AVX2__)
+        for (; i + 16 <= n; i += 16)
+        {
+            const auto load = [](const NumberT* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+            const __m256i va = load(a + i);
+            const __m256i vb = load(b + i);
+            __m256i r;
+            if constexpr (NumberT::kIsSigned)
+            {
+                r = Subtract ? _mm256_subs_epi16(va, vb) : _mm256_adds_epi16(va, vb);
+            }
+            else
+            {
+                r = Subtract ? _mm256_subs_epu16(va, vb) : _mm256_adds_epu16(va, vb);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        for (; i + 8 <= n; i += 8)
+        {
+            if constexpr (NumberT::kIsSigned)
+            {
+                const int16x8_t va = vld1q_s16(reinterpret_cast<const std::int16_t*>(a + i));
+                const int16x8_t vb = vld1q_s16(reinterpret_cast<const std::int16_t*>(b + i));
+                vst1q_s16(reinterpret_cast<std::int16_t*>(out + i), Subtract ? vqsubq_s16(va, vb) : vqaddq_s16(va, vb));
+            }
+            else
+            {
+                const uint16x8_t va = vld1q_u16(reinterpret_cast<const std::uint16_t*>(a + i));
+                const uint16x8_t vb = vld1q_u16(reinterpret_cast<const std::uint16_t*>(b + i));
+                vst1q_u16(reinterpret_cast<std::uint16_t*>(out + i), Subtract ? vqsubq_u16(va, vb) : vqaddq_u16(va, vb));
+            }
+        }
+#endif
+    }
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(a);
+    static_cast<void>(b);
+    static_cast<void>(out);
+    static_cast<void>(n);
+    return i;
+}
+
+// vectorized part of Mul() and Fma(), returns the number of elements processed
+template<FixedPoint NumberT>
+inline std::size_t MulKernel(const NumberT* a, const NumberT* b, const NumberT* c, NumberT* out, std::size_t n) noexcept
+{
+    std::size_t i {0};
+
+    if constexpr (Vectorizable32<NumberT>)
+    {
+#if defined(__AVX512F__)
+        for (; i + 16 <= n; i += 16)
+        {
+            __m512i r = Mul32x16<NumberT>(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+            if (c != nullptr)
+            {
+                r = _mm512_add_epi32(r, _mm512_loadu_si512(c + i));
+            }
+            _mm512_storeu_si512(out + i, r);
+        }
+#endif
+#if defined(__AVX2__)
+        for (; i + 8 <= n; i += 8)
+        {
+            const auto load = [](const NumberT* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+            __m256i r = Mul32x8<NumberT>(load(a + i), load(b + i));
+            if (c != nullptr)
+            {
+                r = _mm256_add_epi32(r, load(c + i));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        constexpr int kShift = NumberT::kNumFracBits;
+        for (; i + 4 <= n; i += 4)
+        {
+            int32x4_t r;
+            if constexpr (NumberT::kIsSigned)
+            {
+                const int32x4_t va = vld1q_s32(reinterpret_cast<const std::int32_t*>(a + i));
+                const int32x4_t vb = vld1q_s32(reinterpret_cast<const std::int32_t*>(b + i));
+                const int64x2_t lo = vmull_s32(vget_low_s32(va), vget_low_s32(vb));
+                const int64x2_t hi = vmull_high_s32(va, vb);
+                r = vcombine_s32(vshrn_n_s64(lo, kShift), vshrn_n_s64(hi, kShift));
+            }
+            else
+            {
+                const uint32x4_t va = vld1q_u32(reinterpret_cast<const std::uint32_t*>(a + i));
+                const uint32x4_t vb = vld1q_u32(reinterpret_cast<const std::uint32_t*>(b + i));
+                const uint64x2_t lo = vmull_u32(vget_low_u32(va), vget_low_u32(vb));
+                const uint64x2_t hi = vmull_high_u32(va, vb);
+                r = vreinterpretq_s32_u32(vcombine_u32(vshrn_n_u64(lo, kShift), vshrn_n_u64(hi, kShift)));
+            }
+            if (c != nullptr)
+            {
+                r = vaddq_s32(r, vld1q_s32(reinterpret_cast<const std::int32_t*>(c + i)));
+            }
+            vst1q_s32(reinterpret_cast<std::int32_t*>(out + i), r);
+        }
+#endif
+    }
+    else if constexpr (Vectorizable16<NumberT>)
+    {
+#if defined(__AVX2__)
+        for (; i + 16 <= n; i += 16)
+        {
+            const auto load = [](const NumberT* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+            __m256i r = Mul16x16<NumberT>(load(a + i), load(b + i));
+            if (c != nullptr)
+            {
+                r = _mm256_add_epi16(r, load(c + i));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+        }
+#endif
+    }
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(a);
+    static_cast<void>(b);
+    static_cast<void>(c);
+    static_cast<void>(out);
+    static_cast<void>(n);
+    return i;
+}
+
+#if defined(__AVX2__)
+// sum of the four 64-bit lanes
+inline std::int64_t HorizontalSum64(__m256i v) noexcept
+{
+    const __m128i pair = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(pair) + _mm_extract_epi64(pair, 1);
+}
+
+// four pmaddwd sums widened to 64 bits, the one sum pmaddwd can't represent (2 * (-32768)^2 = 2^31) reads as INT32_MIN
+inline __m256i WidenMadd(__m128i sums) noexcept
+{
+    const __m256i wide = _mm256_cvtepi32_epi64(sums);
+    const __m256i wrapped = _mm256_cmpeq_epi64(wide, _mm256_set1_epi64x(std::numeric_limits<std::int32_t>::min()));
+    return _mm256_add_epi64(wide, _mm256_and_si256(wrapped, _mm256_set1_epi64x(std::int64_t{1} << 32)));
+}
+
+// 64-bit products split into their high (sign extended for signed types) and low 32 bits, which are summed separately
+template<bool Signed>
+inline void AccumulateSplit(__m256i product, __m256i& high, __m256i& low) noexcept
+{
+    const __m256i top = _mm256_srli_epi64(product, 32);
+    high = _mm256_add_epi64(high, Signed ? _mm256_blend_epi32(top, _mm256_srai_epi32(product, 31), 0xAA) : top);
+    low = _mm256_add_epi64(low, _mm256_and_si256(product, _mm256_set1_epi64x(0xFFFFFFFF)));
+}
+#endif
+
+// vectorized part of the dot products, adds the exact products of the first elements to sum
+// (which has 2 * kNumFracBits fractional bits) and returns the number of elements processed
+template<FixedPoint NumberT, typename AccumulatorType>
+inline std::size_t DotKernel(const NumberT* a, const NumberT* b, std::size_t n, AccumulatorType& sum) noexcept
+{
+    std::size_t i {0};
+
+    if constexpr (Vectorizable16<NumberT> && NumberT::kIsSigned && std::numeric_limits<AccumulatorType>::digits >= 63)
+    {
+#if defined(__AVX2__)
+        // pmaddwd sums pairs of 32-bit products, they are widened and summed in 64-bit lanes
+        const auto load = [](const NumberT* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+        __m256i low = _mm256_setzero_si256();
+        __m256i high = _mm256_setzero_si256();
+        for (; i + 16 <= n; i += 16)
+        {
+            const __m256i sums = _mm256_madd_epi16(load(a + i), load(b + i));
+            low = _mm256_add_epi64(low, WidenMadd(_mm256_castsi256_si128(sums)));
+            high = _mm256_add_epi64(high, WidenMadd(_mm256_extracti128_si256(sums, 1)));
+        }
+        // a half vector, e.g. a frame of 8 channels
+        if (i + 8 <= n)
+        {
+            const auto load_half = [](const NumberT* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+            low = _mm256_add_epi64(low, WidenMadd(_mm_madd_epi16(load_half(a + i), load_half(b + i))));
+            i += 8;
+        }
+        sum = static_cast<AccumulatorType>(sum + HorizontalSum64(_mm256_add_epi64(low, high)));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        int64x2_t acc = vdupq_n_s64(0);
+        for (; i + 8 <= n; i += 8)
+        {
+            const int16x8_t va = vld1q_s16(reinterpret_cast<const std::int16_t*>(a + i));
+            const int16x8_t vb = vld1q_s16(reinterpret_cast<const std::int16_t*>(b + i));
+            acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(va), vget_low_s16(vb)));
+            acc = vpadalq_s32(acc, vmull_high_s16(va, vb));
+        }
+        sum = static_cast<AccumulatorType>(sum + vaddvq_s64(acc));
+#endif
+    }
+    else if constexpr (Vectorizable32<NumberT> && sizeof(AccumulatorType) == 16)
+    {
+        // the 64-bit products leave no headroom, their high and low halves are summed in separate 64-bit lanes
+        // and recombined in the 128-bit accumulator, exact for up to 2^31 elements
+#if defined(__AVX2__)
+        const auto load = [](const NumberT* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); };
+        __m256i low = _mm256_setzero_si256();
+        __m256i high = _mm256_setzero_si256();
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256i va = load(a + i);
+            const __m256i vb = load(b + i);
+            const __m256i a_odd = _mm256_srli_epi64(va, 32);
+            const __m256i b_odd = _mm256_srli_epi64(vb, 32);
+            if constexpr (NumberT::kIsSigned)
+            {
+                AccumulateSplit<true>(_mm256_mul_epi32(va, vb), high, low);
+                AccumulateSplit<true>(_mm256_mul_epi32(a_odd, b_odd), high, low);
+            }
+            else
+            {
+                AccumulateSplit<false>(_mm256_mul_epu32(va, vb), high, low);
+                AccumulateSplit<false>(_mm256_mul_epu32(a_odd, b_odd), high, low);
+            }
+        }
+        const auto high_sum = static_cast<AccumulatorType>(HorizontalSum64(high));
+        const auto low_sum = static_cast<AccumulatorType>(static_cast<std::uint64_t>(HorizontalSum64(low)));
+        sum = static_cast<AccumulatorType>(sum + high_sum * (static_cast<AccumulatorType>(1) << 32) + low_sum);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        if constexpr (NumberT::kIsSigned)
+        {
+            int64x2_t low = vdupq_n_s64(0);
+            int64x2_t high = vdupq_n_s64(0);
+            const int64x2_t mask = vdupq_n_s64(0xFFFFFFFF);
+            for (; i + 4 <= n; i += 4)
+            {
+                const int32x4_t va = vld1q_s32(reinterpret_cast<const std::int32_t*>(a + i));
+                const int32x4_t vb = vld1q_s32(reinterpret_cast<const std::int32_t*>(b + i));
+                const int64x2_t lo = vmull_s32(vget_low_s32(va), vget_low_s32(vb));
+                const int64x2_t hi = vmull_high_s32(va, vb);
+                high = vaddq_s64(high, vaddq_s64(vshrq_n_s64(lo, 32), vshrq_n_s64(hi, 32)));
+                low = vaddq_s64(low, vaddq_s64(vandq_s64(lo, mask), vandq_s64(hi, mask)));
+            }
+            const auto high_sum = static_cast<AccumulatorType>(vaddvq_s64(high));
+            const auto low_sum = static_cast<AccumulatorType>(vaddvq_s64(low));
+            sum = static_cast<AccumulatorType>(sum + high_sum * (static_cast<AccumulatorType>(1) << 32) + low_sum);
+        }
+#endif
+    }
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(a);
+    static_cast<void>(b);
+    static_cast<void>(n);
+    static_cast<void>(sum);
+    return i;
+}
+
+/// @brief Concept: the policies of NumberT have vector equivalents for floating point conversions,
+/// the per-element random numbers of fp::RoundStochastic and the checks of fp::Trap don't.
+template<typename NumberT>
+concept VectorConvertible = (std::is_same_v<typename NumberT::OverflowType, Wrap> || std::is_same_v<typename NumberT::OverflowType, Saturate>) &&
+                            (std::is_same_v<typename NumberT::RoundingType, Truncate> || std::is_same_v<typename NumberT::RoundingType, RoundHalfUp> ||
+                             std::is_same_v<typename NumberT::RoundingType, RoundHalfEven>);
+
+#if defined(__AVX2__)
+// scaled floats rounded to integral values as by RoundingType::RoundFloat(), truncation is left to the conversion
+template<FixedPoint NumberT>
+inline __m256 RoundPs(__m256 v) noexcept
+{
+    using Rounding = typename NumberT::RoundingType;
+    if constexpr (std::is_same_v<Rounding, RoundHalfEven>)
+    {
+        return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    else if constexpr (std::is_same_v<Rounding, RoundHalfUp>)
+    {
+        const __m256 floor = _mm256_floor_ps(v);
+        const __m256 up = _mm256_cmp_ps(_mm256_sub_ps(v, floor), _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+        return _mm256_add_ps(floor, _mm256_and_ps(up, _mm256_set1_ps(1.0f)));
+    }
+    else
+    {
+        return v;
+    }
+}
+
+template<FixedPoint NumberT>
+inline __m256d RoundPd(__m256d v) noexcept
+{
+    using Rounding = typename NumberT::RoundingType;
+    if constexpr (std::is_same_v<Rounding, RoundHalfEven>)
+    {
+        return _mm256_round_pd(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+    else if constexpr (std::is_same_v<Rounding, RoundHalfUp>)
+    {
+        const __m256d floor = _mm256_floor_pd(v);
+        const __m256d up = _mm256_cmp_pd(_mm256_sub_pd(v, floor), _mm256_set1_pd(0.5), _CMP_GE_OQ);
+        return _mm256_add_pd(floor, _mm256_and_pd(up, _mm256_set1_pd(1.0)));
+    }
+    else
+    {
+        return v;
+    }
+}
+
+// NaN to zero and clamped to [low, high], the bounds must be exact in the floating point type
+inline __m256 ClampPs(__m256 v, float low, float high) noexcept
+{
+    const __m256 ordered = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+    return _mm256_min_ps(_mm256_max_ps(ordered, _mm256_set1_ps(low)), _mm256_set1_ps(high));
+}
+
+inline __m256d ClampPd(__m256d v, double low, double high) noexcept
+{
+    const __m256d ordered = _mm256_and_pd(v, _mm256_cmp_pd(v, v, _CMP_ORD_Q));
+    return _mm256_min_pd(_mm256_max_pd(ordered, _mm256_set1_pd(low)), _mm256_set1_pd(high));
+}
+
+// 8 rounded floats to signed 32-bit integers, narrowed as by the overflow policy of NumberT
+template<FixedPoint NumberT>
+inline __m256i FloatsToInt32(__m256 v) noexcept
+{
+    __m256i r = _mm256_cvttps_epi32(v);
+    if constexpr (std::is_same_v<typename NumberT::OverflowType, Saturate>)
+    {
+        // the maximum isn't a float, values from 2^31 up are replaced after the conversion, which already
+        // gives the minimum for those below the range, NaN gives zero
+        const __m256 above = _mm256_cmp_ps(v, _mm256_set1_ps(2147483648.0f), _CMP_GE_OQ);
+        const __m256 nan = _mm256_cmp_ps(v, v, _CMP_UNORD_Q);
+        r = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(r), _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF)), above));
+        r = _mm256_andnot_si256(_mm256_castps_si256(nan), r);
+    }
+    return r;
+}
+#endif
+
+// vectorized part of FromFloats(), returns the number of elements processed
+template<FixedPoint NumberT, typename FloatType>
+inline std::size_t FromFloatsKernel(const FloatType* in, NumberT* out, std::size_t n) noexcept
+{
+    std::size_t i {0};
+
+    if constexpr (VectorConvertible<NumberT>)
+    {
+        constexpr bool kSaturate {std::is_same_v<typename NumberT::OverflowType, Saturate>};
+        using ValueType = typename NumberT::ValueType;
+        constexpr auto kMin = static_cast<FloatType>(std::numeric_limits<ValueType>::min());
+        constexpr auto kMax = static_cast<FloatType>(std::numeric_limits<ValueType>::max());
+        constexpr auto kScale = static_cast<FloatType>(NumberT::kScaleFactor);
+        static_cast<void>(kSaturate);
+        static_cast<void>(kMin);
+        static_cast<void>(kMax);
+        static_cast<void>(kScale);
+
+        if constexpr (Vectorizable32<NumberT> && NumberT::kIsSigned && std::is_same_v<FloatType, float>)
+        {
+#if defined(__AVX2__)
+            for (; i + 8 <= n; i += 8)
+            {
+                const __m256 v = RoundPs<NumberT>(_mm256_mul_ps(_mm256_loadu_ps(in + i), _mm256_set1_ps(kScale)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), FloatsToInt32<NumberT>(v));
+            }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            // the NEON conversions saturate and turn NaN into zero, which is what fp::Saturate does
+            for (; i + 4 <= n; i += 4)
+            {
+                const float32x4_t v = vmulq_n_f32(vld1q_f32(in + i), kScale);
+                int32x4_t r;
+                if constexpr (std::is_same_v<typename NumberT::RoundingType, RoundHalfEven>)
+                {
+                    r = vcvtnq_s32_f32(v);
+                }
+                else if constexpr (std::is_same_v<typename NumberT::RoundingType, RoundHalfUp>)
+                {
+                    const float32x4_t floor = vrndmq_f32(v);
+                    const uint32x4_t up = vcgeq_f32(vsubq_f32(v, floor), vdupq_n_f32(0.5f));
+                    r = vcvtq_s32_f32(vaddq_f32(floor, vreinterpretq_f32_u32(vandq_u32(up, vreinterpretq_u32_f32(vdupq_n_f32(1.0f))))));
+                }
+                else
+                {
+                    r = vcvtq_s32_f32(v);
+                }
+                vst1q_s32(reinterpret_cast<std::int32_t*>(out + i), r);
+            }
+#endif
+        }
+        else if constexpr (Vectorizable32<NumberT> && NumberT::kIsSigned && std::is_same_v<FloatType, double>)
+        {
+#if defined(__AVX2__)
+            for (; i + 4 <= n; i += 4)
+            {
+                __m256d v = RoundPd<NumberT>(_mm256_mul_pd(_mm256_loadu_pd(in + i), _mm256_set1_pd(kScale)));
+                if constexpr (kSaturate)
+                {
+                    v = ClampPd(v, kMin, kMax);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvttpd_epi32(v));
+            }
+#endif
+        }
+        else if constexpr (Vectorizable16<NumberT> && std::is_same_v<FloatType, float>)
+        {
+#if defined(__AVX2__)
+            // converted to 32 bits and packed, clamping first keeps the packing exact
+            const auto convert = [&](std::size_t index) {
+                __m256 v = RoundPs<NumberT>(_mm256_mul_ps(_mm256_loadu_ps(in + index), _mm256_set1_ps(kScale)));
+                if constexpr (kSaturate)
+                {
+                    v = ClampPs(v, kMin, kMax);
+                }
+                return _mm256_cvttps_epi32(v);
+            };
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m256i low = convert(i);
+                const __m256i high = convert(i + 8);
+                const __m256i packed = NumberT::kIsSigned ? _mm256_packs_epi32(low, high) : _mm256_packus_epi32(low, high);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+            }
+#endif
+        }
+    }
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(in);
+    static_cast<void>(out);
+    static_cast<void>(n);
+    return i;
+}
+
+// vectorized part of ToFloats(), returns the number of elements processed
+template<FixedPoint NumberT, typename FloatType>
+inline std::size_t ToFloatsKernel(const NumberT* in, FloatType* out, std::size_t n) noexcept
+{
+    std::size_t i {0};
+
+    // the integers convert with rounding to nearest, then the scaling by a power of two is exact
+    constexpr auto kInverseScale = static_cast<FloatType>(1) / static_cast<FloatType>(NumberT::kScaleFactor);
+    static_cast<void>(kInverseScale);
+    if constexpr (Vectorizable32<NumberT> && NumberT::kIsSigned && std::is_same_v<FloatType, float>)
+    {
+#if defined(__AVX2__)
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256 v = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(v, _mm256_set1_ps(kInverseScale)));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        for (; i + 4 <= n; i += 4)
+        {
+            const float32x4_t v = vcvtq_f32_s32(vld1q_s32(reinterpret_cast<const std::int32_t*>(in + i)));
+            vst1q_f32(out + i, vmulq_n_f32(v, kInverseScale));
+        }
+#endif
+    }
+    else if constexpr (Vectorizable32<NumberT> && NumberT::kIsSigned && std::is_same_v<FloatType, double>)
+    {
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256d v = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(v, _mm256_set1_pd(kInverseScale)));
+        }
+#endif
+    }
+    else if constexpr (Vectorizable16<NumberT> && std::is_same_v<FloatType, float>)
+    {
+#if defined(__AVX2__)
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m256i wide = NumberT::kIsSigned ? _mm256_cvtepi16_epi32(raw) : _mm256_cvtepu16_epi32(raw);
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(wide), _mm256_set1_ps(kInverseScale)));
+        }
+#endif
+    }
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(in);
+    static_cast<void>(out);
+    static_cast<void>(n);
+    return i;
+}
+
+
+// integer lanes of one vector register for the selects of Abs(), Min(), Max(), Clamp() and CopySign(),
+// kCount is zero when the target has no instructions for the base type
+template<typename T>
+struct SelectLanes
+{
+    static constexpr std::size_t kCount {0};
+};
+
+#if defined(__AVX2__)
+template<typename T, std::size_t Bits>
+struct SelectLanesAvx2
+{
+    static constexpr std::size_t kCount {32 / sizeof(T)};
+
+    static __m256i Load(const T* p) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static void Store(T* p, __m256i v) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static __m256i Broadcast(T x) noexcept
+    {
+        if constexpr (Bits == 32)
+        {
+            return _mm256_set1_epi32(static_cast<std::int32_t>(x));
+        }
+        else
+        {
+            return _mm256_set1_epi16(static_cast<std::int16_t>(x));
+        }
+    }
+
+    static __m256i Min(__m256i a, __m256i b) noexcept
+    {
+        if constexpr (Bits == 32)
+        {
+            return std::is_signed_v<T> ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+        }
+        else
+        {
+            return std::is_signed_v<T> ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+        }
+    }
+
+    static __m256i Max(__m256i a, __m256i b) noexcept
+    {
+        if constexpr (Bits == 32)
+        {
+            return std::is_signed_v<T> ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+        }
+        else
+        {
+            return std::is_signed_v<T> ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+        }
+    }
+
+    // |v|, the minimum stays the minimum
+    static __m256i Abs(__m256i v) noexcept
+    {
+        return Bits == 32 ? _mm256_abs_epi32(v) : _mm256_abs_epi16(v);
+    }
+
+    // all ones in the negative lanes
+    static __m256i SignMask(__m256i v) noexcept
+    {
+        return Bits == 32 ? _mm256_srai_epi32(v, 31) : _mm256_srai_epi16(v, 15);
+    }
+
+    static __m256i Xor(__m256i a, __m256i b) noexcept
+    {
+        return _mm256_xor_si256(a, b);
+    }
+
+    // -v in the lanes where mask is all ones
+    static __m256i Negate(__m256i v, __m256i mask) noexcept
+    {
+        const __m256i flipped = _mm256_xor_si256(v, mask);
+        return Bits == 32 ? _mm256_sub_epi32(flipped, mask) : _mm256_sub_epi16(flipped, mask);
+    }
+};
+
+template<> struct SelectLanes<std::int32_t> : SelectLanesAvx2<std::int32_t, 32> {};
+template<> struct SelectLanes<std::uint32_t> : SelectLanesAvx2<std::uint32_t, 32> {};
+template<> struct SelectLanes<std::int16_t> : SelectLanesAvx2<std::int16_t, 16> {};
+template<> struct SelectLanes<std::uint16_t> : SelectLanesAvx2<std::uint16_t, 16> {};
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+template<>
+struct SelectLanes<std::int32_t>
+{
+    static constexpr std::size_t kCount {4};
+    static int32x4_t Load(const std::int32_t* p) noexcept { return vld1q_s32(p); }
+    static void Store(std::int32_t* p, int32x4_t v) noexcept { vst1q_s32(p, v); }
+    static int32x4_t Broadcast(std::int32_t x) noexcept { return vdupq_n_s32(x); }
+    static int32x4_t Min(int32x4_t a, int32x4_t b) noexcept { return vminq_s32(a, b); }
+    static int32x4_t Max(int32x4_t a, int32x4_t b) noexcept { return vmaxq_s32(a, b); }
+    static int32x4_t Abs(int32x4_t v) noexcept { return vabsq_s32(v); }
+    static int32x4_t SignMask(int32x4_t v) noexcept { return vshrq_n_s32(v, 31); }
+    static int32x4_t Xor(int32x4_t a, int32x4_t b) noexcept { return veorq_s32(a, b); }
+    static int32x4_t Negate(int32x4_t v, int32x4_t mask) noexcept { return vsubq_s32(veorq_s32(v, mask), mask); }
+};
+
+template<>
+struct SelectLanes<std::uint32_t>
+{
+    static constexpr std::size_t kCount {4};
+    static uint32x4_t Load(const std::uint32_t* p) noexcept { return vld1q_u32(p); }
+    static void Store(std::uint32_t* p, uint32x4_t v) noexcept { vst1q_u32(p, v); }
+    static uint32x4_t Broadcast(std::uint32_t x) noexcept { return vdupq_n_u32(x); }
+    static uint32x4_t Min(uint32x4_t a, uint32x4_t b) noexcept { return vminq_u32(a, b); }
+    static uint32x4_t Max(uint32x4_t a, uint32x4_t b) noexcept { return vmaxq_u32(a, b); }
+};
+
+template<>
+struct SelectLanes<std::int16_t>
+{
+    static constexpr std::size_t kCount {8};
+    static int16x8_t Load(const std::int16_t* p) noexcept { return vld1q_s16(p); }
+    static void Store(std::int16_t* p, int16x8_t v) noexcept { vst1q_s16(p, v); }
+    static int16x8_t Broadcast(std::int16_t x) noexcept { return vdupq_n_s16(x); }
+    static int16x8_t Min(int16x8_t a, int16x8_t b) noexcept { return vminq_s16(a, b); }
+    static int16x8_t Max(int16x8_t a, int16x8_t b) noexcept { return vmaxq_s16(a, b); }
+    static int16x8_t Abs(int16x8_t v) noexcept { return vabsq_s16(v); }
+    static int16x8_t SignMask(int16x8_t v) noexcept { return vshrq_n_s16(v, 15); }
+    static int16x8_t Xor(int16x8_t a, int16x8_t b) noexcept { return veorq_s16(a, b); }
+    static int16x8_t Negate(int16x8_t v, int16x8_t mask) noexcept { return vsubq_s16(veorq_s16(v, mask), mask); }
+};
+
+template<>
+struct SelectLanes<std::uint16_t>
+{
+    static constexpr std::size_t kCount {8};
+    static uint16x8_t Load(const std::uint16_t* p) noexcept { return vld1q_u16(p); }
+    static void Store(std::uint16_t* p, uint16x8_t v) noexcept { vst1q_u16(p, v); }
+    static uint16x8_t Broadcast(std::uint16_t x) noexcept { return vdupq_n_u16(x); }
+    static uint16x8_t Min(uint16x8_t a, uint16x8_t b) noexcept { return vminq_u16(a, b); }
+    static uint16x8_t Max(uint16x8_t a, uint16x8_t b) noexcept { return vmaxq_u16(a, b); }
+};
+#endif
+
+/// @brief Concept: |min| of NumberT saturates or wraps, as the vector abs instructions and a fix-up do.
+template<typename NumberT>
+concept VectorAbs = NumberT::kIsSigned && (std::is_same_v<typename NumberT::OverflowType, Wrap> || std::is_same_v<typename NumberT::OverflowType, Saturate>);
+
+// applies op to the lanes of a and b, returns the number of elements processed
+template<FixedPoint NumberT, typename Op>
+inline std::size_t SelectKernel(const NumberT* a, const NumberT* b, NumberT* out, std::size_t n, Op op) noexcept
+{
+    using ValueType = typename NumberT::ValueType;
+    using Lanes = SelectLanes<ValueType>;
+    std::size_t i {0};
+    if constexpr (Lanes::kCount > 0)
+    {
+        const auto load = [](const NumberT* p) { return Lanes::Load(reinterpret_cast<const ValueType*>(p)); };
+        for (; i + Lanes::kCount <= n; i += Lanes::kCount)
+        {
+            Lanes::Store(reinterpret_cast<ValueType*>(out + i), op(load(a + i), load(b + i)));
+        }
+    }
+
+    // silence unused parameter warnings when no kernel is compiled in
+    static_cast<void>(a);
+    static_cast<void>(b);
+    static_cast<void>(out);
+    static_cast<void>(n);
+    static_cast<void>(op);
+    return i;
+}
+
+// |v| with the overflow policy of NumberT applied to |min|
+template<FixedPoint NumberT, typename Vector>
+inline Vector AbsLanes(Vector v) noexcept
+{
+    using Lanes = SelectLanes<typename NumberT::ValueType>;
+    const Vector magnitude = Lanes::Abs(v);
+    if constexpr (std::is_same_v<typename NumberT::OverflowType, Saturate>)
+    {
+        // only |min| still has the sign bit set, flipping the other bits turns it into max
+        return Lanes::Xor(magnitude, Lanes::SignMask(magnitude));
+    }
+    else
+    {
+        return magnitude;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Element-wise addition: out[i] = a[i] + b[i].
+ *
+ * Processes out.size() elements, a and b must be at least that long. out may alias a or b.
+ * For fp::Wrap the loop is left to the compiler, which vectorizes plain integer additions on its
+ * own. fp::Saturate numbers use the saturating instructions (vpaddsw, vqadd) for 16 and 32-bit
+ * base types where the target has them, AVX2 emulates the 32-bit ones with a few logic operations.
+ */
+template<FixedPoint NumberT>
+constexpr void Add(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Add", out.size());
+    std::size_t i {0};
+    if constexpr (detail::Saturating<NumberT>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            i = detail::AddSatKernel<NumberT, false>(a.data(), b.data(), out.data(), out.size());
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+/**
+ * @brief Element-wise subtraction: out[i] = a[i] - b[i].
+ *
+ * Processes out.size() elements, a and b must be at least that long. out may alias a or b.
+ * Vectorized as Add().
+ */
+template<FixedPoint NumberT>
+constexpr void Sub(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Sub", out.size());
+    std::size_t i {0};
+    if constexpr (detail::Saturating<NumberT>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            i = detail::AddSatKernel<NumberT, true>(a.data(), b.data(), out.data(), out.size());
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = a[i] - b[i];
+    }
+}
+
+/**
+ * @brief Element-wise multiplication: out[i] = a[i] * b[i].
+ *
+ * Bit-exact with Number::operator*. Uses AVX-512 / AVX2 / NEON kernels for fp::Wrap, fp::Truncate numbers with
+ * 32-bit base types (and AVX2 for 16-bit ones) when the target supports them, the remaining tail
+ * and all other instantiations go through the scalar operator. out may alias a or b.
+ */
+template<FixedPoint NumberT>
+constexpr void Mul(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Mul", out.size());
+    std::size_t i {0};
+    if constexpr (detail::WrappingTruncating<NumberT>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            i = detail::MulKernel<NumberT>(a.data(), b.data(), nullptr, out.data(), out.size());
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+/**
+ * @brief Element-wise multiply-add: out[i] = a[i] * b[i] + c[i].
+ *
+ * Bit-exact with the scalar expression, i.e. the product is narrowed before the addition.
+ * out may alias any of the inputs.
+ */
+template<FixedPoint NumberT>
+constexpr void Fma(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b, std::span<const std::type_identity_t<NumberT>> c, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Fma", out.size());
+    std::size_t i {0};
+    if constexpr (detail::WrappingTruncating<NumberT>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            i = detail::MulKernel<NumberT>(a.data(), b.data(), c.data(), out.data(), out.size());
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = a[i] * b[i] + c[i];
+    }
+}
+
+/**
+ * @brief Element-wise absolute value: out[i] = Abs(in[i]).
+ *
+ * Uses vpabsd / vpabsw (AVX2) or vabs (NEON) for fp::Wrap and fp::Saturate numbers with 16 and
+ * 32-bit base types, with one more xor for the saturation of |min|. out may alias in.
+ */
+template<FixedPoint NumberT>
+constexpr void Abs(std::span<const std::type_identity_t<NumberT>> in, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Abs", out.size());
+    std::size_t i {0};
+    if constexpr (detail::VectorAbs<NumberT>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            i = detail::SelectKernel<NumberT>(in.data(), in.data(), out.data(), out.size(), [](auto v, auto) { return detail::AbsLanes<NumberT>(v); });
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = Abs(in[i]);
+    }
+}
+
+/**
+ * @brief Element-wise minimum: out[i] = Min(a[i], b[i]).
+ *
+ * One vpmin (AVX2) or vmin (NEON) per vector for 16 and 32-bit base types, whatever the policies.
+ * out may alias a or b.
+ */
+template<FixedPoint NumberT>
+constexpr void Min(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Min", out.size());
+    std::size_t i {0};
+    if (!std::is_constant_evaluated())
+    {
+        using Lanes = detail::SelectLanes<typename NumberT::ValueType>;
+        if constexpr (Lanes::kCount > 0)
+        {
+            i = detail::SelectKernel<NumberT>(a.data(), b.data(), out.data(), out.size(), [](auto x, auto y) { return Lanes::Min(x, y); });
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = Min(a[i], b[i]);
+    }
+}
+
+/**
+ * @brief Element-wise maximum: out[i] = Max(a[i], b[i]).
+ *
+ * Vectorized as Min(). out may alias a or b.
+ */
+template<FixedPoint NumberT>
+constexpr void Max(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Max", out.size());
+    std::size_t i {0};
+    if (!std::is_constant_evaluated())
+    {
+        using Lanes = detail::SelectLanes<typename NumberT::ValueType>;
+        if constexpr (Lanes::kCount > 0)
+        {
+            i = detail::SelectKernel<NumberT>(a.data(), b.data(), out.data(), out.size(), [](auto x, auto y) { return Lanes::Max(x, y); });
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = Max(a[i], b[i]);
+    }
+}
+
+/**
+ * @brief Element-wise clamp to a fixed range: out[i] = Clamp(in[i], lo, hi), lo <= hi.
+ *
+ * A vpmax and a vpmin (AVX2) or vmax and vmin (NEON) per vector for 16 and 32-bit base types.
+ * out may alias in.
+ */
+template<FixedPoint NumberT>
+constexpr void Clamp(std::span<const std::type_identity_t<NumberT>> in, std::type_identity_t<NumberT> lo, std::type_identity_t<NumberT> hi, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Clamp", out.size());
+    std::size_t i {0};
+    if (!std::is_constant_evaluated())
+    {
+        using Lanes = detail::SelectLanes<typename NumberT::ValueType>;
+        if constexpr (Lanes::kCount > 0)
+        {
+            const auto low = Lanes::Broadcast(fp::detail::RawBits(lo));
+            const auto high = Lanes::Broadcast(fp::detail::RawBits(hi));
+            i = detail::SelectKernel<NumberT>(in.data(), in.data(), out.data(), out.size(), [low, high](auto v, auto) { return Lanes::Min(Lanes::Max(v, low), high); });
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = Clamp(in[i], lo, hi);
+    }
+}
+
+/**
+ * @brief Element-wise sign transfer: out[i] = CopySign(magnitude[i], sign[i]).
+ *
+ * The absolute value of Abs() negated with a sign mask, an abs, a shift, a xor and a subtraction
+ * per vector. out may alias magnitude or sign.
+ */
+template<FixedPoint NumberT>
+constexpr void CopySign(std::span<const std::type_identity_t<NumberT>> magnitude, std::span<const std::type_identity_t<NumberT>> sign, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::CopySign", out.size());
+    std::size_t i {0};
+    if constexpr (detail::VectorAbs<NumberT>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            using Lanes = detail::SelectLanes<typename NumberT::ValueType>;
+            if constexpr (Lanes::kCount > 0)
+            {
+                i = detail::SelectKernel<NumberT>(magnitude.data(), sign.data(), out.data(), out.size(),
+                                                  [](auto m, auto s) { return Lanes::Negate(detail::AbsLanes<NumberT>(m), Lanes::SignMask(s)); });
+            }
+        }
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = CopySign(magnitude[i], sign[i]);
+    }
+}
+
+/**
+ * @brief Element-wise linear interpolation: out[i] = Lerp(a[i], b[i], t[i]).
+ *
+ * Scalar, the product needs WideType. out may alias any of the inputs.
+ */
+template<FixedPoint NumberT>
+constexpr void Lerp(std::span<const std::type_identity_t<NumberT>> a, std::span<const std::type_identity_t<NumberT>> b, std::span<const std::type_identity_t<NumberT>> t, std::span<NumberT> out) noexcept
+{
+    FP_PROFILE_SCOPE("fp::simd::Lerp", out.size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        out[i] = Lerp(a[i], b[i], t[i]);
+    }
+}
+
+}  // namespace fp::simd
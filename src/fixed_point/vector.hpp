@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "fixed_point.hpp"
+
+namespace fp
+{
+
+/// @brief Alignment (and padding granularity) of the storage owned by fp::Vector, one cache line.
+inline constexpr std::size_t kVectorAlignment {64};
+
+template<FixedPoint NumberT>
+class Vector;
+
+namespace detail
+{
+
+/// @brief Trait: T is an element-wise expression over fp::Vector operands
+template<typename T>
+struct IsVectorExpr : std::false_type {};
+
+/// @brief Trait: T is an fp::Vector
+template<typename T>
+struct IsVector : std::false_type {};
+
+template<FixedPoint NumberT>
+struct IsVector<Vector<NumberT>> : std::true_type {};
+
+/// @brief Concept: T can be an operand of a vector expression (a vector or another expression)
+template<typename T>
+concept VectorOperand = IsVector<std::remove_cvref_t<T>>::value || IsVectorExpr<std::remove_cvref_t<T>>::value;
+
+// vectors are held by reference (they outlive the full expression), expressions and scalars by value
+template<typename T>
+using OperandStorage = std::conditional_t<IsVector<std::remove_cvref_t<T>>::value, const std::remove_cvref_t<T>&, std::remove_cvref_t<T>>;
+
+/// @brief A scalar broadcast to every element of an expression
+template<FixedPoint NumberT>
+class Broadcast
+{
+public:
+    using value_type = NumberT;
+
+    constexpr explicit Broadcast(NumberT value) noexcept : value_{value} {}
+
+    [[nodiscard]] constexpr NumberT operator[](std::size_t) const noexcept
+    {
+        return value_;
+    }
+
+private:
+    NumberT value_;
+};
+
+template<FixedPoint NumberT>
+struct IsVectorExpr<Broadcast<NumberT>> : std::true_type {};
+
+// size of an expression, broadcasts don't have one and defer to the other operand
+template<typename T>
+[[nodiscard]] constexpr std::size_t ExprSize(const T& operand) noexcept
+{
+    if constexpr (requires { operand.size(); })
+    {
+        return operand.size();
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/// @brief Lazily evaluated element-wise binary operation
+template<typename Lhs, typename Rhs, typename Op>
+class BinaryExpr
+{
+public:
+    using value_type = typename std::remove_cvref_t<Lhs>::value_type;
+
+    constexpr BinaryExpr(const Lhs& lhs, const Rhs& rhs) noexcept : lhs_{lhs}, rhs_{rhs} {}
+
+    [[nodiscard]] constexpr value_type operator[](std::size_t i) const noexcept
+    {
+        return Op{}(lhs_[i], rhs_[i]);
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        const std::size_t lhs_size = ExprSize(lhs_);
+        return lhs_size != 0 ? lhs_size : ExprSize(rhs_);
+    }
+
+private:
+    OperandStorage<Lhs> lhs_;
+    OperandStorage<Rhs> rhs_;
+};
+
+template<typename Lhs, typename Rhs, typename Op>
+struct IsVectorExpr<BinaryExpr<Lhs, Rhs, Op>> : std::true_type {};
+
+/// @brief Lazily evaluated element-wise negation
+template<typename Operand>
+class NegateExpr
+{
+public:
+    using value_type = typename std::remove_cvref_t<Operand>::value_type;
+
+    constexpr explicit NegateExpr(const Operand& operand) noexcept : operand_{operand} {}
+
+    [[nodiscard]] constexpr value_type operator[](std::size_t i) const noexcept
+    {
+        return -operand_[i];
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return ExprSize(operand_);
+    }
+
+private:
+    OperandStorage<Operand> operand_;
+};
+
+template<typename Operand>
+struct IsVectorExpr<NegateExpr<Operand>> : std::true_type {};
+
+struct AddOp
+{
+    template<FixedPoint NumberT>
+    [[nodiscard]] constexpr NumberT operator()(const NumberT& a, const NumberT& b) const noexcept { return a + b; }
+};
+
+struct SubOp
+{
+    template<FixedPoint NumberT>
+    [[nodiscard]] constexpr NumberT operator()(const NumberT& a, const NumberT& b) const noexcept { return a - b; }
+};
+
+struct MulOp
+{
+    template<FixedPoint NumberT>
+    [[nodiscard]] constexpr NumberT operator()(const NumberT& a, const NumberT& b) const noexcept { return a * b; }
+};
+
+struct DivOp
+{
+    template<FixedPoint NumberT>
+    [[nodiscard]] constexpr NumberT operator()(const NumberT& a, const NumberT& b) const noexcept { return a / b; }
+};
+
+template<VectorOperand Operand>
+using ExprValueType = typename std::remove_cvref_t<Operand>::value_type;
+
+}  // namespace detail
+
+/**
+ * @brief A contiguous buffer of fixed-point numbers.
+ *
+ * Owned storage is aligned to kVectorAlignment and padded to a whole number of cache lines
+ * (the padding is zeroed), so vector kernels can run over it without peeling. A Vector can also
+ * be a non-owning view of external memory, see View() and ViewBits(). The storage comes from the
+ * aligned operator new, or from a std::pmr::memory_resource given to the constructor, e.g. an
+ * fp::FrameArena on threads that mustn't call malloc (memory.hpp).
+ *
+ * Arithmetic operators don't compute anything but build an expression, which is evaluated in a
+ * single pass when assigned to a Vector, so `d = a * b + c` creates no temporaries. Each element
+ * is computed with the scalar Number operators, the results are identical to an explicit loop.
+ *
+ * @tparam NumberT Element type, a specialization of fp::Number.
+ */
+template<FixedPoint NumberT>
+class Vector
+{
+public:
+    using value_type = NumberT;
+    using ValueType = typename NumberT::ValueType;
+
+    // number of elements per kVectorAlignment bytes
+    static constexpr std::size_t kLaneCount {kVectorAlignment / sizeof(NumberT)};
+
+    // constructor, elements are zero
+    constexpr explicit Vector(std::size_t size) : Vector(size, NumberT::Zero()) {}
+
+    // constructor, elements are zero, the storage comes from resource (nullptr: operator new)
+    Vector(std::size_t size, std::pmr::memory_resource* resource) : Vector(size, NumberT::Zero(), resource) {}
+
+    // constructor, all elements set to value, the storage comes from resource (nullptr: operator new)
+    constexpr Vector(std::size_t size, NumberT value, std::pmr::memory_resource* resource = nullptr)
+        : data_{Allocate(PaddedSize(size), resource)}, size_{size}, owns_{true}, resource_{resource}
+    {
+        for (std::size_t i = 0; i < PaddedSize(size_); ++i)
+        {
+            std::construct_at(data_ + i, i < size_ ? value : NumberT::Zero());
+        }
+    }
+
+    // constructor from an expression, evaluated in a single pass
+    template<detail::VectorOperand Expr>
+    requires (!detail::IsVector<Expr>::value) && std::same_as<detail::ExprValueType<Expr>, NumberT>
+    constexpr Vector(const Expr& expr) : Vector(expr.size())
+    {
+        Assign(expr);
+    }
+
+    // constructor from an expression, the storage comes from resource
+    template<detail::VectorOperand Expr>
+    requires (!detail::IsVector<Expr>::value) && std::same_as<detail::ExprValueType<Expr>, NumberT>
+    Vector(const Expr& expr, std::pmr::memory_resource* resource) : Vector(expr.size(), resource)
+    {
+        Assign(expr);
+    }
+
+    // factory method for a non-owning view of external memory
+    [[nodiscard]] static constexpr Vector View(std::span<NumberT> memory) noexcept
+    {
+        return Vector(memory.data(), memory.size());
+    }
+
+    // factory method for a non-owning view of raw bits, each value is interpreted as by FromBits()
+    [[nodiscard]] static Vector ViewBits(std::span<ValueType> raw) noexcept
+    {
+        static_assert(detail::kHasBaseLayout<NumberT>, "fp::Number must have the layout of its base type");
+        return Vector(reinterpret_cast<NumberT*>(raw.data()), raw.size());
+    }
+
+    // copy constructor, the copy always owns its storage, from operator new as for the std::pmr containers
+    constexpr Vector(const Vector& other) : Vector(other.size_)
+    {
+        std::copy_n(other.data_, other.size_, data_);
+    }
+
+    // copy constructor, the storage of the copy comes from resource
+    Vector(const Vector& other, std::pmr::memory_resource* resource) : Vector(other.size_, resource)
+    {
+        std::copy_n(other.data_, other.size_, data_);
+    }
+
+    constexpr Vector(Vector&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}, owns_{std::exchange(other.owns_, false)},
+          resource_{std::exchange(other.resource_, nullptr)}
+    {
+    }
+
+    // copy assignment, copies the elements into the own storage when sizes match (so views write through)
+    constexpr Vector& operator=(const Vector& other)
+    {
+        if (this != &other)
+        {
+            if (size_ == other.size_)
+            {
+                std::copy_n(other.data_, other.size_, data_);
+            }
+            else
+            {
+                // the new storage comes from the same resource
+                Vector copy(other.size_, NumberT::Zero(), resource_);
+                std::copy_n(other.data_, other.size_, copy.data_);
+                Swap(copy);
+            }
+        }
+        return *this;
+    }
+
+    constexpr Vector& operator=(Vector&& other) noexcept
+    {
+        Vector moved(std::move(other));
+        Swap(moved);
+        return *this;
+    }
+
+    // expression assignment, evaluated in a single pass (the expression must have size() elements)
+    template<detail::VectorOperand Expr>
+    requires (!detail::IsVector<Expr>::value) && std::same_as<detail::ExprValueType<Expr>, NumberT>
+    constexpr Vector& operator=(const Expr& expr) noexcept
+    {
+        Assign(expr);
+        return *this;
+    }
+
+    constexpr ~Vector()
+    {
+        if (owns_)
+        {
+            Deallocate(data_, PaddedSize(size_), resource_);
+        }
+    }
+
+    // number of elements (without padding)
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // true if the vector doesn't own its storage
+    [[nodiscard]] constexpr bool IsView() const noexcept
+    {
+        return !owns_;
+    }
+
+    // memory resource of the storage, nullptr for operator new and views
+    [[nodiscard]] constexpr std::pmr::memory_resource* GetResource() const noexcept
+    {
+        return resource_;
+    }
+
+    [[nodiscard]] constexpr NumberT* data() noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] constexpr const NumberT* data() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] constexpr NumberT& operator[](std::size_t i) noexcept
+    {
+        return data_[i];
+    }
+
+    [[nodiscard]] constexpr const NumberT& operator[](std::size_t i) const noexcept
+    {
+        return data_[i];
+    }
+
+    // iterators, a Vector is a contiguous range and converts to std::span (e.g. for the fp::simd kernels)
+    [[nodiscard]] constexpr NumberT* begin() noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] constexpr NumberT* end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] constexpr const NumberT* begin() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] constexpr const NumberT* end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+private:
+    constexpr Vector(NumberT* data, std::size_t size) noexcept : data_{data}, size_{size}, owns_{false} {}
+
+    // number of allocated elements, a whole number of cache lines
+    [[nodiscard]] static constexpr std::size_t PaddedSize(std::size_t size) noexcept
+    {
+        return (size + kLaneCount - 1) / kLaneCount * kLaneCount;
+    }
+
+    // constant evaluation can only allocate through std::allocator, which doesn't over-align
+    [[nodiscard]] static constexpr NumberT* Allocate(std::size_t count, std::pmr::memory_resource* resource)
+    {
+        if (std::is_constant_evaluated())
+        {
+            return std::allocator<NumberT>{}.allocate(count);
+        }
+        if (resource != nullptr)
+        {
+            return static_cast<NumberT*>(resource->allocate(count * sizeof(NumberT), kVectorAlignment));
+        }
+        return static_cast<NumberT*>(::operator new(count * sizeof(NumberT), std::align_val_t{kVectorAlignment}));
+    }
+
+    static constexpr void Deallocate(NumberT* data, std::size_t count, std::pmr::memory_resource* resource) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            std::allocator<NumberT>{}.deallocate(data, count);
+            return;
+        }
+        if (resource != nullptr)
+        {
+            resource->deallocate(data, count * sizeof(NumberT), kVectorAlignment);
+            return;
+        }
+        ::operator delete(data, count * sizeof(NumberT), std::align_val_t{kVectorAlignment});
+    }
+
+    template<typename Expr>
+    constexpr void Assign(const Expr& expr) noexcept
+    {
+        for (std::size_t i = 0; i < size_; ++i)
+        {
+            data_[i] = expr[i];
+        }
+    }
+
+    constexpr void Swap(Vector& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(owns_, other.owns_);
+        std::swap(resource_, other.resource_);
+    }
+
+    NumberT* data_;
+    std::size_t size_;
+    bool owns_;
+    std::pmr::memory_resource* resource_ {nullptr};
+};
+
+// element-wise operators between vectors / expressions
+template<detail::VectorOperand Lhs, detail::VectorOperand Rhs>
+requires std::same_as<detail::ExprValueType<Lhs>, detail::ExprValueType<Rhs>>
+[[nodiscard]] constexpr auto operator+(const Lhs& lhs, const Rhs& rhs) noexcept
+{
+    return detail::BinaryExpr<Lhs, Rhs, detail::AddOp>(lhs, rhs);
+}
+
+template<detail::VectorOperand Lhs, detail::VectorOperand Rhs>
+requires std::same_as<detail::ExprValueType<Lhs>, detail::ExprValueType<Rhs>>
+[[nodiscard]] constexpr auto operator-(const Lhs& lhs, const Rhs& rhs) noexcept
+{
+    return detail::BinaryExpr<Lhs, Rhs, detail::SubOp>(lhs, rhs);
+}
+
+template<detail::VectorOperand Lhs, detail::VectorOperand Rhs>
+requires std::same_as<detail::ExprValueType<Lhs>, detail::ExprValueType<Rhs>>
+[[nodiscard]] constexpr auto operator*(const Lhs& lhs, const Rhs& rhs) noexcept
+{
+    return detail::BinaryExpr<Lhs, Rhs, detail::MulOp>(lhs, rhs);
+}
+
+template<detail::VectorOperand Lhs, detail::VectorOperand Rhs>
+requires std::same_as<detail::ExprValueType<Lhs>, detail::ExprValueType<Rhs>>
+[[nodiscard]] constexpr auto operator/(const Lhs& lhs, const Rhs& rhs) noexcept
+{
+    return detail::BinaryExpr<Lhs, Rhs, detail::DivOp>(lhs, rhs);
+}
+
+template<detail::VectorOperand Operand>
+[[nodiscard]] constexpr auto operator-(const Operand& operand) noexcept
+{
+    return detail::NegateExpr<Operand>(operand);
+}
+
+// element-wise operators with a scalar on either side
+template<detail::VectorOperand Lhs>
+[[nodiscard]] constexpr auto operator+(const Lhs& lhs, const detail::ExprValueType<Lhs>& rhs) noexcept
+{
+    return lhs + detail::Broadcast(rhs);
+}
+
+template<detail::VectorOperand Rhs>
+[[nodiscard]] constexpr auto operator+(const detail::ExprValueType<Rhs>& lhs, const Rhs& rhs) noexcept
+{
+    return detail::Broadcast(lhs) + rhs;
+}
+
+template<detail::VectorOperand Lhs>
+[[nodiscard]] constexpr auto operator-(const Lhs& lhs, const detail::ExprValueType<Lhs>& rhs) noexcept
+{
+    return lhs - detail::Broadcast(rhs);
+}
+
+template<detail::VectorOperand Rhs>
+[[nodiscard]] constexpr auto operator-(const detail::ExprValueType<Rhs>& lhs, const Rhs& rhs) noexcept
+{
+    return detail::Broadcast(lhs) - rhs;
+}
+
+template<detail::VectorOperand Lhs>
+[[nodiscard]] constexpr auto operator*(const Lhs& lhs, const detail::ExprValueType<Lhs>& rhs) noexcept
+{
+    return lhs * detail::Broadcast(rhs);
+}
+
+template<detail::VectorOperand Rhs>
+[[nodiscard]] constexpr auto operator*(const detail::ExprValueType<Rhs>& lhs, const Rhs& rhs) noexcept
+{
+    return detail::Broadcast(lhs) * rhs;
+}
+
+template<detail::VectorOperand Lhs>
+[[nodiscard]] constexpr auto operator/(const Lhs& lhs, const detail::ExprValueType<Lhs>& rhs) noexcept
+{
+    return lhs / detail::Broadcast(rhs);
+}
+
+}  // namespace fp
@@ -0,0 +1,668 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#include "fixed_point.hpp"
+
+#if !defined(__SIZEOF_INT128__)
+#error "fp::WideNumber needs the 128-bit integer types"
+#endif
+
+namespace fp
+{
+
+namespace detail
+{
+
+using Limb = std::uint64_t;
+
+/// @brief Little-endian multi-word integer, limb 0 is the least significant one.
+template<std::size_t N>
+using LimbArray = std::array<Limb, N>;
+
+// from this number of limbs on (for even counts) products split into three half-size products
+inline constexpr std::size_t kKaratsubaLimbs {32};
+
+// a + b + carry, the carry out replaces carry
+[[nodiscard]] constexpr Limb AddCarry(Limb a, Limb b, unsigned char& carry) noexcept
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    if (!std::is_constant_evaluated())
+    {
+        unsigned long long sum;
+        carry = _addcarry_u64(carry, a, b, &sum);
+        return sum;
+    }
+#endif
+    const Limb partial {a + b};
+    const Limb sum {partial + carry};
+    carry = static_cast<unsigned char>((partial < a) | (sum < partial));
+    return sum;
+}
+
+// a - b - borrow, the borrow out replaces borrow
+[[nodiscard]] constexpr Limb SubBorrow(Limb a, Limb b, unsigned char& borrow) noexcept
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    if (!std::is_constant_evaluated())
+    {
+        unsigned long long difference;
+        borrow = _subborrow_u64(borrow, a, b, &difference);
+        return difference;
+    }
+#endif
+    const Limb partial {a - b};
+    const Limb difference {partial - borrow};
+    borrow = static_cast<unsigned char>((a < b) | (partial < borrow));
+    return difference;
+}
+
+// op(i) for i in [0, N) in order, unrolled
+template<std::size_t N, typename Op>
+constexpr void UnrolledFor(Op op) noexcept
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (op(I), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+// a[Offset, N) += b, the carry runs through the rest of a, returns the carry out
+template<std::size_t Offset = 0, std::size_t N, std::size_t M>
+requires (Offset + M <= N)
+constexpr unsigned char AddLimbs(LimbArray<N>& a, const LimbArray<M>& b) noexcept
+{
+    unsigned char carry {0};
+    UnrolledFor<N - Offset>([&](std::size_t i) { a[Offset + i] = AddCarry(a[Offset + i], i < M ? b[i] : Limb{0}, carry); });
+    return carry;
+}
+
+// a -= b, the borrow runs through the rest of a, returns the borrow out
+template<std::size_t N, std::size_t M>
+requires (M <= N)
+constexpr unsigned char SubLimbs(LimbArray<N>& a, const LimbArray<M>& b) noexcept
+{
+    unsigned char borrow {0};
+    UnrolledFor<N>([&](std::size_t i) { a[i] = SubBorrow(a[i], i < M ? b[i] : Limb{0}, borrow); });
+    return borrow;
+}
+
+// a < b as unsigned integers of the same length
+[[nodiscard]] constexpr bool LessLimbs(std::span<const Limb> a, std::span<const Limb> b) noexcept
+{
+    for (std::size_t i = a.size(); i-- > 0;)
+    {
+        if (a[i] != b[i])
+        {
+            return a[i] < b[i];
+        }
+    }
+    return false;
+}
+
+// -value modulo 2^(64 N)
+template<std::size_t N>
+[[nodiscard]] constexpr LimbArray<N> NegateLimbs(const LimbArray<N>& value) noexcept
+{
+    LimbArray<N> result {};
+    SubLimbs(result, value);
+    return result;
+}
+
+// -value when negative is set, value otherwise, with a mask instead of a branch: random signs don't mispredict
+template<std::size_t N>
+[[nodiscard]] constexpr LimbArray<N> NegateIf(const LimbArray<N>& value, bool negative) noexcept
+{
+    const Limb mask {Limb{0} - static_cast<Limb>(negative)};
+    LimbArray<N> result {};
+    unsigned char carry {static_cast<unsigned char>(negative)};
+    UnrolledFor<N>([&](std::size_t i) { result[i] = AddCarry(value[i] ^ mask, 0, carry); });
+    return result;
+}
+
+// value * 2^shift, the bits shifted out of the top are dropped
+template<std::size_t N>
+[[nodiscard]] constexpr LimbArray<N> ShiftLeftLimbs(const LimbArray<N>& value, std::size_t shift) noexcept
+{
+    LimbArray<N> result {};
+    const std::size_t limbs {shift / 64};
+    const std::size_t bits {shift % 64};
+    UnrolledFor<N>([&](std::size_t i) {
+        if (i >= limbs)
+        {
+            const std::size_t from {i - limbs};
+            result[i] = value[from] << bits;
+            if (bits != 0 && from > 0)
+            {
+                result[i] |= value[from - 1] >> (64 - bits);
+            }
+        }
+    });
+    return result;
+}
+
+// floor(value / 2^shift), fill (zero, or all ones for a negative value) is shifted in at the top
+template<std::size_t N>
+[[nodiscard]] constexpr LimbArray<N> ShiftRightLimbs(const LimbArray<N>& value, std::size_t shift, Limb fill) noexcept
+{
+    LimbArray<N> result {};
+    result.fill(fill);
+    const std::size_t limbs {shift / 64};
+    const std::size_t bits {shift % 64};
+    UnrolledFor<N>([&](std::size_t i) {
+        if (i + limbs < N)
+        {
+            const std::size_t from {i + limbs};
+            const Limb next {from + 1 < N ? value[from + 1] : fill};
+            result[i] = bits == 0 ? value[from] : (value[from] >> bits) | (next << (64 - bits));
+        }
+    });
+    return result;
+}
+
+// the full product of a and b, one row of multiply-adds per limb of a, small products fully unrolled
+template<std::size_t N, std::size_t M>
+[[nodiscard]] constexpr LimbArray<N + M> MulSchoolbook(const LimbArray<N>& a, const LimbArray<M>& b) noexcept
+{
+    LimbArray<N + M> product {};
+    const auto row = [&](std::size_t i) {
+        Limb carry {0};
+        UnrolledFor<M>([&](std::size_t j) {
+            // at most (2^64 - 1)^2 + 2 (2^64 - 1), the sum can't overflow
+            const uint128 sum {static_cast<uint128>(a[i]) * b[j] + product[i + j] + carry};
+            product[i + j] = static_cast<Limb>(sum);
+            carry = static_cast<Limb>(sum >> 64);
+        });
+        product[i + M] = carry;
+    };
+    if constexpr (N * M <= 64)
+    {
+        UnrolledFor<N>(row);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            row(i);
+        }
+    }
+    return product;
+}
+
+// the full product of a and b, Karatsuba for kKaratsubaLimbs limbs and more (even counts), schoolbook below
+template<std::size_t N>
+[[nodiscard]] constexpr LimbArray<2 * N> MultiplyLimbs(const LimbArray<N>& a, const LimbArray<N>& b) noexcept
+{
+    if constexpr (N < kKaratsubaLimbs || N % 2 != 0)
+    {
+        return MulSchoolbook(a, b);
+    }
+    else
+    {
+        // a = a1 2^(64 H) + a0, b alike: a b = a1 b1 2^(128 H) + (a0 b1 + a1 b0) 2^(64 H) + a0 b0, and the middle
+        // term is a0 b0 + a1 b1 + (a0 - a1) (b1 - b0), the differences are taken as magnitudes so they keep H limbs
+        constexpr std::size_t H {N / 2};
+        LimbArray<H> a0 {};
+        LimbArray<H> a1 {};
+        LimbArray<H> b0 {};
+        LimbArray<H> b1 {};
+        std::copy_n(a.begin(), H, a0.begin());
+        std::copy_n(a.begin() + H, H, a1.begin());
+        std::copy_n(b.begin(), H, b0.begin());
+        std::copy_n(b.begin() + H, H, b1.begin());
+
+        const LimbArray<N> low {MultiplyLimbs(a0, b0)};
+        const LimbArray<N> high {MultiplyLimbs(a1, b1)};
+
+        const bool a_negative {LessLimbs(a0, a1)};
+        LimbArray<H> a_difference {a_negative ? a1 : a0};
+        SubLimbs(a_difference, a_negative ? a0 : a1);
+        const bool b_negative {LessLimbs(b1, b0)};
+        LimbArray<H> b_difference {b_negative ? b0 : b1};
+        SubLimbs(b_difference, b_negative ? b1 : b0);
+        const LimbArray<N> cross {MultiplyLimbs(a_difference, b_difference)};
+
+        // a0 b1 + a1 b0 < 2^(128 H + 1), one limb more than the half products
+        LimbArray<N + 1> middle {};
+        std::copy(low.begin(), low.end(), middle.begin());
+        AddLimbs(middle, high);
+        if (a_negative != b_negative)
+        {
+            SubLimbs(middle, cross);
+        }
+        else
+        {
+            AddLimbs(middle, cross);
+        }
+
+        LimbArray<2 * N> product {};
+        std::copy(low.begin(), low.end(), product.begin());
+        std::copy(high.begin(), high.end(), product.begin() + N);
+        AddLimbs<H>(product, middle);
+        return product;
+    }
+}
+
+// floor(u / v), Knuth's algorithm D with 64-bit digits, v must not be zero
+template<std::size_t M, std::size_t N>
+[[nodiscard]] constexpr LimbArray<M> DivideLimbs(const LimbArray<M>& u, const LimbArray<N>& v) noexcept
+{
+    std::size_t m {M};
+    while (m > 0 && u[m - 1] == 0)
+    {
+        --m;
+    }
+    std::size_t n {N};
+    while (n > 0 && v[n - 1] == 0)
+    {
+        --n;
+    }
+
+    LimbArray<M> quotient {};
+    if (m < n)
+    {
+        return quotient;
+    }
+    if (N == 1 || n == 1)
+    {
+        // one divq per limb: the remainder is below the divisor, so every partial quotient fits in a limb
+        Limb remainder {0};
+        for (std::size_t i = m; i-- > 0;)
+        {
+            const auto [q, r] = DivideWide<Limb>((static_cast<uint128>(remainder) << 64) | u[i], static_cast<uint128>(v[0]));
+            quotient[i] = static_cast<Limb>(q);
+            remainder = static_cast<Limb>(r);
+        }
+        return quotient;
+    }
+
+    // normalize: the top bit of the divisor set keeps every estimated quotient digit at most 2 too large
+    const auto shift = static_cast<std::size_t>(std::countl_zero(v[n - 1]));
+    LimbArray<N> vn {ShiftLeftLimbs(v, shift)};
+    std::array<Limb, M + 1> un {};
+    std::copy(u.begin(), u.end(), un.begin());
+    un = ShiftLeftLimbs(un, shift);
+
+    for (std::size_t j = m - n + 1; j-- > 0;)
+    {
+        // estimate the digit from the top two limbs, then correct it with the next one
+        const uint128 numerator {(static_cast<uint128>(un[j + n]) << 64) | un[j + n - 1]};
+        auto [q, r] = DivideWide<Limb>(numerator, static_cast<uint128>(vn[n - 1]));
+        while ((q >> 64) != 0 || q * vn[n - 2] > ((r << 64) | un[j + n - 2]))
+        {
+            --q;
+            r += vn[n - 1];
+            if ((r >> 64) != 0)
+            {
+                break;
+            }
+        }
+
+        // un[j, j + n] -= q vn
+        Limb product_carry {0};
+        unsigned char borrow {0};
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const uint128 product {q * vn[i] + product_carry};
+            product_carry = static_cast<Limb>(product >> 64);
+            un[i + j] = SubBorrow(un[i + j], static_cast<Limb>(product), borrow);
+        }
+        un[j + n] = SubBorrow(un[j + n], product_carry, borrow);
+
+        // rarely the digit is still one too large, add the divisor back
+        if (borrow != 0)
+        {
+            --q;
+            unsigned char carry {0};
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                un[i + j] = AddCarry(un[i + j], vn[i], carry);
+            }
+            un[j + n] += carry;
+        }
+        quotient[j] = static_cast<Limb>(q);
+    }
+    return quotient;
+}
+
+// value * 2^exponent, exact unless the result is out of the range of double
+[[nodiscard]] constexpr double ScaleByPowerOfTwo(double value, int exponent) noexcept
+{
+    for (; exponent >= 64; exponent -= 64)
+    {
+        value *= 0x1.0p64;
+    }
+    for (; exponent <= -64; exponent += 64)
+    {
+        value *= 0x1.0p-64;
+    }
+    const auto factor = static_cast<double>(std::uint64_t{1} << (exponent < 0 ? -exponent : exponent));
+    return exponent < 0 ? value / factor : value * factor;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A signed fixed-point number of any multiple of 64 bits, e.g. Q64.64 or Q96.32, for
+ * ledgers and accumulators that outgrow the 64-bit base types of fp::Number.
+ *
+ * The value is a two's complement integer of Limbs 64-bit words scaled by 2^-FracBits. The
+ * operators match fp::Number with the default policies (fp::Wrap, fp::Truncate): results wrap,
+ * products round towards minus infinity, quotients and floating point values towards zero.
+ * Dividing by zero traps (fails the compilation in a constant expression).
+ *
+ * Additions are unrolled add-with-carry chains (adc / sbb through _addcarry_u64 on x86-64).
+ * Products are schoolbook below detail::kKaratsubaLimbs limbs and Karatsuba from there on, where
+ * the three half products start to pay for their extra additions; signs are applied with masks,
+ * not branches. Quotients use Knuth's long division, one hardware divide per quotient limb.
+ * Everything is constexpr.
+ *
+ * @tparam Limbs Number of 64-bit words.
+ * @tparam FracBits Number of fractional bits, the others (sign included) form the integer part.
+ */
+template<std::size_t Limbs, std::size_t FracBits>
+requires (Limbs > 0) && (FracBits < Limbs * 64)
+class WideNumber
+{
+public:
+    // the limbs, least significant first
+    using BitsType = detail::LimbArray<Limbs>;
+
+    // variables describing the fixed point number representation
+    static constexpr bool kIsSigned {true};
+    static constexpr std::size_t kNumLimbs {Limbs};
+    static constexpr std::size_t kNumBits {Limbs * 64};
+    static constexpr std::size_t kNumIntBits {kNumBits - FracBits};
+    static constexpr std::size_t kNumFracBits {FracBits};
+
+    // factory method for number construction
+    [[nodiscard]] static constexpr WideNumber FromBits(const BitsType& raw) noexcept
+    {
+        WideNumber result;
+        result.limbs_ = raw;
+        return result;
+    }
+
+    // constants
+    static constexpr WideNumber Zero() noexcept
+    {
+        return FromBits({});
+    }
+
+    static constexpr WideNumber Half() noexcept
+    {
+        static_assert(FracBits > 0, "Half() doesn't exist without fractional bits");
+        return FromBits(detail::ShiftLeftLimbs(BitsType{1}, FracBits - 1));
+    }
+
+    static constexpr WideNumber PosOne() noexcept
+    {
+        return FromBits(detail::ShiftLeftLimbs(BitsType{1}, FracBits));
+    }
+
+    static constexpr WideNumber NegOne() noexcept
+    {
+        return -PosOne();
+    }
+
+    // default constructor
+    constexpr explicit WideNumber() noexcept : limbs_{} {}
+
+    // constructor from float
+    constexpr explicit WideNumber(float f) noexcept : WideNumber(static_cast<double>(f)) {}
+
+    // constructor from double, truncated, infinities and NaN are undefined as for static_cast
+    constexpr explicit WideNumber(double d) noexcept : limbs_{}
+    {
+        // |d| 2^FracBits = mantissa 2^shift
+        const auto bits = std::bit_cast<std::uint64_t>(d);
+        const auto exponent = static_cast<int>((bits >> 52) & 0x7FF);
+        const std::uint64_t mantissa {(bits & ((std::uint64_t{1} << 52) - 1)) | (exponent != 0 ? std::uint64_t{1} << 52 : 0)};
+        const int shift {(exponent != 0 ? exponent : 1) - 1075 + static_cast<int>(FracBits)};
+        if (shift >= 0)
+        {
+            limbs_ = detail::ShiftLeftLimbs(BitsType{mantissa}, static_cast<std::size_t>(shift));
+        }
+        else if (shift > -64)
+        {
+            limbs_[0] = mantissa >> -shift;
+        }
+        limbs_ = detail::NegateIf(limbs_, (bits >> 63) != 0);
+    }
+
+    // constructor from int
+    template<std::integral T>
+    requires (sizeof(T) <= sizeof(detail::Limb))
+    constexpr explicit WideNumber(T i) noexcept : limbs_{detail::ShiftLeftLimbs(Extend(static_cast<detail::Limb>(i), detail::CmpLess(i, 0)), FracBits)} {}
+
+    // constructor from an fp::Number, exact when its integer and fractional parts fit, otherwise truncated and wrapped
+    template<FixedPoint NumberT>
+    constexpr explicit WideNumber(const NumberT& x) noexcept : limbs_{}
+    {
+        const auto raw = x.Bits();
+        const BitsType extended {Extend(static_cast<detail::Limb>(raw), detail::CmpLess(raw, 0))};
+        if constexpr (FracBits >= NumberT::kNumFracBits)
+        {
+            limbs_ = detail::ShiftLeftLimbs(extended, FracBits - NumberT::kNumFracBits);
+        }
+        else
+        {
+            limbs_ = detail::ShiftRightLimbs(extended, NumberT::kNumFracBits - FracBits, extended[Limbs - 1] >> 63 != 0 ? ~detail::Limb{0} : 0);
+        }
+    }
+
+    // getter for the raw bits, the inverse of FromBits()
+    [[nodiscard]] constexpr const BitsType& Bits() const noexcept
+    {
+        return limbs_;
+    }
+
+    // conversion to double, rounded to nearest
+    [[nodiscard]] constexpr explicit operator double() const noexcept
+    {
+        const bool negative {SignBit(*this)};
+        const BitsType magnitude {Magnitude(*this)};
+        std::size_t top {Limbs};
+        while (top > 0 && magnitude[top - 1] == 0)
+        {
+            --top;
+        }
+        if (top == 0)
+        {
+            return 0.0;
+        }
+
+        // the 64 leading bits, with a sticky bit for any set bit below them, round once in the conversion
+        const std::size_t length {top * 64 - static_cast<std::size_t>(std::countl_zero(magnitude[top - 1]))};
+        const std::size_t dropped {length > 64 ? length - 64 : 0};
+        auto leading = detail::ShiftRightLimbs(magnitude, dropped, 0)[0];
+        if (dropped != 0 && detail::ShiftLeftLimbs(magnitude, kNumBits - dropped) != BitsType{})
+        {
+            leading |= 1;
+        }
+        const double scaled {detail::ScaleByPowerOfTwo(static_cast<double>(leading), static_cast<int>(dropped) - static_cast<int>(FracBits))};
+        return negative ? -scaled : scaled;
+    }
+
+    // conversion to float, through double
+    [[nodiscard]] constexpr explicit operator float() const noexcept
+    {
+        return static_cast<float>(static_cast<double>(*this));
+    }
+
+    // conversion to an fp::Number, the dropped fractional bits are truncated and the result wraps as for fp::Convert()
+    template<FixedPoint NumberT>
+    [[nodiscard]] constexpr explicit operator NumberT() const noexcept
+    {
+        using ValueType = typename NumberT::ValueType;
+        if constexpr (FracBits >= NumberT::kNumFracBits)
+        {
+            return NumberT::FromBits(static_cast<ValueType>(detail::ShiftRightLimbs(limbs_, FracBits - NumberT::kNumFracBits, SignFill(*this))[0]));
+        }
+        else
+        {
+            return NumberT::FromBits(static_cast<ValueType>(detail::ShiftLeftLimbs(limbs_, NumberT::kNumFracBits - FracBits)[0]));
+        }
+    }
+
+    // negation operator
+    [[nodiscard]] constexpr WideNumber operator-() const noexcept
+    {
+        return FromBits(detail::NegateLimbs(limbs_));
+    }
+
+    // addition operator
+    [[nodiscard]] constexpr WideNumber operator+(const WideNumber& other) const noexcept
+    {
+        WideNumber result {*this};
+        return result += other;
+    }
+
+    // subtraction operator
+    [[nodiscard]] constexpr WideNumber operator-(const WideNumber& other) const noexcept
+    {
+        WideNumber result {*this};
+        return result -= other;
+    }
+
+    // multiplication operator
+    [[nodiscard]] constexpr WideNumber operator*(const WideNumber& other) const noexcept
+    {
+        // the product of the magnitudes is below 2^(128 Limbs - 2), so the signed product has a clear sign bit to shift in
+        const bool negative {SignBit(*this) != SignBit(other)};
+        const auto magnitude = detail::MultiplyLimbs(Magnitude(*this), Magnitude(other));
+        const auto product = detail::NegateIf(magnitude, negative);
+        const auto shifted = detail::ShiftRightLimbs(product, FracBits, product[2 * Limbs - 1] >> 63 != 0 ? ~detail::Limb{0} : 0);
+        BitsType result {};
+        std::copy_n(shifted.begin(), Limbs, result.begin());
+        return FromBits(result);
+    }
+
+    // division operator
+    [[nodiscard]] constexpr WideNumber operator/(const WideNumber& other) const noexcept
+    {
+        if (other == Zero()) [[unlikely]]
+        {
+            detail::OverflowTrap();
+        }
+        const bool negative {SignBit(*this) != SignBit(other)};
+        detail::LimbArray<2 * Limbs> numerator {};
+        const auto dividend = Magnitude(*this);
+        std::copy(dividend.begin(), dividend.end(), numerator.begin());
+        const auto quotient = detail::DivideLimbs(detail::ShiftLeftLimbs(numerator, FracBits), Magnitude(other));
+        BitsType result {};
+        std::copy_n(quotient.begin(), Limbs, result.begin());
+        return FromBits(detail::NegateIf(result, negative));
+    }
+
+    // increment operator
+    constexpr WideNumber& operator+=(const WideNumber& other) noexcept
+    {
+        detail::AddLimbs(limbs_, other.limbs_);
+        return *this;
+    }
+
+    // decrement operator
+    constexpr WideNumber& operator-=(const WideNumber& other) noexcept
+    {
+        detail::SubLimbs(limbs_, other.limbs_);
+        return *this;
+    }
+
+    // multiplication assignment operator
+    constexpr WideNumber& operator*=(const WideNumber& other) noexcept
+    {
+        return *this = *this * other;
+    }
+
+    // division assignment operator
+    constexpr WideNumber& operator/=(const WideNumber& other) noexcept
+    {
+        return *this = *this / other;
+    }
+
+    // spaceship operator, the top limb is compared signed and the others unsigned
+    [[nodiscard]] constexpr std::strong_ordering operator<=>(const WideNumber& other) const noexcept
+    {
+        if (limbs_[Limbs - 1] != other.limbs_[Limbs - 1])
+        {
+            return static_cast<std::int64_t>(limbs_[Limbs - 1]) <=> static_cast<std::int64_t>(other.limbs_[Limbs - 1]);
+        }
+        for (std::size_t i = Limbs - 1; i-- > 0;)
+        {
+            if (limbs_[i] != other.limbs_[i])
+            {
+                return limbs_[i] <=> other.limbs_[i];
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+
+    // equality comparison
+    [[nodiscard]] constexpr bool operator==(const WideNumber& other) const noexcept = default;
+
+    // sign bit
+    [[nodiscard]] static constexpr bool SignBit(const WideNumber& a) noexcept
+    {
+        return (a.limbs_[Limbs - 1] >> 63) != 0;
+    }
+
+    // sign, -1 or 1
+    [[nodiscard]] static constexpr WideNumber Sign(const WideNumber& a) noexcept
+    {
+        return SignBit(a) ? NegOne() : PosOne();
+    }
+
+    // abs function, |min| wraps to min
+    friend constexpr WideNumber Abs(const WideNumber& a) noexcept
+    {
+        return FromBits(Magnitude(a));
+    }
+
+private:
+    // the two's complement bits of a limb sign-extended (negative) or zero-extended to every limb
+    [[nodiscard]] static constexpr BitsType Extend(detail::Limb low, bool negative) noexcept
+    {
+        BitsType result {};
+        result.fill(negative ? ~detail::Limb{0} : 0);
+        result[0] = low;
+        return result;
+    }
+
+    // all ones for negative values, zero otherwise
+    [[nodiscard]] static constexpr detail::Limb SignFill(const WideNumber& a) noexcept
+    {
+        return SignBit(a) ? ~detail::Limb{0} : 0;
+    }
+
+    // |a| as an unsigned integer, exact for the minimum value too
+    [[nodiscard]] static constexpr BitsType Magnitude(const WideNumber& a) noexcept
+    {
+        return detail::NegateIf(a.limbs_, SignBit(a));
+    }
+
+    BitsType limbs_;
+};
+
+// Stream operator for convenient printing
+template<std::size_t Limbs, std::size_t FracBits>
+std::ostream& operator<<(std::ostream& os, const WideNumber<Limbs, FracBits>& x)
+{
+    os << static_cast<double>(x);
+    return os;
+}
+
+}  // namespace fp
@@ -0,0 +1,1133 @@
+// Differential test of the optimized code paths against the scalar fp::Number operators.
+//
+// Every vector kernel, divide-free division, bulk conversion, root and engine of the library is
+// run over random and edge-case inputs for many instantiations, and compared bit-exactly with the
+// plain scalar expression it replaces, or with an exact reference within the error bound its
+// documentation states. The compile-time suite (test_fixed_point.cpp) can't do this: constant
+// evaluation always takes the scalar paths.
+//
+// usage: fixed-point-fuzz [rounds] [seed]
+// A failure prints the check, the type, the seed and round to replay it, and the raw bits involved.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "algorithm.hpp"
+#include "channels.hpp"
+#include "charconv.hpp"
+#include "complex.hpp"
+#include "fast_div.hpp"
+#include "fft.hpp"
+#include "filter.hpp"
+#include "floats.hpp"
+#include "instrument.hpp"
+#include "math.hpp"
+#include "matrix.hpp"
+#include "memory.hpp"
+#include "profile.hpp"
+#include "ring_buffer.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+#include "wide_number.hpp"
+
+using FP_S32_16 = fp::Number<std::int32_t, std::int64_t, 16>;
+using FP_U32_16 = fp::Number<std::uint32_t, std::uint64_t, 16>;
+using FP_S16_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+using FP_U16_8 = fp::Number<std::uint16_t, std::uint32_t, 8>;
+using FP_S64_32 = fp::Number<std::int64_t, fp::int128, 32>;
+using FP_U64_32 = fp::Number<std::uint64_t, fp::uint128, 32>;
+using FP_S32_16_Sat = fp::Number<std::int32_t, std::int64_t, 16, fp::Saturate>;
+using FP_S16_8_Sat = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+using FP_U16_8_Sat = fp::Number<std::uint16_t, std::uint32_t, 8, fp::Saturate>;
+using FP_S32_16_HalfEven = fp::Number<std::int32_t, std::int64_t, 16, fp::Wrap, fp::RoundHalfEven>;
+using FP_S16_8_HalfUp = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfUp>;
+using FP_Q15 = fp::Number<std::int16_t, std::int32_t, 1>;
+using FP_Q30 = fp::Number<std::int32_t, std::int64_t, 2>;
+using FP_Q31 = fp::Number<std::int32_t, std::int64_t, 1>;
+using FP_S32_8 = fp::Number<std::int32_t, std::int64_t, 8>;
+
+namespace
+{
+
+// SplitMix64, the generator of fp::RoundStochastic
+class Random
+{
+public:
+    explicit Random(std::uint64_t seed) noexcept : state_{seed} {}
+
+    std::uint64_t Next() noexcept
+    {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0, n), n > 0
+    std::size_t Below(std::size_t n) noexcept
+    {
+        return static_cast<std::size_t>(Next() % n);
+    }
+
+    // uniform in [0, 1)
+    double Unit() noexcept
+    {
+        return static_cast<double>(Next() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+// raw bits printed as a 64-bit integer of the same signedness
+template<fp::Integral T>
+auto Printable(T raw) noexcept
+{
+    if constexpr (std::numeric_limits<T>::is_signed)
+    {
+        return static_cast<long long>(raw);
+    }
+    else
+    {
+        return static_cast<unsigned long long>(raw);
+    }
+}
+
+// counts the checks and prints the failures of one type
+class Report
+{
+public:
+    Report(std::string_view type, std::uint64_t seed) noexcept : type_{type}, seed_{seed} {}
+
+    void SetRound(std::size_t round) noexcept
+    {
+        round_ = round;
+    }
+
+    // one check of a whole batch, false prints it
+    bool Expect(bool ok, std::string_view check) noexcept
+    {
+        ++checks_;
+        if (!ok)
+        {
+            ++failures_;
+            // only the first few failures of a run are worth reading
+            if (failures_ <= kMaxPrinted)
+            {
+                std::cout << "FAIL " << type_ << " " << check << " (seed " << seed_ << ", round " << round_ << ")\n";
+            }
+        }
+        return ok;
+    }
+
+    // out[i] == expected[i] for every i, the first mismatch is printed with the inputs at its index
+    template<fp::FixedPoint NumberT, typename... Inputs>
+    bool ExpectEqual(std::string_view check, std::span<const NumberT> expected, std::span<const NumberT> out, const Inputs&... inputs) noexcept
+    {
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if (expected[i] != out[i])
+            {
+                Expect(false, check);
+                if (failures_ <= kMaxPrinted)
+                {
+                    std::cout << "  index " << i << " of " << expected.size() << ": expected " << Printable(expected[i].Bits())
+                              << ", got " << Printable(out[i].Bits());
+                    ((std::cout << ", input " << Printable(inputs[i].Bits())), ...);
+                    std::cout << "\n";
+                }
+                return false;
+            }
+        }
+        return Expect(true, check);
+    }
+
+    [[nodiscard]] std::size_t Failures() const noexcept
+    {
+        return failures_;
+    }
+
+    [[nodiscard]] std::size_t Checks() const noexcept
+    {
+        return checks_;
+    }
+
+private:
+    static constexpr std::size_t kMaxPrinted {20};
+
+    std::string_view type_;
+    std::uint64_t seed_;
+    std::size_t round_ {0};
+    std::size_t checks_ {0};
+    std::size_t failures_ {0};
+};
+
+// largest error in ULP the fast roots may have against the exact ones (math.hpp)
+constexpr std::int64_t kFastRootMaxUlp {1};
+
+// largest error in ULP of the Q15.16 transcendental functions against double (math.hpp), both backends
+constexpr double kMathMaxUlp {1.0};
+
+template<fp::FixedPoint NumberT>
+using Raw = typename NumberT::ValueType;
+
+/**
+ * @brief Random number: an edge case 1 time in 8 (zero, one ULP, one, half, the extremes and their
+ * neighbours), otherwise random bits of a random width, so that small magnitudes are as frequent
+ * as large ones, of either sign.
+ */
+template<fp::FixedPoint NumberT>
+NumberT RandomNumber(Random& random) noexcept
+{
+    using T = Raw<NumberT>;
+    constexpr T kMin {std::numeric_limits<T>::min()};
+    constexpr T kMax {std::numeric_limits<T>::max()};
+    constexpr std::array<T, 10> kEdges {T{0}, T{1}, static_cast<T>(kMin + 1), kMin, kMax, static_cast<T>(kMax - 1), NumberT::kScaleFactor,
+                                        static_cast<T>(NumberT::kScaleFactor >> 1), static_cast<T>(~T{0}), static_cast<T>(kMax >> 1)};
+    if (random.Below(8) == 0)
+    {
+        return NumberT::FromBits(kEdges[random.Below(kEdges.size())]);
+    }
+    const std::size_t width {1 + random.Below(NumberT::kNumBits)};
+    const std::uint64_t random_bits {random.Next()};
+    std::uint64_t bits {width >= 64 ? random_bits : random_bits & ((std::uint64_t{1} << width) - 1)};
+    // half of the signed values negative, whatever their width
+    if (NumberT::kIsSigned && (random_bits >> 63) != 0)
+    {
+        bits = ~bits;
+    }
+    return NumberT::FromBits(static_cast<T>(bits));
+}
+
+template<fp::FixedPoint NumberT>
+std::vector<NumberT> RandomNumbers(Random& random, std::size_t n) noexcept
+{
+    std::vector<NumberT> out(n);
+    for (auto& x : out)
+    {
+        x = RandomNumber<NumberT>(random);
+    }
+    return out;
+}
+
+// a batch length covering the empty batch, the tails of the kernels and several whole vectors
+std::size_t RandomLength(Random& random) noexcept
+{
+    return random.Below(4) == 0 ? random.Below(16) : random.Below(300);
+}
+
+template<fp::FixedPoint NumberT>
+std::span<const NumberT> Const(const std::vector<NumberT>& v) noexcept
+{
+    return v;
+}
+
+// the element-wise kernels of simd.hpp against the scalar operators, at unaligned offsets
+template<fp::FixedPoint NumberT>
+void CheckElementWise(Random& random, Report& report)
+{
+    const std::size_t offset {random.Below(8)};
+    const std::size_t n {RandomLength(random)};
+    const auto a_all = RandomNumbers<NumberT>(random, n + offset);
+    const auto b_all = RandomNumbers<NumberT>(random, n + offset);
+    const auto c_all = RandomNumbers<NumberT>(random, n + offset);
+    const auto a = Const(a_all).subspan(offset);
+    const auto b = Const(b_all).subspan(offset);
+    const auto c = Const(c_all).subspan(offset);
+    std::vector<NumberT> expected(n);
+    std::vector<NumberT> out(n);
+
+    const auto check = [&](std::string_view name, auto scalar, auto batch, const auto&... inputs) {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            expected[i] = scalar(i);
+        }
+        batch();
+        report.ExpectEqual<NumberT>(name, expected, out, inputs...);
+    };
+
+    check("simd::Add", [&](std::size_t i) { return a[i] + b[i]; }, [&] { fp::simd::Add<NumberT>(a, b, out); }, a, b);
+    check("simd::Sub", [&](std::size_t i) { return a[i] - b[i]; }, [&] { fp::simd::Sub<NumberT>(a, b, out); }, a, b);
+    check("simd::Mul", [&](std::size_t i) { return a[i] * b[i]; }, [&] { fp::simd::Mul<NumberT>(a, b, out); }, a, b);
+    check("simd::Fma", [&](std::size_t i) { return a[i] * b[i] + c[i]; }, [&] { fp::simd::Fma<NumberT>(a, b, c, out); }, a, b, c);
+    check("simd::Abs", [&](std::size_t i) { return Abs(a[i]); }, [&] { fp::simd::Abs<NumberT>(a, out); }, a);
+    check("simd::Min", [&](std::size_t i) { return Min(a[i], b[i]); }, [&] { fp::simd::Min<NumberT>(a, b, out); }, a, b);
+    check("simd::Max", [&](std::size_t i) { return Max(a[i], b[i]); }, [&] { fp::simd::Max<NumberT>(a, b, out); }, a, b);
+    check("simd::CopySign", [&](std::size_t i) { return CopySign(a[i], b[i]); }, [&] { fp::simd::CopySign<NumberT>(a, b, out); }, a, b);
+
+    const NumberT x {RandomNumber<NumberT>(random)};
+    const NumberT y {RandomNumber<NumberT>(random)};
+    const NumberT lo {Min(x, y)};
+    const NumberT hi {Max(x, y)};
+    check("simd::Clamp", [&](std::size_t i) { return Clamp(a[i], lo, hi); }, [&] { fp::simd::Clamp<NumberT>(a, lo, hi, out); }, a);
+
+    // in place, out aliasing the first operand
+    std::vector<NumberT> in_place(a.begin(), a.end());
+    fp::simd::Mul<NumberT>(in_place, b, in_place);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        expected[i] = a[i] * b[i];
+    }
+    report.ExpectEqual<NumberT>("simd::Mul in place", expected, in_place, a, b);
+
+    // fused fp::Vector expressions
+    fp::Vector<NumberT> va(n);
+    fp::Vector<NumberT> vb(n);
+    fp::Vector<NumberT> vc(n);
+    std::copy(a.begin(), a.end(), va.begin());
+    std::copy(b.begin(), b.end(), vb.begin());
+    std::copy(c.begin(), c.end(), vc.begin());
+    const fp::Vector<NumberT> vd = va * vb + vc - x;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        expected[i] = a[i] * b[i] + c[i] - x;
+    }
+    report.ExpectEqual<NumberT>("Vector expression", expected, std::span<const NumberT>(vd.begin(), n), a, b, c);
+
+    // the same expression with the storage from an arena, and from a pool
+    static fp::ArenaBuffer<4 * 1024 * sizeof(NumberT)> arena_buffer;
+    fp::FrameArena arena(arena_buffer.Span());
+    const fp::Vector<NumberT> arena_a(va, &arena);
+    const fp::Vector<NumberT> arena_d(arena_a * vb + vc - x, &arena);
+    report.Expect(arena.Used() >= 2 * n * sizeof(NumberT) && reinterpret_cast<std::uintptr_t>(arena_d.data()) % fp::kVectorAlignment == 0, "Vector on FrameArena");
+    report.ExpectEqual<NumberT>("Vector expression on FrameArena", expected, std::span<const NumberT>(arena_d.begin(), n), a, b, c);
+
+    static fp::ArenaBuffer<4 * 1024 * sizeof(NumberT)> pool_buffer;
+    fp::FixedPool pool(pool_buffer.Span(), 300 * sizeof(NumberT) + fp::kVectorAlignment);
+    {
+        fp::Vector<NumberT> pool_d(n, &pool);
+        pool_d = va * vb + vc - x;
+        report.Expect(pool.Used() == 1, "Vector on FixedPool");
+        report.ExpectEqual<NumberT>("Vector expression on FixedPool", expected, std::span<const NumberT>(pool_d.begin(), n), a, b, c);
+    }
+    report.Expect(pool.Used() == 0, "Vector returned to FixedPool");
+}
+
+// fp::Divider and fp::Reciprocal against operator/
+template<fp::FixedPoint NumberT>
+void CheckDivision(Random& random, Report& report)
+{
+    NumberT divisor {RandomNumber<NumberT>(random)};
+    while (divisor == NumberT::Zero())
+    {
+        divisor = RandomNumber<NumberT>(random);
+    }
+    const fp::Divider<NumberT> divider(divisor);
+    const auto dividends = RandomNumbers<NumberT>(random, RandomLength(random));
+    std::vector<NumberT> expected(dividends.size());
+    std::vector<NumberT> out(dividends.size());
+    for (std::size_t i = 0; i < dividends.size(); ++i)
+    {
+        expected[i] = dividends[i] / divisor;
+        out[i] = dividends[i] / divider;
+    }
+    if (!report.ExpectEqual<NumberT>("Divider", expected, out, Const(dividends)))
+    {
+        std::cout << "  divisor " << Printable(divisor.Bits()) << "\n";
+    }
+
+    // bit-exact with the truncating division wherever 1 / x is representable
+    if constexpr (std::is_same_v<typename NumberT::RoundingType, fp::Truncate> && requires(NumberT x) { fp::Reciprocal(x); })
+    {
+        using Wide = fp::detail::MakeUnsignedT<typename NumberT::WideValueType>;
+        std::vector<NumberT> x;
+        for (const NumberT& d : dividends)
+        {
+            const auto magnitude = fp::detail::Magnitude<Wide>(static_cast<typename NumberT::WideValueType>(d.Bits()));
+            if (magnitude != 0 && (Wide{1} << (2 * NumberT::kNumFracBits)) / magnitude <= static_cast<Wide>(std::numeric_limits<Raw<NumberT>>::max()))
+            {
+                x.push_back(d);
+            }
+        }
+        expected.resize(x.size());
+        out.resize(x.size());
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            expected[i] = NumberT::PosOne() / x[i];
+            out[i] = fp::Reciprocal(x[i]);
+        }
+        report.ExpectEqual<NumberT>("Reciprocal", expected, out, Const(x));
+    }
+}
+
+// a float or double near a random value of NumberT, out of range values, NaN and infinities only where they saturate
+template<fp::FixedPoint NumberT, typename FloatType>
+FloatType RandomFloat(Random& random) noexcept
+{
+    constexpr bool kSaturates {std::is_same_v<typename NumberT::OverflowType, fp::Saturate>};
+    if (kSaturates && random.Below(16) == 0)
+    {
+        constexpr std::array<FloatType, 5> kSpecial {std::numeric_limits<FloatType>::quiet_NaN(), std::numeric_limits<FloatType>::infinity(),
+                                                     -std::numeric_limits<FloatType>::infinity(), FloatType{1e30f}, FloatType{-1e30f}};
+        return kSpecial[random.Below(kSpecial.size())];
+    }
+    // fp::Wrap leaves out of range values undefined, a halved value stays clear of the ends after rounding to FloatType
+    auto raw = static_cast<double>(RandomNumber<NumberT>(random).Bits());
+    if (!kSaturates)
+    {
+        raw /= 2;
+    }
+    return static_cast<FloatType>((raw + random.Unit() * 2 - 1) / static_cast<double>(NumberT::kScaleFactor));
+}
+
+// bulk float conversions (floats.hpp) against the converting constructor and operator
+template<fp::FixedPoint NumberT, typename FloatType>
+void CheckFloats(Random& random, Report& report)
+{
+    const std::size_t n {RandomLength(random)};
+    std::vector<FloatType> floats(n);
+    for (auto& f : floats)
+    {
+        f = RandomFloat<NumberT, FloatType>(random);
+    }
+    std::vector<NumberT> expected(n);
+    std::vector<NumberT> out(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        expected[i] = NumberT(floats[i]);
+    }
+    fp::FromFloats<NumberT>(std::span<const FloatType>(floats), out);
+    if (!report.ExpectEqual<NumberT>(std::is_same_v<FloatType, float> ? "FromFloats(float)" : "FromFloats(double)", expected, out))
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (expected[i] != out[i])
+            {
+                std::cout << "  input " << floats[i] << "\n";
+                break;
+            }
+        }
+    }
+
+    const auto numbers = RandomNumbers<NumberT>(random, n);
+    std::vector<FloatType> converted(n);
+    fp::ToFloats<NumberT>(numbers, converted);
+    bool ok {true};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        // compared as bits, so that the check is exact
+        ok = ok && std::bit_cast<std::conditional_t<std::is_same_v<FloatType, float>, std::uint32_t, std::uint64_t>>(converted[i]) ==
+                   std::bit_cast<std::conditional_t<std::is_same_v<FloatType, float>, std::uint32_t, std::uint64_t>>(static_cast<FloatType>(numbers[i]));
+    }
+    report.Expect(ok, std::is_same_v<FloatType, float> ? "ToFloats(float)" : "ToFloats(double)");
+}
+
+// the exact raw sum of products, one product at a time
+template<fp::FixedPoint NumberT>
+auto ScalarSum(std::span<const NumberT> a, std::span<const NumberT> b) noexcept
+{
+    fp::Accumulator<NumberT> sum;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        sum.MulAdd(a[i], b[i]);
+    }
+    return sum;
+}
+
+// vectorized sums of products (accumulator.hpp, channels.hpp, matrix.hpp, filter.hpp, algorithm.hpp), for accumulators with headroom
+template<fp::FixedPoint NumberT>
+void CheckSums(Random& random, Report& report)
+{
+    // full-scale operands, at most 2^8 products
+    const std::size_t n {std::min<std::size_t>(RandomLength(random), 255)};
+    const auto a = RandomNumbers<NumberT>(random, n);
+    const auto b = RandomNumbers<NumberT>(random, n);
+    fp::Accumulator<NumberT> batch;
+    batch.MulAdd(Const(a), Const(b));
+    const auto scalar = ScalarSum<NumberT>(a, b);
+    report.Expect(batch.Raw() == scalar.Raw(), "Accumulator::MulAdd(span)");
+    report.Expect(fp::Dot<NumberT>(a, b) == scalar.Result(), "Dot");
+
+    // channel operations over interleaved frames
+    const std::size_t channels {1 + random.Below(12)};
+    const std::size_t frames {random.Below(40)};
+    const auto in = RandomNumbers<NumberT>(random, channels * frames);
+    const auto gains = RandomNumbers<NumberT>(random, channels);
+    std::vector<NumberT> expected(channels * frames);
+    std::vector<NumberT> out(channels * frames);
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        expected[i] = in[i] * gains[i % channels];
+    }
+    fp::simd::MulChannels<NumberT>(in, gains, out);
+    report.ExpectEqual<NumberT>("simd::MulChannels", expected, out, Const(in));
+
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        expected[f] = ScalarSum<NumberT>(Const(in).subspan(f * channels, channels), gains).Result();
+    }
+    fp::simd::MixChannels<NumberT>(in, gains, std::span<NumberT>(out).first(frames));
+    report.ExpectEqual<NumberT>("simd::MixChannels", Const(expected).first(frames), Const(out).first(frames));
+
+    for (std::size_t f = 0; f < frames; ++f)
+    {
+        fp::Accumulator<NumberT> sum;
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            sum += in[f * channels + c];
+        }
+        expected[f] = sum.Result();
+    }
+    fp::simd::SumChannels<NumberT>(in, channels, std::span<NumberT>(out).first(frames));
+    report.ExpectEqual<NumberT>("simd::SumChannels", Const(expected).first(frames), Const(out).first(frames));
+
+    fp::simd::Deinterleave<NumberT>(in, channels, out);
+    bool transposed {true};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        transposed = transposed && out[(i % channels) * frames + i / channels] == in[i];
+    }
+    report.Expect(transposed, "simd::Deinterleave");
+    fp::simd::Interleave<NumberT>(Const(out), channels, std::span<NumberT>(expected));
+    report.ExpectEqual<NumberT>("simd::Interleave", Const(in), Const(expected));
+
+    // matrix product, every element the Dot() of a row and a column
+    const std::size_t m {1 + random.Below(9)};
+    const std::size_t k {1 + random.Below(40)};
+    const std::size_t p {1 + random.Below(9)};
+    const auto lhs = RandomNumbers<NumberT>(random, m * k);
+    const auto rhs = RandomNumbers<NumberT>(random, k * p);
+    std::vector<NumberT> product(m * p);
+    fp::Gemm<NumberT>(m, p, k, lhs, rhs, product);
+    std::vector<NumberT> reference(m * p);
+    std::vector<NumberT> column(k);
+    for (std::size_t j = 0; j < p; ++j)
+    {
+        for (std::size_t q = 0; q < k; ++q)
+        {
+            column[q] = rhs[q * p + j];
+        }
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            reference[i * p + j] = ScalarSum<NumberT>(Const(lhs).subspan(i * k, k), column).Result();
+        }
+    }
+    report.ExpectEqual<NumberT>("Gemm", Const(reference), Const(product));
+
+    static fp::ArenaBuffer<64 * 1024> gemm_buffer;
+    fp::FrameArena arena(gemm_buffer.Span());
+    fp::Gemm<NumberT>(m, p, k, lhs, rhs, product, &arena);
+    report.Expect(arena.Peak() <= fp::GemmScratchBytes<NumberT>(m, p, k), "GemmScratchBytes");
+    report.ExpectEqual<NumberT>("Gemm on FrameArena", Const(reference), Const(product));
+
+    // FIR blocks of random sizes against sample by sample filtering
+    std::array<NumberT, 19> taps;
+    for (auto& tap : taps)
+    {
+        tap = RandomNumber<NumberT>(random);
+    }
+    fp::FIR<NumberT, taps.size()> block_fir(taps);
+    fp::FIR<NumberT, taps.size()> sample_fir(taps);
+    const auto signal = RandomNumbers<NumberT>(random, 2 * RandomLength(random));
+    std::vector<NumberT> filtered(signal.size());
+    std::vector<NumberT> filtered_samples(signal.size());
+    for (std::size_t i = 0; i < signal.size();)
+    {
+        const std::size_t block {std::min(signal.size() - i, random.Below(64))};
+        block_fir.Process(Const(signal).subspan(i, block), std::span<NumberT>(filtered).subspan(i, block));
+        i += block;
+    }
+    for (std::size_t i = 0; i < signal.size(); ++i)
+    {
+        filtered_samples[i] = sample_fir.Process(signal[i]);
+    }
+    report.ExpectEqual<NumberT>("FIR::Process(span)", Const(filtered_samples), Const(filtered), Const(signal));
+
+    // parallel reduction, large enough to run on several threads when there are some
+    const auto values = RandomNumbers<NumberT>(random, 3 * fp::detail::kMinChunkSize + random.Below(1000));
+    fp::Accumulator<NumberT> total;
+    for (const auto& v : values)
+    {
+        total += v;
+    }
+    report.Expect(fp::Reduce<NumberT>(std::execution::par, values) == total.Result(), "Reduce(par)");
+}
+
+// interleaved biquads filtered in vector lanes against one section per channel
+template<fp::FixedPoint NumberT, fp::BiquadForm Form>
+void CheckBiquad(Random& random, Report& report)
+{
+    constexpr std::size_t kChannels {9};
+    using Coefficients = fp::BiquadCoefficients<NumberT>;
+    std::array<Coefficients, kChannels> coefficients;
+    for (auto& k : coefficients)
+    {
+        k = {RandomNumber<NumberT>(random), RandomNumber<NumberT>(random), RandomNumber<NumberT>(random), RandomNumber<NumberT>(random),
+             RandomNumber<NumberT>(random)};
+    }
+    fp::Biquad<NumberT, Form, NumberT, kChannels> multi(coefficients);
+    const std::size_t frames {RandomLength(random)};
+    const auto in = RandomNumbers<NumberT>(random, kChannels * frames);
+    std::vector<NumberT> out(in.size());
+    for (std::size_t f = 0; f < frames;)
+    {
+        const std::size_t block {std::min(frames - f, random.Below(48))};
+        multi.Process(Const(in).subspan(f * kChannels, block * kChannels), std::span<NumberT>(out).subspan(f * kChannels, block * kChannels));
+        f += block;
+    }
+
+    std::vector<NumberT> expected(in.size());
+    for (std::size_t c = 0; c < kChannels; ++c)
+    {
+        fp::Biquad<NumberT, Form, NumberT> single(coefficients[c]);
+        for (std::size_t f = 0; f < frames; ++f)
+        {
+            expected[f * kChannels + c] = single.Process(in[f * kChannels + c]);
+        }
+    }
+    report.ExpectEqual<NumberT>(Form == fp::BiquadForm::DirectI ? "Biquad<DirectI, 9 channels>" : "Biquad<TransposedII, 9 channels>", Const(expected), Const(out), Const(in));
+}
+
+// complex products of IQ buffers
+template<fp::FixedPoint NumberT>
+void CheckComplex(Random& random, Report& report)
+{
+    using C = fp::Complex<NumberT>;
+    const std::size_t n {RandomLength(random)};
+    std::vector<C> a(n);
+    std::vector<C> b(n);
+    std::vector<C> out(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        a[i] = {RandomNumber<NumberT>(random), RandomNumber<NumberT>(random)};
+        b[i] = {RandomNumber<NumberT>(random), RandomNumber<NumberT>(random)};
+    }
+    fp::simd::Mul<NumberT>(std::span<const C>(a), std::span<const C>(b), std::span<C>(out));
+    bool batch_ok {true};
+    bool mul3_ok {true};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        batch_ok = batch_ok && out[i] == a[i] * b[i];
+        mul3_ok = mul3_ok && fp::Mul3(a[i], b[i]) == a[i] * b[i];
+    }
+    report.Expect(batch_ok, "simd::Mul(Complex)");
+    report.Expect(mul3_ok, "Mul3");
+}
+
+// roots: batches bit-exact with the scalar functions, Sqrt() exact, the fast roots within their bound
+template<fp::FixedPoint NumberT>
+void CheckRoots(Random& random, Report& report)
+{
+    const std::size_t n {RandomLength(random)};
+    const auto in = RandomNumbers<NumberT>(random, n);
+    std::vector<NumberT> expected(n);
+    std::vector<NumberT> out(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        expected[i] = fp::Sqrt(in[i]);
+    }
+    fp::simd::Sqrt<NumberT>(in, out);
+    report.ExpectEqual<NumberT>("simd::Sqrt", Const(expected), Const(out), Const(in));
+
+    // floor(sqrt(raw * 2^kNumFracBits)): r^2 <= v < (r + 1)^2
+    bool exact {true};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (in[i] > NumberT::Zero())
+        {
+            const auto v = static_cast<fp::uint128>(static_cast<std::uint64_t>(in[i].Bits())) << NumberT::kNumFracBits;
+            const auto r = static_cast<fp::uint128>(static_cast<std::uint64_t>(expected[i].Bits()));
+            exact = exact && r * r <= v && (r + 1) * (r + 1) > v;
+        }
+    }
+    report.Expect(exact, "Sqrt exact");
+
+    // the bounds of the fast roots hold up to 24 fractional bits, above them the Q30 work format adds a few ULP
+    constexpr bool kRootBound {NumberT::kNumFracBits <= 24};
+    bool fast_sqrt_bound {true};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const NumberT fast {fp::FastSqrt(in[i])};
+        fast_sqrt_bound = fast_sqrt_bound && std::abs(static_cast<std::int64_t>(fast.Bits()) - static_cast<std::int64_t>(expected[i].Bits())) <= kFastRootMaxUlp;
+        expected[i] = fast;
+    }
+    report.Expect(!kRootBound || fast_sqrt_bound, "FastSqrt error bound");
+    fp::simd::FastSqrt<NumberT>(in, out);
+    report.ExpectEqual<NumberT>("simd::FastSqrt", Const(expected), Const(out), Const(in));
+
+    // the bound of FastInvSqrt() holds from 2^-8 on, where the result is representable
+    constexpr double kMaxValue {static_cast<double>(std::numeric_limits<Raw<NumberT>>::max()) / static_cast<double>(NumberT::kScaleFactor)};
+    bool fast_inv_bound {true};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        expected[i] = fp::FastInvSqrt(in[i]);
+        const bool representable {1 / std::sqrt(static_cast<double>(in[i])) < kMaxValue};
+        if (in[i].Bits() >= (NumberT::kScaleFactor >> 8) && representable)
+        {
+            const auto exact_inverse = static_cast<std::int64_t>(fp::InvSqrt(in[i]).Bits());
+            fast_inv_bound = fast_inv_bound && std::abs(static_cast<std::int64_t>(expected[i].Bits()) - exact_inverse) <= kFastRootMaxUlp;
+        }
+    }
+    report.Expect(!kRootBound || fast_inv_bound, "FastInvSqrt error bound");
+    fp::simd::FastInvSqrt<NumberT>(in, out);
+    report.ExpectEqual<NumberT>("simd::FastInvSqrt", Const(expected), Const(out), Const(in));
+}
+
+// error of result against the exact value, in ULP of NumberT
+template<fp::FixedPoint NumberT>
+double UlpError(NumberT result, double exact) noexcept
+{
+    return std::abs(static_cast<double>(result) - exact) * static_cast<double>(NumberT::kScaleFactor);
+}
+
+// the transcendental functions of both backends against double, within the bounds stated in math.hpp
+template<fp::FixedPoint NumberT, fp::MathBackend Backend>
+void CheckMath(Random& random, Report& report)
+{
+    const auto uniform = [&](double lo, double hi) { return NumberT(lo + (hi - lo) * random.Unit()); };
+    constexpr std::string_view kBackend {Backend == fp::MathBackend::Table ? "Table" : "Cordic"};
+    double sin_cos {0};
+    double atan2 {0};
+    double exp {0};
+    double log {0};
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        const NumberT x {uniform(-8, 8)};
+        sin_cos = std::max({sin_cos, UlpError(fp::Sin<Backend>(x), std::sin(static_cast<double>(x))), UlpError(fp::Cos<Backend>(x), std::cos(static_cast<double>(x)))});
+        const NumberT y {uniform(-100, 100)};
+        const NumberT z {uniform(-100, 100)};
+        atan2 = std::max(atan2, UlpError(fp::Atan2<Backend>(y, z), std::atan2(static_cast<double>(y), static_cast<double>(z))));
+        // results below 1, the larger ones have a relative bound
+        const NumberT e {uniform(-10, 0)};
+        exp = std::max(exp, UlpError(fp::Exp<Backend>(e), std::exp(static_cast<double>(e))));
+        const NumberT l {NumberT::FromBits(static_cast<Raw<NumberT>>(1 + random.Below(std::numeric_limits<Raw<NumberT>>::max())))};
+        log = std::max(log, UlpError(fp::Log<Backend>(l), std::log(static_cast<double>(l))));
+    }
+    const auto expect = [&](double error, std::string_view function) {
+        if (!report.Expect(error <= kMathMaxUlp, function))
+        {
+            std::cout << "  " << kBackend << " error " << error << " ULP\n";
+        }
+    };
+    expect(sin_cos, "Sin / Cos error bound");
+    expect(atan2, "Atan2 error bound");
+    expect(exp, "Exp error bound");
+    expect(log, "Log error bound");
+}
+
+// a stream through fp::RingBuffer between two threads, in regions of random sizes, arrives unchanged and in order
+template<fp::FixedPoint NumberT>
+void CheckRingBuffer(Random& random, Report& report)
+{
+    const auto stream = RandomNumbers<NumberT>(random, std::size_t{1} << 18);
+    std::vector<NumberT> received(stream.size());
+    fp::RingBuffer<NumberT> ring(1 + random.Below(2000));
+    const std::uint64_t producer_seed {random.Next()};
+    std::jthread producer([&] {
+        Random sizes(producer_seed);
+        for (std::size_t sent = 0; sent < stream.size();)
+        {
+            const auto region = ring.WriteRegion();
+            const std::size_t n {std::min({region.size(), stream.size() - sent, 1 + sizes.Below(300)})};
+            if (n == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            std::copy_n(stream.data() + sent, n, region.data());
+            ring.CommitWrite(n);
+            sent += n;
+        }
+    });
+    for (std::size_t done = 0; done < received.size();)
+    {
+        // half of the reads through Pop(), the others in place
+        std::size_t n {0};
+        if (random.Below(2) == 0)
+        {
+            n = ring.Pop(std::span<NumberT>(received).subspan(done, std::min(received.size() - done, 1 + random.Below(300))));
+        }
+        else
+        {
+            const auto region = ring.ReadRegion();
+            n = region.size();
+            std::copy(region.begin(), region.end(), received.begin() + static_cast<std::ptrdiff_t>(done));
+            ring.CommitRead(n);
+        }
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        done += n;
+    }
+    producer.join();
+    report.ExpectEqual<NumberT>("RingBuffer", Const(stream), Const(received));
+    report.Expect(ring.Empty(), "RingBuffer empty");
+}
+
+// Div<C>() and Mul<C>() against operator/ and operator* with NumberT(C), for every constant
+template<fp::FixedPoint NumberT, auto... Constants>
+void CheckConstantsOf(const std::vector<NumberT>& x, Report& report)
+{
+    std::vector<NumberT> expected(x.size());
+    std::vector<NumberT> out(x.size());
+    const auto check = [&]<auto C>() {
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            expected[i] = x[i] / NumberT(C);
+            out[i] = x[i].template Div<C>();
+        }
+        report.ExpectEqual<NumberT>("Div<C>()", Const(expected), Const(out), Const(x));
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            expected[i] = x[i] * NumberT(C);
+            out[i] = x[i].template Mul<C>();
+        }
+        report.ExpectEqual<NumberT>("Mul<C>()", Const(expected), Const(out), Const(x));
+    };
+    (check.template operator()<Constants>(), ...);
+}
+
+// compile-time constant operations, with the constants representable in NumberT
+template<fp::FixedPoint NumberT>
+void CheckConstants(Random& random, Report& report)
+{
+    const auto x = RandomNumbers<NumberT>(random, RandomLength(random));
+    CheckConstantsOf<NumberT, 0.5, 0.375, 0.3, 0.75, 0.125>(x, report);
+    if constexpr (NumberT::kNumIntBits >= 5)
+    {
+        CheckConstantsOf<NumberT, 3, 4, 10, 2.75>(x, report);
+    }
+    if constexpr (NumberT::kIsSigned)
+    {
+        CheckConstantsOf<NumberT, -0.375, -0.5>(x, report);
+    }
+    if constexpr (NumberT::kIsSigned && NumberT::kNumIntBits >= 5)
+    {
+        CheckConstantsOf<NumberT, -7, -1>(x, report);
+    }
+}
+
+// fp::WideNumber of one limb against the 64-bit NumberT of the same format, and the multi-limb
+// products and quotients against their definitions, through the adc / divq paths of run time
+template<fp::FixedPoint NumberT>
+void CheckWideNumber(Random& random, Report& report)
+{
+    using Wide = fp::WideNumber<1, NumberT::kNumFracBits>;
+    const std::size_t n {RandomLength(random)};
+    const auto a = RandomNumbers<NumberT>(random, n);
+    const auto b = RandomNumbers<NumberT>(random, n);
+    std::vector<NumberT> expected(n);
+    std::vector<NumberT> out(n);
+    const auto expect = [&](std::string_view check, auto op, auto wide_op) {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            expected[i] = op(a[i], b[i]);
+            out[i] = static_cast<NumberT>(wide_op(Wide(a[i]), Wide(b[i])));
+        }
+        report.ExpectEqual<NumberT>(check, Const(expected), Const(out), Const(a), Const(b));
+    };
+    expect("WideNumber +", std::plus<>{}, std::plus<>{});
+    expect("WideNumber -", std::minus<>{}, std::minus<>{});
+    expect("WideNumber *", std::multiplies<>{}, std::multiplies<>{});
+    // x / 0 is undefined for NumberT and traps for WideNumber, a zero divisor divides by one instead
+    const auto divide = [](const auto& x, const auto& y) { return y == std::remove_cvref_t<decltype(y)>(0) ? x : x / y; };
+    expect("WideNumber /", divide, divide);
+
+    using fp::detail::LimbArray;
+    constexpr std::size_t kLimbs {fp::detail::kKaratsubaLimbs};
+    LimbArray<kLimbs> x {};
+    LimbArray<kLimbs> y {};
+    for (std::size_t i = 0; i < kLimbs; ++i)
+    {
+        // runs of zero and all-ones limbs reach the carries and borrows at the ends of every half
+        x[i] = random.Below(4) == 0 ? 0 : random.Below(4) == 0 ? ~std::uint64_t{0} : random.Next();
+        y[i] = random.Below(4) == 0 ? 0 : random.Below(4) == 0 ? ~std::uint64_t{0} : random.Next();
+    }
+    const auto product = fp::detail::MultiplyLimbs(x, y);
+    report.Expect(product == fp::detail::MulSchoolbook(x, y), "Karatsuba product");
+
+    // floor(product / y) gives back x when y isn't zero
+    y[0] |= 1;
+    const auto divisor_limbs = 1 + random.Below(kLimbs);
+    std::fill(y.begin() + static_cast<std::ptrdiff_t>(divisor_limbs), y.end(), 0);
+    const auto quotient = fp::detail::DivideLimbs(fp::detail::MulSchoolbook(x, y), y);
+    report.Expect(std::equal(x.begin(), x.end(), quotient.begin()) && std::all_of(quotient.begin() + kLimbs, quotient.end(), [](std::uint64_t limb) { return limb == 0; }),
+                  "long division");
+}
+
+// fp::ProfileRegion on two threads: totals of nested regions and the events of the trace
+void CheckProfile(Random& random, Report& report)
+{
+    fp::ResetProfile();
+    const std::size_t calls {1 + random.Below(100)};
+    const std::size_t elements {random.Below(1000)};
+    const auto record = [&] {
+        for (std::size_t i = 0; i < calls; ++i)
+        {
+            const fp::ProfileRegion outer("fuzz/outer", elements);
+            const fp::ProfileRegion inner("fuzz/inner");
+        }
+    };
+    record();
+    std::jthread(record).join();
+
+    const auto profile = fp::ReadProfile();
+    const auto find = [&profile](std::string_view name) {
+        const auto entry = std::find_if(profile.begin(), profile.end(), [name](const fp::ProfileEntry& e) { return e.name == name; });
+        return entry == profile.end() ? fp::ProfileEntry{} : *entry;
+    };
+    const auto outer = find("fuzz/outer");
+    const auto inner = find("fuzz/inner");
+    report.Expect(outer.calls == 2 * calls && outer.elements == 2 * calls * elements && inner.calls == 2 * calls && inner.elements == 0,
+                  "profile totals");
+
+    std::ostringstream trace;
+    fp::WriteChromeTrace(trace);
+    const std::string text {trace.str()};
+    std::size_t events {0};
+    for (std::size_t at = text.find("\"name\":\"fuzz/outer\""); at != std::string::npos; at = text.find("\"name\":\"fuzz/outer\"", at + 1))
+    {
+        ++events;
+    }
+    report.Expect(events == 2 * calls && fp::DroppedProfileEvents() == 0 && text.ends_with("]}\n"), "profile trace");
+}
+
+// the per-type counters of fp::Instrumented: two formats sharing the policy, two sharing a Tag, counted on two threads
+void CheckCounters(Report& report)
+{
+    struct SharedTag;
+    using Q16 = fp::Number<std::int32_t, std::int64_t, 16, fp::Instrumented<fp::Saturate>>;
+    using Q8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Instrumented<fp::Saturate>>;
+    using TaggedQ16 = fp::Number<std::int32_t, std::int64_t, 16, fp::Instrumented<fp::Saturate, SharedTag>>;
+    using TaggedQ8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Instrumented<fp::Saturate, SharedTag>>;
+    fp::ResetCounters<Q16>();
+    fp::ResetCounters<Q8>();
+    fp::ResetCounters<TaggedQ16>();
+    fp::ResetCounters<TaggedQ8>();
+
+    const auto record = [] {
+        // the constructors narrow 3 * 2^16 for the Q16 types and 200 * 2^8, out of range, for the Q8 ones
+        const Q16 a {3.0};
+        const Q8 b {200.0};
+        const TaggedQ16 c {-3.0};
+        const TaggedQ8 d {-200.0};
+        return a.Bits() == 3 << 16 && b.Bits() == std::numeric_limits<std::int16_t>::max() && c.Bits() == -(3 << 16) &&
+               d.Bits() == std::numeric_limits<std::int16_t>::min();
+    };
+    // not const: the initializer of a const bool is evaluated at compile time when it can be, which counts nothing
+    bool saturated {record()};
+    std::jthread([&record] { static_cast<void>(record()); }).join();
+
+    const fp::Counters q16 {fp::ReadCounters<Q16>()};
+    const fp::Counters q8 {fp::ReadCounters<Q8>()};
+    report.Expect(saturated && q16.overflows == 0 && q16.max_magnitude == 3 << 16 && q16.max_value == 3.0 && q8.overflows == 2 &&
+                      q8.max_magnitude == 200 << 8 && q8.max_value == 200.0,
+                  "counters per type");
+    const fp::Counters tagged_q16 {fp::ReadCounters<TaggedQ16>()};
+    const fp::Counters tagged_q8 {fp::ReadCounters<TaggedQ8>()};
+    report.Expect(tagged_q16.overflows == 2 && tagged_q8.overflows == 2 && tagged_q16.max_value == 3.0 && tagged_q8.max_value == 200.0,
+                  "counters shared by a tag");
+}
+
+// the scalar stages of fp::FFT, which the vector ones must match bit for bit, returns the block exponent
+template<fp::FixedPoint NumberT, std::size_t N, bool Inverse>
+int ScalarFFT(std::span<fp::Complex<NumberT>, N> data)
+{
+    static const auto kTwiddles = fp::detail::MakeTwiddles<NumberT, N, Inverse>();
+    constexpr int kBits {std::countr_zero(N)};
+    for (std::uint32_t i = 0; i < N; ++i)
+    {
+        const std::uint32_t j {fp::detail::ReverseBits(i, kBits)};
+        if (i < j)
+        {
+            std::swap(data[i], data[j]);
+        }
+    }
+    auto max = fp::detail::MaxMagnitude<NumberT>(data);
+    const auto* twiddles = kTwiddles.data();
+    int total {0};
+    std::size_t q {1};
+    for (std::size_t stage = 0; stage < fp::detail::kRadix4Stages<N>; ++stage, q *= 4)
+    {
+        const int shift {fp::detail::StageShift<NumberT, true>(max)};
+        max = fp::detail::Radix4Stage<NumberT, Inverse>(data, q, twiddles, shift);
+        total += shift;
+        twiddles += 12 * q;
+    }
+    if constexpr (fp::detail::kHasRadix2Stage<N>)
+    {
+        const int shift {fp::detail::StageShift<NumberT, false>(max)};
+        fp::detail::Radix2Stage<NumberT>(data, twiddles, shift);
+        total += shift;
+    }
+    return total;
+}
+
+// fp::FFT of size N against its scalar stages: forward on full-scale and small random inputs, inverse of the spectra
+template<fp::FixedPoint NumberT, std::size_t N>
+void CheckFFTOfSize(Random& random, Report& report)
+{
+    using Raw = typename NumberT::ValueType;
+    const fp::FFT<NumberT, N> plan;
+    std::array<fp::Complex<NumberT>, N> data;
+    std::array<fp::Complex<NumberT>, N> expected;
+    for (const bool small : {false, true})
+    {
+        // small inputs have a few bits, the stages then shift less and the roundings are close to ties
+        const std::size_t bits {1 + random.Below(8)};
+        const auto raw = [&] {
+            return small ? static_cast<Raw>(static_cast<std::int64_t>(random.Below(std::size_t{2} << bits)) - (std::int64_t{1} << bits)) : static_cast<Raw>(random.Next());
+        };
+        for (auto& x : data)
+        {
+            x = {NumberT::FromBits(raw()), NumberT::FromBits(raw())};
+        }
+        expected = data;
+        const int shift {plan.Forward(data)};
+        report.Expect(shift == ScalarFFT<NumberT, N, false>(expected) && data == expected, "FFT::Forward");
+        expected = data;
+        const int inverse_shift {plan.Inverse(data)};
+        report.Expect(inverse_shift == ScalarFFT<NumberT, N, true>(expected) && data == expected, "FFT::Inverse");
+    }
+}
+
+// fp::FFT of every size with distinct vector paths, from a single group of lanes to several radix-4 stages of groups
+template<fp::FixedPoint NumberT>
+void CheckFFT(Random& random, Report& report)
+{
+    [&]<std::size_t... Logs>(std::index_sequence<Logs...>) {
+        (CheckFFTOfSize<NumberT, std::size_t{8} << Logs>(random, report), ...);
+    }(std::make_index_sequence<9>{});
+}
+
+#if defined(__cpp_lib_format)
+// std::format() of fp::Number against fp::ToChars(), exact and with precisions up to a few digits beyond kNumFracBits
+template<fp::FixedPoint NumberT>
+void CheckFormat(Random& random, Report& report)
+{
+    const auto x = RandomNumbers<NumberT>(random, RandomLength(random));
+    std::array<char, fp::kMaxCharsExact<NumberT> + 16> buffer;
+    bool exact {true};
+    bool fixed {true};
+    for (const NumberT& v : x)
+    {
+        auto result = fp::ToChars(buffer.data(), buffer.data() + buffer.size(), v);
+        exact = exact && std::format("{}", v) == std::string_view(buffer.data(), result.ptr);
+        const auto precision = static_cast<int>(random.Below(NumberT::kNumFracBits + 8));
+        result = fp::ToChars(buffer.data(), buffer.data() + buffer.size(), v, precision);
+        fixed = fixed && std::vformat("{:." + std::to_string(precision) + "}", std::make_format_args(v)) == std::string_view(buffer.data(), result.ptr);
+    }
+    report.Expect(exact, "std::format {}");
+    report.Expect(fixed, "std::format {:.N}");
+}
+#endif
+
+// runs every check that applies to NumberT
+template<fp::FixedPoint NumberT>
+std::size_t Run(std::string_view name, std::size_t rounds, std::uint64_t seed)
+{
+    Report report(name, seed);
+    Random random(seed ^ std::hash<std::string_view>{}(name));
+    for (std::size_t round = 0; round < rounds; ++round)
+    {
+        report.SetRound(round);
+        if (round == 0)
+        {
+            CheckRingBuffer<NumberT>(random, report);
+            CheckProfile(random, report);
+            CheckCounters(report);
+        }
+        CheckElementWise<NumberT>(random, report);
+        CheckDivision<NumberT>(random, report);
+        CheckConstants<NumberT>(random, report);
+        CheckFloats<NumberT, float>(random, report);
+        CheckFloats<NumberT, double>(random, report);
+        if constexpr (fp::Accumulator<NumberT>::kHeadroomBits >= 8)
+        {
+            CheckSums<NumberT>(random, report);
+        }
+        if constexpr (NumberT::kIsSigned && NumberT::kNumBits <= 32)
+        {
+            CheckBiquad<NumberT, fp::BiquadForm::DirectI>(random, report);
+            CheckBiquad<NumberT, fp::BiquadForm::TransposedII>(random, report);
+            CheckRoots<NumberT>(random, report);
+        }
+        if constexpr (NumberT::kIsSigned && NumberT::kNumBits <= 16)
+        {
+            CheckComplex<NumberT>(random, report);
+        }
+        if constexpr (std::is_same_v<NumberT, FP_S32_16>)
+        {
+            CheckMath<NumberT, fp::MathBackend::Table>(random, report);
+            CheckMath<NumberT, fp::MathBackend::Cordic>(random, report);
+        }
+        if constexpr (NumberT::kIsSigned && NumberT::kNumBits == 64)
+        {
+            CheckWideNumber<NumberT>(random, report);
+        }
+        // the FFT works on the raw bits, the Q formats cover both vector paths
+        if constexpr (NumberT::kIsSigned && NumberT::kNumBits <= 32 && NumberT::kNumFracBits + 1 == NumberT::kNumBits)
+        {
+            CheckFFT<NumberT>(random, report);
+        }
+#if defined(__cpp_lib_format)
+        CheckFormat<NumberT>(random, report);
+#endif
+    }
+    std::cout << name << ": " << report.Checks() << " checks, " << report.Failures() << " failures\n";
+    return report.Failures();
+}
+
+// parses a non-negative integer argument
+bool Parse(std::string_view text, std::uint64_t& value) noexcept
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::uint64_t rounds {200};
+    std::uint64_t seed {0x5EEDF1CEDULL};
+    if (argc > 3 || (argc > 1 && !Parse(argv[1], rounds)) || (argc > 2 && !Parse(argv[2], seed)))
+    {
+        std::cerr << "usage: " << argv[0] << " [rounds] [seed]\n";
+        return 2;
+    }
+
+    std::size_t failures {0};
+    failures += Run<FP_S32_16>("S32_16", rounds, seed);
+    failures += Run<FP_U32_16>("U32_16", rounds, seed);
+    failures += Run<FP_S16_8>("S16_8", rounds, seed);
+    failures += Run<FP_U16_8>("U16_8", rounds, seed);
+    failures += Run<FP_S64_32>("S64_32", rounds, seed);
+    failures += Run<FP_U64_32>("U64_32", rounds, seed);
+    failures += Run<FP_S32_16_Sat>("S32_16_Sat", rounds, seed);
+    failures += Run<FP_S16_8_Sat>("S16_8_Sat", rounds, seed);
+    failures += Run<FP_U16_8_Sat>("U16_8_Sat", rounds, seed);
+    failures += Run<FP_S32_16_HalfEven>("S32_16_HalfEven", rounds, seed);
+    failures += Run<FP_S16_8_HalfUp>("S16_8_Sat_HalfUp", rounds, seed);
+    failures += Run<FP_Q15>("Q15", rounds, seed);
+    failures += Run<FP_Q30>("Q30", rounds, seed);
+    failures += Run<FP_Q31>("Q31", rounds, seed);
+    failures += Run<FP_S32_8>("S32_8", rounds, seed);
+    return failures == 0 ? 0 : 1;
+}
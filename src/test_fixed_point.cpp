@@ -1,7 +1,36 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
 #include "fixed_point.hpp"
+#include "accumulator.hpp"
+#include "algorithm.hpp"
+#include "channels.hpp"
+#include "charconv.hpp"
+#include "complex.hpp"
+#include "fast_div.hpp"
+#include "fft.hpp"
+#include "filter.hpp"
+#include "floats.hpp"
+#include "instrument.hpp"
+#include "mapped_array.hpp"
+#include "math.hpp"
+#include "matrix.hpp"
+#include "memory.hpp"
+#include "ring_buffer.hpp"
+#include "simd.hpp"
+#include "table.hpp"
+#include "vector.hpp"
+#include "wide_number.hpp"
 
 using FP_S32_16 = fp::Number<std::int32_t, std::int64_t, 16>;
 using FP_U32_16 = fp::Number<std::uint32_t, std::uint64_t, 16>;
+using FP_S64_32 = fp::Number<std::int64_t, fp::int128, 32>;
+using FP_U64_32 = fp::Number<std::uint64_t, fp::uint128, 32>;
 
 // compile-time test cases
 constexpr bool TestConstructionSignedFromInt()
@@ -121,6 +150,1072 @@ constexpr bool TestSignSignedNegative()
     return FP_S32_16::Sign(FP_S32_16(-123)) == FP_S32_16::NegOne();
 }
 
+constexpr bool TestSimdAddSub()
+{
+    const std::array a {FP_S32_16(2.5), FP_S32_16(-1.25), FP_S32_16(3)};
+    const std::array b {FP_S32_16(1.25), FP_S32_16(0.5), FP_S32_16(-7)};
+    std::array<FP_S32_16, 3> sum;
+    std::array<FP_S32_16, 3> diff;
+    fp::simd::Add<FP_S32_16>(a, b, sum);
+    fp::simd::Sub<FP_S32_16>(a, b, diff);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        if (sum[i] != a[i] + b[i] || diff[i] != a[i] - b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool TestSimdMulMatchesScalar()
+{
+    const std::array a {FP_S32_16(2.5), FP_S32_16(-1.25), FP_S32_16(3), FP_S32_16::FromBits(-1)};
+    const std::array b {FP_S32_16(1.25), FP_S32_16(0.5), FP_S32_16(-7), FP_S32_16::FromBits(1)};
+    std::array<FP_S32_16, 4> out;
+    fp::simd::Mul<FP_S32_16>(a, b, out);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        if (out[i] != a[i] * b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool TestSimdFmaUnsigned()
+{
+    const std::array a {FP_U32_16(2.5), FP_U32_16(1.25)};
+    const std::array b {FP_U32_16(4), FP_U32_16(0.5)};
+    const std::array c {FP_U32_16(1), FP_U32_16(0.25)};
+    std::array<FP_U32_16, 2> out;
+    fp::simd::Fma<FP_U32_16>(a, b, c, out);
+    return out[0] == FP_U32_16(11) && out[1] == a[1] * b[1] + c[1];
+}
+
+constexpr bool TestVectorFusedExpression()
+{
+    fp::Vector<FP_S32_16> a(5, FP_S32_16(1.5));
+    fp::Vector<FP_S32_16> b(5, FP_S32_16(-2));
+    fp::Vector<FP_S32_16> c(5, FP_S32_16(0.25));
+    fp::Vector<FP_S32_16> d(5);
+    d = a * b + c;
+    fp::Vector<FP_S32_16> e = -(d - FP_S32_16(1)) / FP_S32_16(2);
+    for (std::size_t i = 0; i < d.size(); ++i)
+    {
+        if (d[i] != a[i] * b[i] + c[i] || e[i] != -(d[i] - FP_S32_16(1)) / FP_S32_16(2))
+        {
+            return false;
+        }
+    }
+    return d[0] == FP_S32_16(-2.75);
+}
+
+constexpr bool TestVectorPaddingIsZero()
+{
+    fp::Vector<FP_S32_16> a(3, FP_S32_16(7));
+    const auto padded = a.data() + a.size();
+    return a.size() == 3 && padded[0] == FP_S32_16::Zero() && padded[fp::Vector<FP_S32_16>::kLaneCount - 4] == FP_S32_16::Zero();
+}
+
+constexpr bool TestVectorViewWritesThrough()
+{
+    std::array<FP_S32_16, 2> memory {FP_S32_16(1), FP_S32_16(2)};
+    auto view = fp::Vector<FP_S32_16>::View(memory);
+    view = view * FP_S32_16(3);
+    const fp::Vector<FP_S32_16> copy = view;
+    return view.IsView() && !copy.IsView() && memory[0] == FP_S32_16(3) && copy[1] == FP_S32_16(6);
+}
+
+constexpr bool TestDividerMatchesDivision()
+{
+    const std::array divisors {FP_S32_16(3), FP_S32_16(-0.75), FP_S32_16(4), FP_S32_16(1), FP_S32_16::FromBits(7)};
+    const std::array dividends {FP_S32_16(10), FP_S32_16(-2.5), FP_S32_16(0.001), FP_S32_16(-32767), FP_S32_16::FromBits(1)};
+    for (const auto& divisor : divisors)
+    {
+        const fp::Divider<FP_S32_16> divider(divisor);
+        for (const auto& dividend : dividends)
+        {
+            if (dividend / divider != dividend / divisor)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr bool TestDividerUnsigned()
+{
+    const fp::Divider<FP_U32_16> divider(FP_U32_16(6.5));
+    return FP_U32_16(13) / divider == FP_U32_16(2) && FP_U32_16(100.25) / divider == FP_U32_16(100.25) / FP_U32_16(6.5);
+}
+
+constexpr bool TestReciprocal()
+{
+    const auto a = fp::Reciprocal(FP_S32_16(4));
+    const auto b = fp::Reciprocal(FP_S32_16(-3));
+    const auto c = fp::Reciprocal<1>(FP_S32_16(3));
+    return a == FP_S32_16(0.25) && b == FP_S32_16::PosOne() / FP_S32_16(-3) && static_cast<float>(c) > 0.33f && static_cast<float>(c) < 0.34f;
+}
+
+template<fp::MathBackend Backend>
+constexpr bool TestSinCos()
+{
+    const auto half_pi = FP_S32_16(1.5707963267948966);
+    const auto s = fp::Sin<Backend>(half_pi);
+    const auto c = fp::Cos<Backend>(FP_S32_16(-3.141592653589793));
+    const auto s30 = fp::Sin<Backend>(FP_S32_16(0.5235987755982988));
+    return s > FP_S32_16(0.9999) && s <= FP_S32_16(1) && c < FP_S32_16(-0.9999) && static_cast<float>(s30) > 0.4999f && static_cast<float>(s30) < 0.5001f;
+}
+
+template<fp::MathBackend Backend>
+constexpr bool TestAtan2()
+{
+    const auto a = fp::Atan2<Backend>(FP_S32_16(1), FP_S32_16(1));
+    const auto b = fp::Atan2<Backend>(FP_S32_16(-2), FP_S32_16(-2));
+    const auto c = fp::Atan2<Backend>(FP_S32_16(0), FP_S32_16(-5));
+    return static_cast<float>(a) > 0.7853f && static_cast<float>(a) < 0.7855f && static_cast<float>(b) > -2.3563f && static_cast<float>(b) < -2.3561f
+        && static_cast<float>(c) > 3.1415f && static_cast<float>(c) < 3.1416f;
+}
+
+constexpr bool TestSqrt()
+{
+    // floor(sqrt(2 * 2^32)) = 92681
+    return fp::Sqrt(FP_S32_16(2)) == FP_S32_16::FromBits(92681) && fp::Sqrt(FP_U32_16(9)) == FP_U32_16(3) && fp::Sqrt(FP_S32_16(-1)) == FP_S32_16::Zero();
+}
+
+template<fp::MathBackend Backend>
+constexpr bool TestExpLog()
+{
+    const auto e = fp::Exp<Backend>(FP_S32_16(1));
+    const auto small = fp::Exp<Backend>(FP_S32_16(-2));
+    const auto ln10 = fp::Log<Backend>(FP_S32_16(10));
+    return static_cast<float>(e) > 2.7182f && static_cast<float>(e) < 2.7183f && static_cast<float>(small) > 0.1353f && static_cast<float>(small) < 0.1354f
+        && fp::Exp<Backend>(FP_S32_16(0)) == FP_S32_16(1) && fp::Log<Backend>(FP_S32_16(1)) == FP_S32_16::Zero()
+        && static_cast<float>(ln10) > 2.3025f && static_cast<float>(ln10) < 2.3026f;
+}
+
+constexpr bool TestWideMultiplication()
+{
+    // the full 128-bit product keeps the low fractional bits of Q32.32
+    const auto a = FP_S64_32::FromBits((std::int64_t{3} << 40) + 1);
+    const auto b = FP_S64_32(-1.5);
+    const auto c = a * b;
+    return fp::detail::RawBits(c) == -((std::int64_t{3} << 40) + (std::int64_t{3} << 39) + 2) && FP_S64_32(100000) * FP_S64_32(0.25) == FP_S64_32(25000);
+}
+
+constexpr bool TestWideDivision()
+{
+    const auto a = FP_S64_32(1000000);
+    const auto b = FP_S64_32(-3);
+    const auto c = a / b;
+    const auto u = FP_U64_32(7) / FP_U64_32(0.5);
+    return static_cast<double>(c) < -333333.3333 && static_cast<double>(c) > -333333.3334 && u == FP_U64_32(14);
+}
+
+constexpr bool TestSaturatingArithmetic()
+{
+    using Saturating = fp::Number<std::int32_t, std::int64_t, 16, fp::Saturate>;
+    using UnsignedSaturating = fp::Number<std::uint32_t, std::uint64_t, 16, fp::Saturate>;
+    const auto max = Saturating::FromBits(std::numeric_limits<std::int32_t>::max());
+    const auto min = Saturating::FromBits(std::numeric_limits<std::int32_t>::min());
+    return Saturating(30000) + Saturating(30000) == max && Saturating(-30000) - Saturating(30000) == min &&
+           Saturating(300) * Saturating(-300) == min && Saturating(300) / Saturating(0.001) == max && -min == max &&
+           Saturating(1.5) + Saturating(2.25) == Saturating(3.75) && UnsignedSaturating(1) - UnsignedSaturating(2) == UnsignedSaturating(0);
+}
+
+constexpr bool TestSaturatingConstruction()
+{
+    using Saturating = fp::Number<std::int32_t, std::int64_t, 16, fp::Saturate>;
+    using UnsignedSaturating = fp::Number<std::uint32_t, std::uint64_t, 16, fp::Saturate>;
+    const auto max = Saturating::FromBits(std::numeric_limits<std::int32_t>::max());
+    const auto min = Saturating::FromBits(std::numeric_limits<std::int32_t>::min());
+    return Saturating(40000) == max && Saturating(std::int64_t{-1} << 40) == min && Saturating(-32768) == min &&
+           Saturating(1e10) == max && Saturating(-1e10f) == min && UnsignedSaturating(-5) == UnsignedSaturating(0);
+}
+
+constexpr bool TestTrapInRange()
+{
+    // out of range results would fail the constant evaluation
+    using Trapping = fp::Number<std::int32_t, std::int64_t, 16, fp::Trap>;
+    return Trapping(3) + Trapping(4) == Trapping(7) && Trapping(2.5) * Trapping(-2) == Trapping(-5) && Trapping(-32768) == -Trapping(32767) - Trapping(1);
+}
+
+constexpr bool TestSimdSaturatingAdd()
+{
+    using Saturating = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+    std::array<Saturating, 3> a;
+    a[0] = Saturating(100);
+    a[1] = Saturating(-100);
+    a[2] = Saturating(1.5);
+    std::array<Saturating, 3> b;
+    b[0] = Saturating(100);
+    b[1] = Saturating(100);
+    b[2] = Saturating(-100);
+    std::array<Saturating, 3> out;
+    fp::simd::Add<Saturating>(a, a, out);
+    const bool add_ok = out[0] == Saturating::FromBits(32767) && out[1] == Saturating::FromBits(-32768) && out[2] == Saturating(3);
+    fp::simd::Sub<Saturating>(b, a, out);
+    return add_ok && out[0] == Saturating(0) && out[1] == Saturating::FromBits(32767) && out[2] == Saturating(-101.5);
+}
+
+constexpr bool TestRoundingMultiplication()
+{
+    using HalfUp = fp::Number<std::int16_t, std::int32_t, 8, fp::Wrap, fp::RoundHalfUp>;
+    using HalfEven = fp::Number<std::int16_t, std::int32_t, 8, fp::Wrap, fp::RoundHalfEven>;
+    using Truncating = fp::Number<std::int16_t, std::int32_t, 8>;
+
+    // 3/256 * 0.5 = 1.5/256 and -3/256 * 0.5 = -1.5/256
+    const bool truncate_ok = Truncating::FromBits(3) * Truncating(0.5) == Truncating::FromBits(1) && Truncating::FromBits(-3) * Truncating(0.5) == Truncating::FromBits(-2);
+    const bool half_up_ok = HalfUp::FromBits(3) * HalfUp(0.5) == HalfUp::FromBits(2) && HalfUp::FromBits(-3) * HalfUp(0.5) == HalfUp::FromBits(-1) && HalfUp::FromBits(5) * HalfUp(0.25) == HalfUp::FromBits(1);
+    const bool half_even_ok = HalfEven::FromBits(3) * HalfEven(0.5) == HalfEven::FromBits(2) && HalfEven::FromBits(5) * HalfEven(0.5) == HalfEven::FromBits(2) && HalfEven::FromBits(-5) * HalfEven(0.5) == HalfEven::FromBits(-2);
+    return truncate_ok && half_up_ok && half_even_ok;
+}
+
+constexpr bool TestRoundingDivision()
+{
+    using HalfUp = fp::Number<std::int32_t, std::int64_t, 16, fp::Wrap, fp::RoundHalfUp>;
+    using HalfEven = fp::Number<std::int32_t, std::int64_t, 16, fp::Wrap, fp::RoundHalfEven>;
+    using Truncating = fp::Number<std::int32_t, std::int64_t, 16>;
+
+    // 2/3 = 0xAAAA.AA.. ULP, 1 ULP / 2 = 0.5 ULP
+    const bool truncate_ok = Truncating(2) / Truncating(3) == Truncating::FromBits(0xAAAA) && Truncating::FromBits(-1) / Truncating(2) == Truncating(0);
+    const bool half_up_ok = HalfUp(2) / HalfUp(3) == HalfUp::FromBits(0xAAAB) && HalfUp::FromBits(-1) / HalfUp(2) == HalfUp(0) && HalfUp::FromBits(1) / HalfUp(-2) == HalfUp(0) && HalfUp::FromBits(1) / HalfUp(2) == HalfUp::FromBits(1);
+    const bool half_even_ok = HalfEven::FromBits(1) / HalfEven(2) == HalfEven(0) && HalfEven::FromBits(3) / HalfEven(2) == HalfEven::FromBits(2) && HalfEven::FromBits(-3) / HalfEven(2) == HalfEven::FromBits(-2);
+    const fp::Divider<HalfUp> divider(HalfUp(3));
+    return truncate_ok && half_up_ok && half_even_ok && HalfUp(2) / divider == HalfUp(2) / HalfUp(3) && HalfUp(-2) / divider == HalfUp(-2) / HalfUp(3);
+}
+
+constexpr bool TestRoundingConstruction()
+{
+    using HalfUp = fp::Number<std::int16_t, std::int32_t, 8, fp::Wrap, fp::RoundHalfUp>;
+    using HalfEven = fp::Number<std::int16_t, std::int32_t, 8, fp::Wrap, fp::RoundHalfEven>;
+    using Stochastic = fp::Number<std::int16_t, std::int32_t, 8, fp::Wrap, fp::RoundStochastic>;
+    using Truncating = fp::Number<std::int16_t, std::int32_t, 8>;
+
+    constexpr double kThird {1.0 / 3.0};
+    constexpr double kTie {2.5 / 256.0};
+    return Truncating(-kThird) == Truncating::FromBits(-85) && HalfUp(-kThird) == HalfUp::FromBits(-85) && HalfUp(2.0 / 3.0) == HalfUp::FromBits(171) &&
+           HalfUp(kTie) == HalfUp::FromBits(3) && HalfUp(-kTie) == HalfUp::FromBits(-2) && HalfEven(kTie) == HalfEven::FromBits(2) && HalfEven(3.5f / 256.0f) == HalfEven::FromBits(4) &&
+           Stochastic(kTie) == Stochastic::FromBits(2);
+}
+
+constexpr bool TestRescale()
+{
+    using Q8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfEven>;
+    using Q8Truncating = fp::Number<std::int16_t, std::int32_t, 8>;
+    using UQ8 = fp::Number<std::uint16_t, std::uint32_t, 8, fp::Saturate>;
+
+    const auto x = FP_S32_16(-1.3);
+    const auto big = FP_S32_16(300);
+    const bool down_ok = fp::Rescale<Q8>(x) == Q8(-1.3) && fp::Rescale<Q8Truncating>(x) == Q8Truncating::FromBits(-333) && fp::Rescale<Q8>(big) == Q8::FromBits(32767);
+    const bool up_ok = fp::Rescale<FP_S32_16>(Q8(-1.3)) == FP_S32_16::FromBits(-333 * 256) && fp::Rescale<FP_S64_32>(FP_S32_16(12345.5)) == FP_S64_32(12345.5);
+    return down_ok && up_ok && fp::Rescale<UQ8>(x) == UQ8(0) && fp::Rescale<UQ8>(FP_U32_16(2.5)) == UQ8(2.5);
+}
+
+constexpr bool TestAccumulatorKeepsFractionalBits()
+{
+    // each product is half an ULP, lost by every truncating multiplication
+    const auto half_ulp = FP_S32_16(0.5);
+    const auto ulp = FP_S32_16::FromBits(1);
+    auto narrowing = FP_S32_16(0);
+    fp::Accumulator<FP_S32_16> acc;
+    for (int i = 0; i < 10; ++i)
+    {
+        narrowing += half_ulp * ulp;
+        acc.MulAdd(half_ulp, ulp);
+    }
+    acc += FP_S32_16(2);
+    acc.MulSub(FP_S32_16(1), FP_S32_16(1));
+    return narrowing == FP_S32_16(0) && acc.Result() == FP_S32_16(1) + FP_S32_16::FromBits(5) && decltype(acc)::kHeadroomBits == 65;
+}
+
+constexpr bool TestDot()
+{
+    using Q8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+    std::array<Q8, 20> a;
+    std::array<Q8, 20> b;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = Q8(static_cast<int>(i) - 10);
+        b[i] = Q8(0.5);
+    }
+    // the partial sums leave the range of Q8.8, only the result has to fit
+    std::array<Q8, 3> big;
+    big[0] = Q8(100);
+    big[1] = Q8(100);
+    big[2] = Q8(-100);
+    std::array<Q8, 3> ones;
+    ones[0] = Q8(1);
+    ones[1] = Q8(1);
+    ones[2] = Q8(1);
+    return fp::Dot<Q8>(a, b) == Q8(-5) && fp::Dot<Q8>(big, ones) == Q8(100);
+}
+
+constexpr bool TestFmaSingleRounding()
+{
+    using HalfEven = fp::Number<std::int32_t, std::int64_t, 16, fp::Wrap, fp::RoundHalfEven>;
+    // 1.5 ULP + 1 ULP: rounding the product first gives 3 ULP, the exact sum 2.5 ULP rounds to 2
+    const auto a = HalfEven(1.5);
+    const auto ulp = HalfEven::FromBits(1);
+    return a * ulp + ulp == HalfEven::FromBits(3) && fp::Fma(a, ulp, ulp) == HalfEven::FromBits(2) && fp::Fma(FP_S32_16(2.5), FP_S32_16(-2), FP_S32_16(1)) == FP_S32_16(-4);
+}
+
+constexpr bool TestMixedMultiplication()
+{
+    using Q8_24 = fp::Number<std::int32_t, std::int64_t, 8>;
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    const auto coefficient = FP_S32_16(-1.5);
+    const auto state = Q8_24(0.3);
+    const auto product = coefficient * state;
+    const auto small = Q8_8(2.5) * fp::Number<std::int16_t, std::int32_t, 4>(-1.25);
+    static_assert(std::is_same_v<decltype(product), const fp::Number<std::int64_t, fp::int128, 24>>, "Q16.16 * Q8.24 must be Q24.40");
+    static_assert(std::is_same_v<decltype(small), const fp::Number<std::int32_t, std::int64_t, 12>>, "Q8.8 * Q4.12 must be Q12.20");
+    return fp::detail::RawBits(product) == static_cast<std::int64_t>(fp::detail::RawBits(coefficient)) * fp::detail::RawBits(state) && small == decltype(small)(-3.125);
+}
+
+constexpr bool TestMixedAddition()
+{
+    using Q8_24 = fp::Number<std::int32_t, std::int64_t, 8>;
+    const auto sum = FP_S32_16(30000.5) + Q8_24(-0.25);
+    const auto difference = FP_S32_16(-30000) - Q8_24(100.5);
+    static_assert(std::is_same_v<decltype(sum), const fp::Number<std::int64_t, fp::int128, 40>>, "Q16.16 + Q8.24 must have 24 fractional bits and a carry bit");
+    return sum == decltype(sum)(30000.25) && difference == decltype(difference)(-30100.5);
+}
+
+constexpr bool TestConvert()
+{
+    using Q8_24 = fp::Number<std::int32_t, std::int64_t, 8>;
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    const auto x = FP_S32_16(-1.3);
+    return fp::Convert<Q8_24>(x) == Q8_24::FromBits(fp::detail::RawBits(x) * 256) && fp::Convert<Q8_8>(x) == Q8_8::FromBits(-333) &&
+           fp::Convert<FP_S32_16>(fp::Convert<Q8_24>(x)) == x && fp::Convert<FP_U32_16>(fp::Number<std::uint16_t, std::uint32_t, 8>(3.5)) == FP_U32_16(3.5);
+}
+
+constexpr bool TestFromFloats()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfEven>;
+    const std::array<float, 5> in {0.5f / 256.0f, 1.5f / 256.0f, 1000.0f, -1000.0f, 1.25f};
+    std::array<Q8_8, 5> out;
+    fp::FromFloats<Q8_8>(in, out);
+
+    const std::array<double, 2> wide_in {-2.75, 1e12};
+    std::array<FP_S32_16, 2> wide_out;
+    fp::FromFloats<FP_S32_16>(wide_in, std::span<FP_S32_16>(wide_out).first(1));
+    return fp::detail::RawBits(out[0]) == 0 && fp::detail::RawBits(out[1]) == 2 && fp::detail::RawBits(out[2]) == 32767 &&
+           fp::detail::RawBits(out[3]) == -32768 && fp::detail::RawBits(out[4]) == 320 && wide_out[0] == FP_S32_16(-2.75);
+}
+
+constexpr bool TestToFloats()
+{
+    const std::array<FP_S32_16, 3> in {FP_S32_16(1.25), FP_S32_16(-0.5), FP_S32_16::FromBits(1)};
+    std::array<float, 3> out;
+    std::array<double, 3> wide_out;
+    fp::ToFloats<FP_S32_16>(in, out);
+    fp::ToFloats<FP_S32_16>(in, wide_out);
+    return out[0] == 1.25f && out[1] == -0.5f && out[2] == 1.0f / 65536.0f && wide_out[0] == 1.25 && wide_out[2] == 1.0 / 65536.0;
+}
+
+constexpr bool TestReduceNarrowsOnce()
+{
+    // a chain of saturating additions would clamp at the first step and end near 8
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+    const std::array<Q8_8, 3> values {Q8_8(100), Q8_8(100), Q8_8(-120)};
+    return fp::Reduce<Q8_8>(values) == Q8_8(80) && fp::Reduce<Q8_8>(std::execution::par, values) == Q8_8(80);
+}
+
+constexpr bool TestTransformReduce()
+{
+    const std::array<FP_S32_16, 3> a {FP_S32_16(1.5), FP_S32_16(-2.25), FP_S32_16(0.125)};
+    const std::array<FP_S32_16, 3> b {FP_S32_16(2), FP_S32_16(0.5), FP_S32_16(-8)};
+    const auto abs = [](const FP_S32_16& x) { return Abs(x); };
+    return fp::TransformReduce<FP_S32_16>(a, b) == fp::Dot<FP_S32_16>(a, b) &&
+           fp::TransformReduce<FP_S32_16>(std::execution::par_unseq, a, b) == FP_S32_16(0.875) &&
+           fp::TransformReduce<FP_S32_16>(a, abs) == FP_S32_16(3.875);
+}
+
+constexpr bool TestTransform()
+{
+    const std::array<FP_S32_16, 3> a {FP_S32_16(1.5), FP_S32_16(-2.25), FP_S32_16(0.125)};
+    std::array<FP_S32_16, 3> negated;
+    std::array<FP_S32_16, 3> sum;
+    fp::Transform<FP_S32_16>(std::execution::par, a, negated, [](const FP_S32_16& x) { return -x; });
+    fp::Transform<FP_S32_16>(std::execution::seq, a, negated, sum, std::plus<>{});
+    return negated[1] == FP_S32_16(2.25) && sum[0] == FP_S32_16(0) && sum[2] == FP_S32_16(0);
+}
+
+constexpr bool TestArrayHeader()
+{
+    using Q8_24 = fp::Number<std::int32_t, std::int64_t, 8>;
+    const auto header = fp::MakeArrayHeader<FP_S32_16>(1000);
+    auto swapped = header;
+    swapped.big_endian = static_cast<std::uint8_t>(1 - header.big_endian);
+    swapped.version = fp::detail::ByteSwap(header.version);
+    return header.count == 1000 && fp::detail::MatchesFormat<FP_S32_16>(header) && fp::detail::MatchesFormat<FP_S32_16>(swapped) &&
+           !fp::detail::MatchesFormat<Q8_24>(header) && !fp::detail::MatchesFormat<FP_U32_16>(header) && !fp::detail::MatchesFormat<FP_S64_32>(header);
+}
+
+constexpr bool TestByteSwap()
+{
+    return fp::detail::ByteSwap(std::uint32_t{0x12345678}) == 0x78563412 && fp::detail::ByteSwap(std::int16_t{-2}) == std::int16_t{-257} &&
+           fp::detail::ByteSwap(fp::detail::ByteSwap(std::int64_t{-123456789})) == -123456789;
+}
+
+template<typename NumberT>
+constexpr bool FormatsAs(const NumberT& x, std::string_view expected, int precision = -1)
+{
+    std::array<char, fp::kMaxCharsExact<NumberT>> buffer {};
+    const auto result = precision < 0 ? fp::ToChars(buffer.data(), buffer.data() + buffer.size(), x)
+                                      : fp::ToChars(buffer.data(), buffer.data() + buffer.size(), x, precision);
+    return result.ec == std::errc{} && std::string_view(buffer.data(), result.ptr) == expected;
+}
+
+template<typename NumberT>
+constexpr bool ParsesAs(std::string_view text, const NumberT& expected)
+{
+    NumberT value;
+    const auto result = fp::FromChars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc{} && result.ptr == text.data() + text.size() && value == expected;
+}
+
+constexpr bool TestToChars()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    std::array<char, 3> small {};
+    const bool too_small {fp::ToChars(small.data(), small.data() + small.size(), Q8_8(-1.25)).ec == std::errc::value_too_large};
+    return FormatsAs(Q8_8(-1.25), "-1.25") && FormatsAs(FP_S32_16(3), "3") && FormatsAs(FP_S32_16::FromBits(1), "0.0000152587890625") &&
+           FormatsAs(FP_U64_32(0.5), "0.5") && too_small;
+}
+
+constexpr bool TestToCharsPrecision()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    return FormatsAs(Q8_8(2.5), "2", 0) && FormatsAs(Q8_8(3.5), "4", 0) && FormatsAs(Q8_8::FromBits(1), "0.00", 2) &&
+           FormatsAs(Q8_8::FromBits(2559), "10.00", 2) && FormatsAs(Q8_8(-0.75), "-0.8", 1);
+}
+
+constexpr bool TestFromChars()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfEven>;
+    using Q8_8Truncating = fp::Number<std::int16_t, std::int32_t, 8>;
+    Q8_8 value;
+    const std::string_view invalid {"-x"};
+    const std::string_view too_large {"200"};
+    return ParsesAs("-1.25", Q8_8(-1.25)) && ParsesAs("5.", Q8_8(5)) && ParsesAs(".5", Q8_8(0.5)) && ParsesAs("0.0078", Q8_8Truncating::FromBits(1)) &&
+           ParsesAs("0.001953125", Q8_8::FromBits(0)) && ParsesAs("0.005859375", Q8_8::FromBits(2)) &&
+           ParsesAs("0.0000152587890625", FP_S32_16::FromBits(1)) &&
+           fp::FromChars(invalid.data(), invalid.data() + invalid.size(), value).ec == std::errc::invalid_argument &&
+           fp::FromChars(too_large.data(), too_large.data() + too_large.size(), value).ec == std::errc::result_out_of_range;
+}
+
+constexpr bool TestFromCharsLongFraction()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfEven>;
+    // ties and whole ULPs decided by digits past the 36th
+    return ParsesAs("0.00585937500000000000000000000000000000001", Q8_8::FromBits(2)) &&
+           ParsesAs("0.00585937499999999999999999999999999999999", Q8_8::FromBits(1)) &&
+           ParsesAs("0.00390624999999999999999999999999999999999", Q8_8::FromBits(1)) &&
+           ParsesAs("0.00390625000000000000000000000000000000000", Q8_8::FromBits(1));
+}
+
+constexpr bool TestVec()
+{
+    using Vec3 = fp::Vec<FP_S32_16, 3>;
+    const Vec3 a {FP_S32_16(1), FP_S32_16(0.5), FP_S32_16(-2)};
+    const Vec3 b {FP_S32_16(2), FP_S32_16(4), FP_S32_16(0.25)};
+    const Vec3 sum {FP_S32_16(3), FP_S32_16(4.5), FP_S32_16(-1.75)};
+    const Vec3 scaled {FP_S32_16(2), FP_S32_16(1), FP_S32_16(-4)};
+    return a + b == sum && a * FP_S32_16(2) == scaled && -(-a) == a && Dot(a, b) == FP_S32_16(3.5) && Vec3().size() == 3;
+}
+
+constexpr bool TestVecDotRoundsOnce()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    // each product is 1/512, half an ULP: rounding every product would give zero
+    const fp::Vec<Q8_8, 2> a {Q8_8::FromBits(1), Q8_8::FromBits(1)};
+    const fp::Vec<Q8_8, 2> b {Q8_8::FromBits(128), Q8_8::FromBits(128)};
+    return Dot(a, b) == Q8_8::FromBits(1);
+}
+
+constexpr bool TestMat()
+{
+    using Mat23 = fp::Mat<FP_S32_16, 2, 3>;
+    const Mat23 a {FP_S32_16(1), FP_S32_16(2), FP_S32_16(3), FP_S32_16(4), FP_S32_16(5), FP_S32_16(6)};
+    const auto product = a * a.Transposed();
+    const fp::Mat<FP_S32_16, 2, 2> expected {FP_S32_16(14), FP_S32_16(32), FP_S32_16(32), FP_S32_16(77)};
+    const fp::Vec<FP_S32_16, 3> v {FP_S32_16(1), FP_S32_16(0.5), FP_S32_16(-1)};
+    const fp::Vec<FP_S32_16, 2> av {FP_S32_16(-1), FP_S32_16(0.5)};
+    return product == expected && fp::Mat<FP_S32_16, 2, 2>::Identity() * expected == expected && a * v == av && a.Row(1)[2] == FP_S32_16(6) &&
+           a.Col(1)[1] == FP_S32_16(5) && a - a == Mat23();
+}
+
+constexpr bool TestGemm()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    // 2x3 times 3x2, the same products as TestMat() plus sub-ULP ones that only survive a single rounding
+    const std::array<Q8_8, 6> a {Q8_8(1), Q8_8(2), Q8_8(3), Q8_8::FromBits(1), Q8_8::FromBits(1), Q8_8::FromBits(1)};
+    const std::array<Q8_8, 6> b {Q8_8(1), Q8_8(4), Q8_8(2), Q8_8::FromBits(128), Q8_8(3), Q8_8::FromBits(128)};
+    std::array<Q8_8, 4> c;
+    fp::Gemm<Q8_8>(2, 2, 3, a, b, c);
+    const auto dot = fp::Dot<Q8_8>(std::array<Q8_8, 3> {a[3], a[4], a[5]}, std::array<Q8_8, 3> {b[1], b[3], b[5]});
+    return c[0] == Q8_8(14) && c[1] == Q8_8(4) + Q8_8(1) + Q8_8(1.5) && c[2] == Q8_8::FromBits(6) && c[3] == dot && c[3] == Q8_8::FromBits(5);
+}
+
+constexpr bool TestComplex()
+{
+    using C = fp::Complex<FP_S32_16>;
+    const C a {FP_S32_16(1.5), FP_S32_16(-2)};
+    const C b {FP_S32_16(0.5), FP_S32_16(4)};
+    return a * b == C(FP_S32_16(8.75), FP_S32_16(5)) && a + b == C(FP_S32_16(2), FP_S32_16(2)) && a.Conj() == C(FP_S32_16(1.5), FP_S32_16(2)) &&
+           -a - a == C(FP_S32_16(-3), FP_S32_16(4)) && C(FP_S32_16(3)).Imag() == FP_S32_16(0);
+}
+
+constexpr bool TestFFTImpulse()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    // the spectrum of an impulse is flat, small inputs need no shift
+    std::array<fp::Complex<Q8_8>, 16> x;
+    x[0] = fp::Complex<Q8_8>(Q8_8(0.5));
+    const int shift {fp::FFT<Q8_8, 16>().Forward(x)};
+    return shift == 0 && std::all_of(x.begin(), x.end(), [](const auto& v) { return v == fp::Complex<Q8_8>(Q8_8(0.5)); });
+}
+
+constexpr bool TestFFTConstant()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    // all the energy of a constant goes to X[0], exactly since the twiddles of k = 0 are 1
+    std::array<fp::Complex<Q8_8>, 32> x;
+    x.fill(fp::Complex<Q8_8>(Q8_8(-64), Q8_8(32)));
+    const int shift {fp::FFT<Q8_8, 32>().Forward(x)};
+    const bool rest_zero {std::all_of(x.begin() + 1, x.end(), [](const auto& v) { return v == fp::Complex<Q8_8>(); })};
+    return shift > 0 && rest_zero && fp::detail::RawBits(x[0].Real()) == -(32 * 64 * 256 >> shift) && fp::detail::RawBits(x[0].Imag()) == (32 * 32 * 256 >> shift);
+}
+
+template<std::size_t N>
+constexpr bool TestFFTRoundTrip()
+{
+    // the inverse of the forward transform, 2^shift / N times the result, within a few ULPs
+    std::array<fp::Complex<FP_S32_16>, N> x;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        x[i] = {FP_S32_16(static_cast<int>(i * 37 % 23) - 11), FP_S32_16::FromBits(static_cast<std::int32_t>(i * i * 7919 % 65536) - 32768)};
+    }
+    auto y = x;
+    const fp::FFT<FP_S32_16, N> plan;
+    const int shift {plan.Forward(y) + plan.Inverse(y) - std::countr_zero(N)};
+    const auto close = [shift](FP_S32_16 expected, FP_S32_16 actual) {
+        const std::int64_t scaled {shift >= 0 ? std::int64_t{fp::detail::RawBits(actual)} << shift : std::int64_t{fp::detail::RawBits(actual)} >> -shift};
+        const std::int64_t error {scaled - fp::detail::RawBits(expected)};
+        return (error < 0 ? -error : error) <= (std::int64_t{8} << (shift > 0 ? shift : 0));
+    };
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (!close(x[i].Real(), y[i].Real()) || !close(x[i].Imag(), y[i].Imag()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool TestMakeTable()
+{
+    constexpr auto table = fp::MakeTable<FP_S32_16, 5>([](double x) { return x * x; }, 0.0, 1.0);
+    return table[0] == FP_S32_16(0) && table[1] == FP_S32_16(0.0625) && table[2] == FP_S32_16(0.25) && table[3] == FP_S32_16(0.5625) &&
+           table[4] == FP_S32_16(1);
+}
+
+constexpr bool TestTableFuncLinear()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    // linear interpolation of the identity is exact, inputs outside of [lo, hi] clamp
+    constexpr fp::TableFunc<Q8_8, 5> identity {[](double x) { return x; }, 0.0, 4.0};
+    for (std::int16_t raw = 0; raw <= 1024; ++raw)
+    {
+        if (identity(Q8_8::FromBits(raw)) != Q8_8::FromBits(raw))
+        {
+            return false;
+        }
+    }
+    return identity(Q8_8(-1)) == Q8_8(0) && identity(Q8_8(100)) == Q8_8(4);
+}
+
+constexpr bool TestTableFuncCubic()
+{
+    // Catmull-Rom reproduces quadratics away from the extrapolated ends, to the final rounding
+    constexpr fp::TableFunc<FP_S32_16, 9, fp::Interpolation::Cubic> square {[](double x) { return x * x; }, -4.0, 4.0};
+    for (std::int32_t raw = -3 << 16; raw <= 3 << 16; raw += 997)
+    {
+        const std::int64_t x {raw};
+        const std::int64_t expected {(x * x + (1 << 15)) >> 16};
+        const std::int64_t error {fp::detail::RawBits(square(FP_S32_16::FromBits(raw))) - expected};
+        if (error < -1 || error > 1)
+        {
+            return false;
+        }
+    }
+    return square(FP_S32_16(0.5)) == FP_S32_16(0.25) && square(FP_S32_16(4)) == FP_S32_16(16);
+}
+
+constexpr bool TestComplexRoundsOnce()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    using Q8_8Sat = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+    using C = fp::Complex<Q8_8>;
+    // 2^-8 * 0.5 truncates to zero twice with four roundings, the exact sum is 2^-8
+    const C tiny {Q8_8::FromBits(1), Q8_8::FromBits(1)};
+    const C half {Q8_8(0.5), Q8_8(0.5)};
+    // (-128 - 128i)^2 = 32768i, the sum of the two exact products saturates instead of wrapping
+    const fp::Complex<Q8_8Sat> lowest {Q8_8Sat(-128), Q8_8Sat(-128)};
+    const auto square = lowest * lowest;
+    return tiny * half == C(Q8_8(0), Q8_8::FromBits(1)) && square.Real() == Q8_8Sat(0) && fp::detail::RawBits(square.Imag()) == 32767;
+}
+
+template<typename NumberT>
+constexpr bool TestComplexMul3()
+{
+    // the three-multiply product is bit-exact with operator* over a grid of values, extremes included
+    constexpr std::array<std::int16_t, 7> kRaw {-32768, -32767, -1234, -1, 0, 4321, 32767};
+    std::array<fp::Complex<NumberT>, 49> a;
+    std::array<fp::Complex<NumberT>, 49> b;
+    std::array<fp::Complex<NumberT>, 49> out;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = {NumberT::FromBits(kRaw[i % 7]), NumberT::FromBits(kRaw[i / 7])};
+        b[i] = {NumberT::FromBits(kRaw[(i * 3) % 7]), NumberT::FromBits(kRaw[(i * 5 + 2) % 7])};
+    }
+    fp::simd::Mul<NumberT>(a, b, out);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        for (std::size_t j = 0; j < b.size(); ++j)
+        {
+            if (fp::Mul3(a[i], b[j]) != a[i] * b[j])
+            {
+                return false;
+            }
+        }
+        if (out[i] != a[i] * b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool TestAbsMinimum()
+{
+    using WrapQ8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    using SatQ8_8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+    // |min| wraps to min or saturates to max
+    return Abs(WrapQ8_8::FromBits(-32768)) == WrapQ8_8::FromBits(-32768) && Abs(SatQ8_8::FromBits(-32768)) == SatQ8_8::FromBits(32767) &&
+           Abs(SatQ8_8(-1.5)) == SatQ8_8(1.5) && Abs(FP_S32_16(0)) == FP_S32_16(0);
+}
+
+constexpr bool TestMinMaxClamp()
+{
+    const FP_S32_16 a {-2.5};
+    const FP_S32_16 b {1.25};
+    const FP_U32_16 u {3};
+    return Min(a, b) == a && Max(a, b) == b && Clamp(FP_S32_16(7), a, b) == b && Clamp(FP_S32_16(-7), a, b) == a && Clamp(FP_S32_16(0.5), a, b) == FP_S32_16(0.5) &&
+           Min(u, FP_U32_16(2)) == FP_U32_16(2) && Max(u, FP_U32_16(2)) == u;
+}
+
+constexpr bool TestCopySign()
+{
+    using SatQ8_8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate>;
+    return CopySign(FP_S32_16(2), FP_S32_16(-0.5)) == FP_S32_16(-2) && CopySign(FP_S32_16(-2), FP_S32_16(0)) == FP_S32_16(2) &&
+           CopySign(FP_S32_16(-2), FP_S32_16(-3)) == FP_S32_16(-2) && CopySign(SatQ8_8::FromBits(-32768), SatQ8_8(1)) == SatQ8_8::FromBits(32767) &&
+           CopySign(FP_U32_16(4), FP_U32_16(1)) == FP_U32_16(4);
+}
+
+constexpr bool TestLerp()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8>;
+    // the difference of -100 and 100 doesn't fit Q8_8, it stays exact in WideType
+    return Lerp(Q8_8(-100), Q8_8(100), Q8_8(0.25)) == Q8_8(-50) && Lerp(Q8_8(-100), Q8_8(100), Q8_8(1)) == Q8_8(100) &&
+           Lerp(Q8_8(3), Q8_8(-1), Q8_8(0)) == Q8_8(3) && Lerp(FP_U32_16(8), FP_U32_16(2), FP_U32_16(0.5)) == FP_U32_16(5);
+}
+
+constexpr bool TestSimdSelects()
+{
+    const std::array<FP_S32_16, 5> a {FP_S32_16(-3), FP_S32_16(2), FP_S32_16(-0.5), FP_S32_16(0), FP_S32_16(9)};
+    const std::array<FP_S32_16, 5> b {FP_S32_16(1), FP_S32_16(-1), FP_S32_16(-1), FP_S32_16(4), FP_S32_16(-9)};
+    std::array<FP_S32_16, 5> abs;
+    std::array<FP_S32_16, 5> min;
+    std::array<FP_S32_16, 5> max;
+    std::array<FP_S32_16, 5> clamped;
+    std::array<FP_S32_16, 5> signs;
+    std::array<FP_S32_16, 5> lerp;
+    fp::simd::Abs<FP_S32_16>(a, abs);
+    fp::simd::Min<FP_S32_16>(a, b, min);
+    fp::simd::Max<FP_S32_16>(a, b, max);
+    fp::simd::Clamp<FP_S32_16>(a, FP_S32_16(-1), FP_S32_16(1), clamped);
+    fp::simd::CopySign<FP_S32_16>(a, b, signs);
+    fp::simd::Lerp<FP_S32_16>(a, b, std::array<FP_S32_16, 5> {FP_S32_16(0.5), FP_S32_16(0.5), FP_S32_16(0.5), FP_S32_16(0.5), FP_S32_16(0.5)}, lerp);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        if (abs[i] != Abs(a[i]) || min[i] != Min(a[i], b[i]) || max[i] != Max(a[i], b[i]) || clamped[i] != Clamp(a[i], FP_S32_16(-1), FP_S32_16(1)) ||
+            signs[i] != CopySign(a[i], b[i]) || lerp[i] != Lerp(a[i], b[i], FP_S32_16(0.5)))
+        {
+            return false;
+        }
+    }
+    return clamped[0] == FP_S32_16(-1) && lerp[4] == FP_S32_16(0) && signs[1] == FP_S32_16(-2);
+}
+
+constexpr bool TestInstrumentedResults()
+{
+    // the instrumented policies return what the inner ones do, and count nothing in constant expressions
+    using Plain = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfEven>;
+    using Counted = fp::Number<std::int16_t, std::int32_t, 8, fp::Instrumented<fp::Saturate>, fp::InstrumentedRounding<fp::RoundHalfEven>>;
+    constexpr std::array<double, 5> kValues {-127.5, -3.3, 0.01, 1.5, 100.25};
+    for (const double x : kValues)
+    {
+        for (const double y : kValues)
+        {
+            const Plain a {x};
+            const Plain b {y};
+            const Counted c {x};
+            const Counted d {y};
+            if (fp::detail::RawBits(a * b) != fp::detail::RawBits(c * d) || fp::detail::RawBits(a + b) != fp::detail::RawBits(c + d) ||
+                fp::detail::RawBits(a / b) != fp::detail::RawBits(c / d))
+            {
+                return false;
+            }
+        }
+    }
+    // integers out of range too: wrapping keeps the low bits of the exact value, saturation clamps it
+    using Wrapped = fp::Number<std::int32_t, std::int64_t, 16>;
+    using CountedWrapped = fp::Number<std::int32_t, std::int64_t, 16, fp::Instrumented<fp::Wrap>>;
+    using Saturated = fp::Number<std::int32_t, std::int64_t, 16, fp::Saturate>;
+    using CountedSaturated = fp::Number<std::int32_t, std::int64_t, 16, fp::Instrumented<fp::Saturate>>;
+    constexpr std::array<std::int64_t, 9> kIntegers {0, -1, 32767, -32768, 32768, 100000, -100000, std::numeric_limits<std::int64_t>::max(),
+                                                     std::numeric_limits<std::int64_t>::min()};
+    for (const std::int64_t i : kIntegers)
+    {
+        if (Wrapped(i).Bits() != CountedWrapped(i).Bits() || Saturated(i).Bits() != CountedSaturated(i).Bits() ||
+            Wrapped(i).Bits() != static_cast<std::int32_t>(static_cast<std::uint32_t>(static_cast<std::uint64_t>(i) << 16)))
+        {
+            return false;
+        }
+    }
+    if (Wrapped(100000).Bits() != -2036334592 || CountedWrapped(std::numeric_limits<std::uint64_t>::max()).Bits() != Wrapped(-1).Bits() ||
+        CountedSaturated(std::numeric_limits<std::uint64_t>::max()).Bits() != std::numeric_limits<std::int32_t>::max() ||
+        CountedSaturated(-100000).Bits() != std::numeric_limits<std::int32_t>::min())
+    {
+        return false;
+    }
+    // division by zero gives the limit of the sign of the numerator
+    return Counted(3) / Counted(0) == Counted::FromBits(32767) && Counted(-3) / Counted(0) == Counted::FromBits(-32768) && Counted(0) / Counted(0) == Counted(0);
+}
+
+constexpr bool TestBitsRoundTrip()
+{
+    constexpr auto a = FP_S32_16::FromBits(-123457);
+    constexpr auto b = FP_U64_32::FromBits(0x1234'5678'9ABC'DEF0u);
+    return a.Bits() == -123457 && FP_S32_16::FromBits(a.Bits()) == a && b.Bits() == 0x1234'5678'9ABC'DEF0u &&
+           FP_S32_16::PosOne().Bits() == 1 << 16 && fp::detail::RawBits(a) == a.Bits();
+}
+
+constexpr bool TestFIRImpulseResponse()
+{
+    fp::FIR<FP_S32_16, 3> fir({FP_S32_16(0.5), FP_S32_16(0.25), FP_S32_16(-0.125)});
+    std::array<FP_S32_16, 5> x {FP_S32_16(1), FP_S32_16(0), FP_S32_16(0), FP_S32_16(0), FP_S32_16(0)};
+    fir.Process(x);
+    return x[0] == FP_S32_16(0.5) && x[1] == FP_S32_16(0.25) && x[2] == FP_S32_16(-0.125) && x[3] == FP_S32_16(0) && x[4] == FP_S32_16(0) &&
+           fir.Coefficient(2) == FP_S32_16(-0.125);
+}
+
+constexpr bool TestFIRBlocksMatchSamples()
+{
+    using Q8_8 = fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfEven>;
+    const std::array<Q8_8, 5> h {Q8_8(0.3), Q8_8(-0.7), Q8_8(1.1), Q8_8(0.45), Q8_8(-0.2)};
+    std::array<Q8_8, 20> x;
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = Q8_8(static_cast<double>((i * 37) % 23) / 4.0 - 2.5);
+    }
+
+    fp::FIR<Q8_8, 5> by_sample(h);
+    fp::FIR<Q8_8, 5> by_block(h);
+    std::array<Q8_8, 20> expected;
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        expected[i] = by_sample.Process(x[i]);
+    }
+    // blocks shorter and longer than the history, in place
+    std::size_t start {0};
+    for (const std::size_t size : {3, 1, 7, 9})
+    {
+        by_block.Process(std::span<Q8_8>{x}.subspan(start, size));
+        start += size;
+    }
+    return x == expected;
+}
+
+constexpr bool TestBiquadForms()
+{
+    using Sample = fp::Number<std::int16_t, std::int32_t, 4, fp::Saturate, fp::RoundHalfEven>;
+    using Coeff = fp::Number<std::int16_t, std::int32_t, 2>;
+    // low-pass, fc = fs / 10, Q = 0.707
+    const fp::BiquadCoefficients<Coeff> lowpass {Coeff(0.0675), Coeff(0.1349), Coeff(0.0675), Coeff(-1.1430), Coeff(0.4128)};
+    const fp::BiquadCoefficients<Coeff> notch {Coeff(0.9), Coeff(-1.5), Coeff(0.9), Coeff(-1.5), Coeff(0.8)};
+    std::array<Sample, 48> x;
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = Sample(i % 8 < 4 ? 3.0 : -3.0) + Sample(static_cast<double>(i % 5) / 8.0);
+    }
+
+    fp::Biquad<Sample, fp::BiquadForm::DirectI, Coeff> direct(lowpass);
+    fp::Biquad<Sample, fp::BiquadForm::TransposedII, Coeff> transposed(lowpass);
+    std::array<Sample, 48> y_direct;
+    std::array<Sample, 48> y_transposed;
+    direct.Process(x, y_direct);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        y_transposed[i] = transposed.Process(x[i]);
+    }
+
+    // two interleaved channels with their own coefficients
+    fp::Biquad<Sample, fp::BiquadForm::TransposedII, Coeff, 2> stereo(std::array{lowpass, notch});
+    fp::Biquad<Sample, fp::BiquadForm::TransposedII, Coeff> left(lowpass);
+    fp::Biquad<Sample, fp::BiquadForm::TransposedII, Coeff> right(notch);
+    std::array<Sample, 48> y_stereo;
+    stereo.Process(x, y_stereo);
+    bool channels_match {true};
+    for (std::size_t i = 0; i < x.size(); i += 2)
+    {
+        channels_match = channels_match && y_stereo[i] == left.Process(x[i]) && y_stereo[i + 1] == right.Process(x[i + 1]);
+    }
+
+    // a cascade is its sections in series
+    fp::BiquadCascade<Sample, 2, fp::BiquadForm::DirectI, Coeff> cascade(std::array{lowpass, notch});
+    fp::Biquad<Sample, fp::BiquadForm::DirectI, Coeff> second(notch);
+    auto y_cascade = x;
+    cascade.Process(y_cascade);
+    bool cascade_matches {true};
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        cascade_matches = cascade_matches && y_cascade[i] == second.Process(y_direct[i]);
+    }
+    return y_direct == y_transposed && channels_match && cascade_matches && y_direct[47] != Sample(0);
+}
+
+constexpr bool TestInterleave()
+{
+    using T = fp::Number<std::int16_t, std::int32_t, 8>;
+    // 11 frames of 3 channels, x = 10 * frame + channel
+    std::array<T, 33> frames;
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+        frames[i] = T(static_cast<int>(10 * (i / 3) + i % 3));
+    }
+    std::array<T, 33> planar;
+    fp::simd::Deinterleave<T>(frames, 3, planar);
+    std::array<T, 33> back;
+    fp::simd::Interleave<T>(planar, 3, back);
+    return planar[0] == T(0) && planar[1] == T(10) && planar[10] == T(100) && planar[11] == T(1) && planar[32] == T(102) && back == frames;
+}
+
+constexpr bool TestChannelOps()
+{
+    using T = fp::Number<std::int16_t, std::int32_t, 4, fp::Saturate, fp::RoundHalfEven>;
+    const std::array gains {T(0.5), T(-1.25), T(2.0)};
+    std::array<T, 30> x;
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = T(static_cast<double>(i) / 4.0 - 3.0);
+    }
+
+    std::array<T, 30> scaled;
+    fp::simd::MulChannels<T>(x, gains, scaled);
+    std::array<T, 10> mixed;
+    fp::simd::MixChannels<T>(x, gains, mixed);
+    std::array<T, 10> sums;
+    fp::simd::SumChannels<T>(x, 3, sums);
+
+    bool match {true};
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        match = match && scaled[i] == x[i] * gains[i % 3];
+    }
+    for (std::size_t f = 0; f < mixed.size(); ++f)
+    {
+        const std::span<const T> frame {std::span<const T>{x}.subspan(3 * f, 3)};
+        match = match && mixed[f] == fp::Dot<T>(frame, gains) && sums[f] == frame[0] + frame[1] + frame[2];
+    }
+    // the sum is narrowed once
+    const std::array<T, 3> large {T(7.0), T(7.0), T(-7.0)};
+    std::array<T, 1> sum;
+    fp::simd::SumChannels<T>(large, 3, sum);
+    return match && sum[0] == T(7.0);
+}
+
+constexpr bool TestInvSqrt()
+{
+    using T = fp::Number<std::int32_t, std::int64_t, 16>;
+    constexpr auto kOne = fp::uint128{1} << (3 * T::kNumFracBits);
+    bool exact {fp::InvSqrt(T(4.0)) == T(0.5) && fp::InvSqrt(T(0.25)) == T(2.0) && fp::InvSqrt(T(0.0)) == T(0.0) && fp::InvSqrt(T(-1.0)) == T(0.0)};
+    bool close {fp::FastInvSqrt(T(0.0)) == T(0.0) && fp::FastSqrt(T(-1.0)) == T(0.0)};
+    for (std::int32_t raw = 1; raw > 0 && raw < 0x7FFFFFFF - 0x01234567; raw += 0x01234567 / (raw < 4096 ? 65536 : 1))
+    {
+        // floor(2^(3 * F) / raw) lies between r^2 and (r + 1)^2
+        const auto x = T::FromBits(raw);
+        const auto r = static_cast<fp::uint128>(fp::InvSqrt(x).Bits());
+        exact = exact && r * r * static_cast<fp::uint128>(raw) <= kOne && (r + 1) * (r + 1) * static_cast<fp::uint128>(raw) > kOne;
+        const auto ulps = [](T a, T b) { return a.Bits() > b.Bits() ? a.Bits() - b.Bits() : b.Bits() - a.Bits(); };
+        close = close && ulps(fp::FastInvSqrt(x), fp::InvSqrt(x)) <= 1 && ulps(fp::FastSqrt(x), fp::Sqrt(x)) <= 1;
+    }
+    return exact && close;
+}
+
+constexpr bool TestSimdRoots()
+{
+    using T = fp::Number<std::int16_t, std::int32_t, 8>;
+    std::array<T, 19> x;
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = T(static_cast<double>(i) * 3.25 - 4.0);
+    }
+    std::array<T, 19> roots;
+    std::array<T, 19> fast_roots;
+    std::array<T, 19> inverse_roots;
+    fp::simd::Sqrt<T>(x, roots);
+    fp::simd::FastSqrt<T>(x, fast_roots);
+    fp::simd::FastInvSqrt<T>(x, inverse_roots);
+    bool match {true};
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        match = match && roots[i] == fp::Sqrt(x[i]) && fast_roots[i] == fp::FastSqrt(x[i]) && inverse_roots[i] == fp::FastInvSqrt(x[i]);
+    }
+    return match;
+}
+
+constexpr bool TestWideNumberMatchesNumber()
+{
+    // one limb with 32 fractional bits is the format of FP_S64_32, both wrap and truncate
+    using W = fp::WideNumber<1, 32>;
+    constexpr std::array<std::int64_t, 8> kRaw {0, 1, -1, 0x123456789ABLL, -0x7654321FEDCLL, 0x7FFFFFFFFFFFFFFFLL, -0x7FFFFFFFFFFFFFFFLL - 1, 3LL << 31};
+    bool match {true};
+    for (const auto a : kRaw)
+    {
+        for (const auto b : kRaw)
+        {
+            const auto x = FP_S64_32::FromBits(a);
+            const auto y = FP_S64_32::FromBits(b);
+            match = match && static_cast<FP_S64_32>(W(x) * W(y)) == x * y && static_cast<FP_S64_32>(W(x) + W(y)) == x + y &&
+                    static_cast<FP_S64_32>(W(x) - W(y)) == x - y && (W(x) <=> W(y)) == (x <=> y);
+            match = match && (b == 0 || static_cast<FP_S64_32>(W(x) / W(y)) == x / y);
+        }
+    }
+    return match;
+}
+
+constexpr bool TestWideNumberArithmetic()
+{
+    using Q64_64 = fp::WideNumber<2, 64>;
+    using Q96_160 = fp::WideNumber<4, 160>;
+    const bool q64 {Q64_64(1.5) * Q64_64(-2.25) == Q64_64(-3.375) && Q64_64(10) / Q64_64(4) == Q64_64(2.5) && Q64_64(-7) / Q64_64(2) == Q64_64(-3.5) &&
+                    Q64_64(1) / Q64_64(3) * Q64_64(3) < Q64_64(1) && Q64_64(-0.25) < Q64_64(0.25) && Q64_64(-1) < Q64_64(-0.5)};
+    // 2^-160 survives in the wide format and disappears in doubles
+    const auto tiny = Q96_160::FromBits({1, 0, 0, 0});
+    const bool q96 {(Q96_160(1) + tiny) * (Q96_160(1) - tiny) < Q96_160(1) && (Q96_160(1) + tiny) / (Q96_160(1) + tiny) == Q96_160(1) &&
+                    static_cast<double>(Q96_160(-12345.0625)) == -12345.0625 && static_cast<double>(tiny) == 0x1.0p-160 &&
+                    Q96_160(FP_S32_16(-2.5)) == Q96_160(-2.5) && static_cast<FP_S32_16>(Q96_160(-2.5)) == FP_S32_16(-2.5)};
+    const bool sign {Abs(Q64_64(-3)) == Q64_64(3) && Q64_64::Sign(Q64_64(-0.5)) == Q64_64::NegOne() && Q64_64::Sign(Q64_64(0)) == Q64_64::PosOne() &&
+                     Q64_64::SignBit(Q64_64(-1)) && -Q64_64::Half() == Q64_64(-0.5)};
+    return q64 && q96 && sign;
+}
+
+// pseudo-random limbs, SplitMix64
+template<std::size_t N>
+constexpr fp::detail::LimbArray<N> RandomLimbs(std::uint64_t seed)
+{
+    fp::detail::LimbArray<N> limbs {};
+    for (auto& limb : limbs)
+    {
+        std::uint64_t z {seed += 0x9E3779B97F4A7C15ULL};
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        limb = z ^ (z >> 31);
+    }
+    return limbs;
+}
+
+constexpr bool TestKaratsuba()
+{
+    constexpr std::size_t N {fp::detail::kKaratsubaLimbs};
+    bool match {true};
+    for (std::uint64_t seed = 1; seed <= 2; ++seed)
+    {
+        auto a = RandomLimbs<N>(seed);
+        const auto b = RandomLimbs<N>(seed + 100);
+        // equal halves and all ones exercise the zero and the largest differences
+        std::copy_n(a.begin(), N / 2, a.begin() + N / 2);
+        match = match && fp::detail::MultiplyLimbs(a, b) == fp::detail::MulSchoolbook(a, b);
+        a.fill(~std::uint64_t{0});
+        match = match && fp::detail::MultiplyLimbs(a, a) == fp::detail::MulSchoolbook(a, a);
+    }
+    return match;
+}
+
+constexpr bool TestLongDivision()
+{
+    // q = floor(u / v) when q v <= u < q v + v
+    const auto check = [](const auto& u, const auto& v) {
+        const auto q = fp::detail::DivideLimbs(u, v);
+        const auto product = fp::detail::MulSchoolbook(q, v);
+        auto remainder = u;
+        auto low = decltype(u){};
+        auto divisor = decltype(u){};
+        std::copy_n(product.begin(), u.size(), low.begin());
+        std::copy(v.begin(), v.end(), divisor.begin());
+        const bool fits {std::all_of(product.begin() + static_cast<std::ptrdiff_t>(u.size()), product.end(), [](std::uint64_t limb) { return limb == 0; })};
+        return fits && fp::detail::SubLimbs(remainder, low) == 0 && fp::detail::LessLimbs(remainder, divisor);
+    };
+    // the divisor needs the add back step of algorithm D
+    bool exact {check(fp::detail::LimbArray<3>{3, 0, 0x8000000000000000ULL}, fp::detail::LimbArray<3>{1, 0, 0x2000000000000000ULL})};
+    for (std::uint64_t seed = 1; seed <= 8; ++seed)
+    {
+        const auto u = RandomLimbs<6>(seed);
+        auto v = RandomLimbs<3>(seed * 7);
+        for (std::size_t i = seed % 3 + 1; i < v.size(); ++i)
+        {
+            v[i] = 0;
+        }
+        exact = exact && check(u, v);
+    }
+    return exact;
+}
+
+// x.Div<C>() and x.Mul<C>() against the operators with NumberT(C), over raw values spread across the range
+template<fp::FixedPoint NumberT, auto... Constants>
+constexpr bool TestConstantOps()
+{
+    using Raw = typename NumberT::ValueType;
+    using Unsigned = std::make_unsigned_t<Raw>;
+    bool match {true};
+    for (unsigned int i = 0; i <= 256; ++i)
+    {
+        const auto raw = static_cast<Raw>(static_cast<Unsigned>(i * (std::numeric_limits<Unsigned>::max() / 256U) + i * 7U));
+        const auto x = NumberT::FromBits(raw);
+        match = match && ((x.template Div<Constants>() == x / NumberT(Constants) && x.template Mul<Constants>() == x * NumberT(Constants)) && ...);
+    }
+    return match;
+}
+
+constexpr bool TestLiterals()
+{
+    using namespace fp::literals;
+    using Q15 = fp::Number<std::int16_t, std::int32_t, 1>;
+    // parsed exactly and truncated as the format rounds, not through a double
+    return 1.5_q16 == FP_S32_16(1.5) && 3_q16 == FP_S32_16(3) && -0.25_q15 == Q15::FromBits(-8192) && (0.1_q16).Bits() == 6553 &&
+           (0.99999999999999999999_q15).Bits() == 32767 && 2.5_q32 == FP_S64_32(2.5) && (127.99609375_q8).Bits() == 0x7FFF &&
+           (0.5_q31).Bits() == (1 << 30) && fp::Const<FP_S32_16, 0.125> == FP_S32_16::FromBits(8192);
+}
+
 // compile-time execution
 static_assert(TestConstructionSignedFromInt(), "Construction of signed FP number from int failed");
 static_assert(TestConstructionUnsignedFromInt(), "Construction of unsigned FP number from int failed");
@@ -141,6 +1236,95 @@ static_assert(TestSignUnsignedPositive(), "Sign() with a positive unsigned integ
 static_assert(TestSignUnsignedZero(), "Sign() with a zero unsigned integer failed");
 static_assert(TestSignSignedPositive(), "Sign() with a positive signed integer failed");
 static_assert(TestSignSignedNegative(), "Sign() with a negative signed integer failed");
+static_assert(TestSimdAddSub(), "fp::simd::Add() / Sub() failed");
+static_assert(TestSimdMulMatchesScalar(), "fp::simd::Mul() doesn't match the scalar operator");
+static_assert(TestSimdFmaUnsigned(), "fp::simd::Fma() with unsigned numbers failed");
+static_assert(TestVectorFusedExpression(), "fp::Vector expression evaluation failed");
+static_assert(TestVectorPaddingIsZero(), "fp::Vector padding is not zeroed");
+static_assert(TestVectorViewWritesThrough(), "fp::Vector::View() failed");
+static_assert(TestDividerMatchesDivision(), "fp::Divider doesn't match operator/");
+static_assert(TestDividerUnsigned(), "fp::Divider with unsigned numbers failed");
+static_assert(TestReciprocal(), "fp::Reciprocal() failed");
+static_assert(TestSinCos<fp::MathBackend::Table>(), "Table Sin() / Cos() failed");
+static_assert(TestSinCos<fp::MathBackend::Cordic>(), "CORDIC Sin() / Cos() failed");
+static_assert(TestAtan2<fp::MathBackend::Table>(), "Table Atan2() failed");
+static_assert(TestAtan2<fp::MathBackend::Cordic>(), "CORDIC Atan2() failed");
+static_assert(TestSqrt(), "Sqrt() failed");
+static_assert(TestExpLog<fp::MathBackend::Table>(), "Table Exp() / Log() failed");
+static_assert(TestExpLog<fp::MathBackend::Cordic>(), "CORDIC Exp() / Log() failed");
+static_assert(TestWideMultiplication(), "Multiplication with a 128-bit wide type failed");
+static_assert(TestWideDivision(), "Division with a 128-bit wide type failed");
+static_assert(TestSaturatingArithmetic(), "fp::Saturate arithmetic failed");
+static_assert(TestSaturatingConstruction(), "fp::Saturate construction failed");
+static_assert(TestTrapInRange(), "fp::Trap with in range values failed");
+static_assert(TestSimdSaturatingAdd(), "fp::simd::Add() / Sub() with saturating numbers failed");
+static_assert(TestRoundingMultiplication(), "Rounding of products failed");
+static_assert(TestRoundingDivision(), "Rounding of quotients failed");
+static_assert(TestRoundingConstruction(), "Rounding of floating point values failed");
+static_assert(TestRescale(), "fp::Rescale() failed");
+static_assert(TestAccumulatorKeepsFractionalBits(), "fp::Accumulator failed");
+static_assert(TestDot(), "fp::Dot() failed");
+static_assert(TestFmaSingleRounding(), "fp::Fma() failed");
+static_assert(TestMixedMultiplication(), "Mixed-format multiplication failed");
+static_assert(TestMixedAddition(), "Mixed-format addition failed");
+static_assert(TestConvert(), "fp::Convert() failed");
+static_assert(TestFromFloats(), "fp::FromFloats() failed");
+static_assert(TestToFloats(), "fp::ToFloats() failed");
+static_assert(TestReduceNarrowsOnce(), "fp::Reduce() failed");
+static_assert(TestTransformReduce(), "fp::TransformReduce() failed");
+static_assert(TestTransform(), "fp::Transform() failed");
+static_assert(TestArrayHeader(), "fp::MakeArrayHeader() / format check failed");
+static_assert(TestByteSwap(), "fp::detail::ByteSwap() failed");
+static_assert(TestToChars(), "fp::ToChars() failed");
+static_assert(TestToCharsPrecision(), "fp::ToChars() with a precision failed");
+static_assert(TestFromChars(), "fp::FromChars() failed");
+static_assert(TestFromCharsLongFraction(), "fp::FromChars() with more than 36 fractional digits failed");
+static_assert(TestVec(), "fp::Vec failed");
+static_assert(TestVecDotRoundsOnce(), "fp::Vec Dot() rounded more than once");
+static_assert(TestMat(), "fp::Mat failed");
+static_assert(TestGemm(), "fp::Gemm() failed");
+static_assert(TestComplex(), "fp::Complex failed");
+static_assert(TestFFTImpulse(), "fp::FFT of an impulse failed");
+static_assert(TestFFTConstant(), "fp::FFT of a constant failed");
+static_assert(TestFFTRoundTrip<64>(), "fp::FFT round trip failed (radix-4)");
+static_assert(TestFFTRoundTrip<128>(), "fp::FFT round trip failed (radix-4 and radix-2)");
+static_assert(TestMakeTable(), "fp::MakeTable() failed");
+static_assert(TestTableFuncLinear(), "fp::TableFunc linear interpolation failed");
+static_assert(TestTableFuncCubic(), "fp::TableFunc cubic interpolation failed");
+static_assert(TestComplexRoundsOnce(), "fp::Complex product doesn't round once");
+static_assert(TestComplexMul3<fp::Number<std::int16_t, std::int32_t, 8>>(), "fp::Mul3() doesn't match the complex product");
+static_assert(TestComplexMul3<fp::Number<std::int16_t, std::int32_t, 4, fp::Saturate, fp::RoundHalfEven>>(), "fp::Mul3() doesn't match the complex product");
+static_assert(TestAbsMinimum(), "Abs() of the minimum doesn't follow the overflow policy");
+static_assert(TestMinMaxClamp(), "Min(), Max() or Clamp() failed");
+static_assert(TestCopySign(), "CopySign() failed");
+static_assert(TestLerp(), "Lerp() failed");
+static_assert(TestSimdSelects(), "fp::simd selects don't match the scalar functions");
+static_assert(TestInstrumentedResults(), "fp::Instrumented changes the results");
+static_assert(TestBitsRoundTrip(), "Bits() doesn't invert FromBits()");
+static_assert(fp::detail::kHasBaseLayout<FP_S32_16> && fp::detail::kHasBaseLayout<FP_U32_16>, "fp::Number doesn't have the layout of its base type");
+static_assert(fp::detail::kHasBaseLayout<FP_S64_32> && fp::detail::kHasBaseLayout<const FP_U64_32>, "fp::Number doesn't have the layout of its base type");
+static_assert(std::is_same_v<decltype(fp::AsBits(std::declval<std::span<FP_S32_16, 4>>())), std::span<std::int32_t, 4>>, "AsBits() must keep the extent");
+static_assert(std::is_same_v<decltype(fp::AsBits(std::span<const FP_U32_16>{})), std::span<const std::uint32_t>>, "AsBits() must keep const");
+static_assert(std::is_same_v<decltype(fp::AsNumbers<FP_S64_32>(std::span<const std::int64_t>{})), std::span<const FP_S64_32>>, "AsNumbers() must keep const");
+static_assert(TestFIRImpulseResponse(), "fp::FIR impulse response isn't its coefficients");
+static_assert(TestFIRBlocksMatchSamples(), "fp::FIR blocks don't match sample by sample filtering");
+static_assert(TestBiquadForms(), "fp::Biquad forms, channels or cascades don't match");
+static_assert(TestInterleave(), "fp::simd::Interleave() or Deinterleave() failed");
+static_assert(TestChannelOps(), "fp::simd channel operations don't match the scalar ones");
+static_assert(TestInvSqrt(), "fp::InvSqrt() isn't exact or the fast roots are more than 1 ULP off");
+static_assert(TestSimdRoots(), "fp::simd roots don't match the scalar ones");
+static_assert(TestWideNumberMatchesNumber(), "fp::WideNumber with one limb doesn't match fp::Number");
+static_assert(TestWideNumberArithmetic(), "fp::WideNumber arithmetic failed");
+static_assert(TestKaratsuba(), "Karatsuba products don't match the schoolbook ones");
+static_assert(TestLongDivision(), "Multi-limb long division failed");
+static_assert(TestConstantOps<FP_S32_16, 4, 3, -7, 10, 1, -1, 1000, 0.5, 0.125, 0.3, 2.75, -0.375>(), "Div<>() or Mul<>() doesn't match the operators");
+static_assert(TestConstantOps<FP_U32_16, 4, 3, 10, 1, 0.5, 0.3, 2.75>(), "Div<>() or Mul<>() doesn't match the operators");
+static_assert(TestConstantOps<FP_S64_32, 4, 3, -7, 1, -1, 0.5, 0.3, -2.75>(), "Div<>() or Mul<>() doesn't match the operators");
+static_assert(TestConstantOps<fp::Number<std::int16_t, std::int32_t, 8, fp::Saturate, fp::RoundHalfEven>, 3, -7, 4, 100, 0.3, 0.5, -1.25>(),
+              "Div<>() or Mul<>() doesn't match the operators with saturation and rounding");
+static_assert(TestConstantOps<fp::Number<std::int16_t, std::int32_t, 1, fp::Wrap, fp::RoundHalfUp>, 0.5, 0.3, -0.75, -1>(),
+              "Div<>() or Mul<>() doesn't match the operators in Q15");
+static_assert(TestLiterals(), "Fixed-point literals or fp::Const failed");
 
 int main()
 {